@@ -0,0 +1,90 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <vector>
+#include <algorithm>
+#include "BitMatrix.h"
+
+using namespace std;
+
+BitMatrix::BitMatrix() {
+	numRow = numCol = wordsPerRow = 0;
+}
+
+void BitMatrix::Resize(int _numRow, int _numCol) {
+	numRow = _numRow;
+	numCol = _numCol;
+	wordsPerRow = (numCol+63)/64;
+	words.assign((size_t)numRow*wordsPerRow, 0);
+}
+
+void BitMatrix::Swap(BitMatrix &other) {
+	swap(numRow, other.numRow);
+	swap(numCol, other.numCol);
+	swap(wordsPerRow, other.wordsPerRow);
+	words.swap(other.words);
+}
+
+int BitMatrix::Count(int row) const {
+	const uint64_t *bits = Row(row);
+	int count = 0;
+	for (int w=0; w<wordsPerRow; w++) {
+		count += __builtin_popcountll(bits[w]);		// padding bits are never set
+	}
+	return count;
+}
+
+void BitMatrix::CopyBits(const uint64_t *src, int srcBit, uint64_t *dst, int dstBit, int numBit) {
+	// at most two word-sized pieces per 64 bits, whatever the alignment of src and dst
+	while (numBit > 0) {
+		int s = srcBit & 63, d = dstBit & 63;
+		int len = min(numBit, 64 - max(s, d));
+		uint64_t bits = src[srcBit >> 6] >> s;
+		if (len < 64) {
+			bits &= ((uint64_t)1 << len) - 1;
+		}
+		dst[dstBit >> 6] |= bits << d;
+		srcBit += len;
+		dstBit += len;
+		numBit -= len;
+	}
+}
+
+double BitMatrix::Size() const {
+	return words.capacity()*sizeof(uint64_t);
+}
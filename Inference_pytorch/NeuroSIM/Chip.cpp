@@ -43,6 +43,9 @@
 #include <stdlib.h>
 #include <vector>
 #include <sstream>
+#include <map>
+#include <functional>
+#include <omp.h>
 #include "MaxPooling.h"
 #include "Sigmoid.h"
 #include "BitShifter.h"
@@ -55,32 +58,74 @@
 #include "formula.h"
 #include "Param.h"
 #include "Chip.h"
+#include "TraceFile.h"
+#include "CsvFile.h"
+#include "InputStream.h"
+#include "SimContext.h"
 
 using namespace std;
 
 extern Param *param;
-double globalBusWidth = 0;
-int numBufferCore = 0;				  
 
-/*** Circuit Modules ***/
-Buffer *globalBuffer;
-HTree *GhTree;
-AdderTree *Gaccumulation;
-Sigmoid *Gsigmoid;
-BitShifter *GreLu;
-MaxPooling *maxPool;
+// a binary trace carries its layer and shape in the header, so a mismatch is rejected before any payload is read
+static void CheckTraceHeader(const string &filename, int layerNumber, int numRow, int numCol, int minNumCol) {
+	TraceHeader header;
+	if (!TraceFile::ReadHeader(filename, &header)) {
+		return;		// CSV, checked once parsed
+	}
+	if (header.layer != TRACE_LAYER_ANY && (int)header.layer != layerNumber) {
+		cerr << "Error: " << filename << " is the trace of layer " << header.layer+1 << " but is given for layer " << layerNumber+1 << "!" << endl;
+		exit(1);
+	}
+	if (header.kind == TRACE_KIND_IFM) {
+		return;		// checked against the feature map size by InputStream::Open
+	}
+	if ((int)header.rows != numRow || (numCol >= 0 && (int)header.cols != numCol) || (int)header.cols < minNumCol) {
+		cerr << "Error: " << filename << " is " << header.rows << "x" << header.cols << " but layer " << layerNumber+1 << " expects "
+				<< numRow << "x" << (numCol >= 0? numCol : minNumCol) << "!" << endl;
+		exit(1);
+	}
+}
+
+/*** Parsed traces of one layer, held while the layer is simulated ***/
+struct LayerTrace {
+	WeightMatrix newMemory;
+	InputStream inputVector;
+};
+
+static void LoadLayerTrace(int layerNumber, const string &weightfile, const string &inputfile, const vector<double> &layerStructure, int numRowPerSynapse, int numColPerSynapse, LayerTrace &trace) {
+	// netStructure: H, W, C, kernel H, kernel W, Cout, followedByMaxPool, stride
+	int numRow = layerStructure[2]*layerStructure[3]*layerStructure[4];
+	int numCol = layerStructure[5];
+	int numInVector = (layerStructure[0]-layerStructure[3]+1)/layerStructure[7]*(layerStructure[1]-layerStructure[4]+1)/layerStructure[7];
+	CheckTraceHeader(weightfile, layerNumber, numRow, numCol, 0);
+	CheckTraceHeader(inputfile, layerNumber, numRow, -1, numInVector*param->numBitInput);
+	
+	// a raw feature map is always expanded on the fly, never into the full input matrix
+	if (param->inputWindowSize > 0 || TraceFile::TraceKind(inputfile) == TRACE_KIND_IFM) {
+		trace.inputVector.Open(inputfile, layerStructure);
+	} else {
+		BitMatrix inputVector;
+		inputVector = LoadInInputData(inputfile);
+		trace.inputVector.Assign(inputVector);
+	}
+	trace.newMemory = LoadInWeightData(weightfile, numRowPerSynapse, numColPerSynapse);
+	if (trace.newMemory.numRow != numRow*numRowPerSynapse || trace.newMemory.numCol != numCol*numColPerSynapse) {
+		cerr << "Error: weight file " << weightfile << " is " << trace.newMemory.numRow/numRowPerSynapse << "x" << trace.newMemory.numCol/numColPerSynapse
+				<< " but layer " << layerNumber+1 << " expects " << numRow << "x" << numCol << "!" << endl;
+		exit(1);
+	}
+	if (trace.inputVector.numRow != numRow*numRowPerSynapse || trace.inputVector.numCol < numInVector*param->numBitInput) {
+		cerr << "Error: input file " << inputfile << " is " << trace.inputVector.numRow/numRowPerSynapse << "x" << trace.inputVector.numCol
+				<< " but layer " << layerNumber+1 << " expects " << numRow << "x" << numInVector*param->numBitInput << "!" << endl;
+		exit(1);
+	}
+}
  
 
-vector<int> ChipDesignInitialize(InputParameter& inputParameter, Technology& tech, MemCell& cell, bool pip, const vector<vector<double> > &netStructure,
+vector<int> ChipDesignInitialize(bool pip, const vector<vector<double> > &netStructure,
 					double *maxPESizeNM, double *maxTileSizeCM, double *numPENM){
 
-	globalBuffer = new Buffer(inputParameter, tech, cell);
-	GhTree = new HTree(inputParameter, tech, cell);
-	Gaccumulation = new AdderTree(inputParameter, tech, cell);
-	Gsigmoid = new Sigmoid(inputParameter, tech, cell);
-	GreLu = new BitShifter(inputParameter, tech, cell);
-	maxPool = new MaxPooling(inputParameter, tech, cell);
-
 	int numRowPerSynapse, numColPerSynapse;
 	numRowPerSynapse = param->numRowPerSynapse;
 	numColPerSynapse = param->numColPerSynapse;
@@ -354,11 +399,11 @@ vector<vector<double> > ChipFloorPlan(bool findNumTile, bool findUtilization, bo
 }
 
 
-void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& cell, const vector<vector<double> > &netStructure, const vector<int > &markNM, const vector<vector<double> > &numTileEachLayer,
+void ChipInitialize(SimContext &ctx, const vector<vector<double> > &netStructure, const vector<int > &markNM, const vector<vector<double> > &numTileEachLayer,
 					double numPENM, double desiredNumTileNM, double desiredPESizeNM, double desiredNumTileCM, double desiredTileSizeCM, double desiredPESizeCM, int numTileRow, int numTileCol) { 
 
 	/*** Initialize Tile ***/
-	TileInitialize(inputParameter, tech, cell, numPENM, desiredPESizeNM, ceil((double)(desiredTileSizeCM)/(double)(desiredPESizeCM)), desiredPESizeCM);
+	TileInitialize(ctx, numPENM, desiredPESizeNM, ceil((double)(desiredTileSizeCM)/(double)(desiredPESizeCM)), desiredPESizeCM);
 
 	// find max layer and define the global buffer: enough to hold the max layer inputs
 	double maxLayerInput = 0;
@@ -371,16 +416,16 @@ void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 				maxLayerInput = input;
 			}
 			if (markNM[i] == 0) {
-				globalBusWidth += (desiredTileSizeCM)+(desiredTileSizeCM)/param->numColMuxed;
+				ctx.globalBusWidth += (desiredTileSizeCM)+(desiredTileSizeCM)/param->numColMuxed;
 			} else {
-				globalBusWidth += (desiredPESizeNM)*ceil((double)sqrt(numPENM))+(desiredPESizeNM)*ceil((double)sqrt(numPENM))/param->numColMuxed;
+				ctx.globalBusWidth += (desiredPESizeNM)*ceil((double)sqrt(numPENM))+(desiredPESizeNM)*ceil((double)sqrt(numPENM))/param->numColMuxed;
 			}
 		} else {
 			maxLayerInput += netStructure[i][0]*netStructure[i][1]*netStructure[i][2]/2;
 			if (markNM[i] == 0) {
-				globalBusWidth += ((desiredTileSizeCM)+(desiredTileSizeCM)/param->numColMuxed)*numTileEachLayer[0][i]*numTileEachLayer[1][i];
+				ctx.globalBusWidth += ((desiredTileSizeCM)+(desiredTileSizeCM)/param->numColMuxed)*numTileEachLayer[0][i]*numTileEachLayer[1][i];
 			} else {
-				globalBusWidth += ((desiredPESizeNM)*ceil((double)sqrt(numPENM))+(desiredPESizeNM)*ceil((double)sqrt(numPENM))/param->numColMuxed)*numTileEachLayer[0][i]*numTileEachLayer[1][i];
+				ctx.globalBusWidth += ((desiredPESizeNM)*ceil((double)sqrt(numPENM))+(desiredPESizeNM)*ceil((double)sqrt(numPENM))/param->numColMuxed)*numTileEachLayer[0][i]*numTileEachLayer[1][i];
 			}
 		}
 		
@@ -390,20 +435,20 @@ void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 		}
 	}
 	// have to limit the global bus width --> cannot grow dramatically with num of tile
-	while (globalBusWidth > param->maxGlobalBusWidth) {
-		globalBusWidth /= 2;
+	while (ctx.globalBusWidth > param->maxGlobalBusWidth) {
+		ctx.globalBusWidth /= 2;
 	}
 	
 	// define bufferSize for inference operation
 	int bufferSize = param->numBitInput*maxLayerInput;										 
 	
-	//globalBuffer->Initialize(param->numBitInput*maxLayerInput, globalBusWidth, 1, param->unitLengthWireResistance, param->clkFreq, param->globalBufferType);
-	numBufferCore = ceil(bufferSize/(param->globalBufferCoreSizeRow*param->globalBufferCoreSizeCol));
-	//numBufferCore = ceil(1.5*numBufferCore);
-	globalBuffer->Initialize((param->globalBufferCoreSizeRow*param->globalBufferCoreSizeCol), param->globalBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->globalBufferType);
+	//ctx.globalBuffer->Initialize(param->numBitInput*maxLayerInput, ctx.globalBusWidth, 1, param->unitLengthWireResistance, param->clkFreq, param->globalBufferType);
+	ctx.numBufferCore = ceil(bufferSize/(param->globalBufferCoreSizeRow*param->globalBufferCoreSizeCol));
+	//ctx.numBufferCore = ceil(1.5*ctx.numBufferCore);
+	ctx.globalBuffer->Initialize((param->globalBufferCoreSizeRow*param->globalBufferCoreSizeCol), param->globalBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->globalBufferType);
 	
-	maxPool->Initialize(param->numBitInput, 2*2, (desiredTileSizeCM), param->clkFreq);
-	GhTree->Initialize((numTileRow), (numTileCol), param->globalBusDelayTolerance, globalBusWidth, param->clkFreq);
+	ctx.maxPool->Initialize(param->numBitInput, 2*2, (desiredTileSizeCM), param->clkFreq);
+	ctx.GhTree->Initialize((numTileRow), (numTileCol), param->globalBusDelayTolerance, ctx.globalBusWidth, param->clkFreq);
 	
 	//activation inside Tile or outside?
 	if (param->chipActivation) {
@@ -417,16 +462,16 @@ void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 				maxAddFromSubArray *= (netStructure.size()+1);
 			}
 			if (param->parallelRead) {
-				Gaccumulation->Initialize((int) maxTileAdded, ceil((double) log2((double) param->levelOutput))+param->numBitInput+1+ceil((double) log2((double) maxAddFromSubArray)), 
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, ceil((double) log2((double) param->levelOutput))+param->numBitInput+1+ceil((double) log2((double) maxAddFromSubArray)), 
 										ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
 			} else {
-				Gaccumulation->Initialize((int) maxTileAdded, ceil((double) log2((double) param->numRowSubArray)+(double) param->cellBit-1)+param->numBitInput+1+ceil((double) log2((double) maxAddFromSubArray)), 
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, ceil((double) log2((double) param->numRowSubArray)+(double) param->cellBit-1)+param->numBitInput+1+ceil((double) log2((double) maxAddFromSubArray)), 
 										ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
 			}
 			if (param->reLu) {
-				GreLu->Initialize(ceil((double) maxThroughputTile/(double) param->numColMuxed), param->numBitInput, param->clkFreq);
+				ctx.GreLu->Initialize(ceil((double) maxThroughputTile/(double) param->numColMuxed), param->numBitInput, param->clkFreq);
 			} else {
-				Gsigmoid->Initialize(false, param->numBitInput, ceil((double) log2((double) param->numRowSubArray)+(double) param->cellBit-1)+param->numBitInput+1+log2((double) maxAddFromSubArray)+ceil((double) log2((double) maxTileAdded)), 
+				ctx.Gsigmoid->Initialize(false, param->numBitInput, ceil((double) log2((double) param->numRowSubArray)+(double) param->cellBit-1)+param->numBitInput+1+log2((double) maxAddFromSubArray)+ceil((double) log2((double) maxTileAdded)), 
 										ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
 			}
 		} else {
@@ -436,16 +481,16 @@ void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 				maxAddFromSubArray *= (netStructure.size()+1);
 			}
 			if (param->parallelRead) {
-				Gaccumulation->Initialize((int) maxTileAdded, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)maxAddFromSubArray)), 
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)maxAddFromSubArray)), 
 										ceil((double)(desiredTileSizeCM)/(double)param->numColMuxed), param->clkFreq);
 			} else {
-				Gaccumulation->Initialize((int) maxTileAdded, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)maxAddFromSubArray)), 
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)maxAddFromSubArray)), 
 										ceil((double)(desiredTileSizeCM)/(double)param->numColMuxed), param->clkFreq);
 			}
 			if (param->reLu) {
-				GreLu->Initialize(ceil((double)(desiredTileSizeCM)/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
+				ctx.GreLu->Initialize(ceil((double)(desiredTileSizeCM)/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
 			} else {
-				Gsigmoid->Initialize(false, param->numBitInput, ceil((double) log2((double) param->numRowSubArray)+(double) param->cellBit-1)+param->numBitInput+1+log2((double) maxAddFromSubArray)+ceil((double) log2((double) maxTileAdded)), 
+				ctx.Gsigmoid->Initialize(false, param->numBitInput, ceil((double) log2((double) param->numRowSubArray)+(double) param->cellBit-1)+param->numBitInput+1+log2((double) maxAddFromSubArray)+ceil((double) log2((double) maxTileAdded)), 
 										ceil((double) (desiredTileSizeCM)/(double) param->numColMuxed), param->clkFreq);
 			}
 		}
@@ -457,15 +502,15 @@ void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 				maxThroughputTile *= (netStructure.size()+1);
 			}
 			if (param->parallelRead) {
-				Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
 			} else {
-				Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) maxThroughputTile/(double) param->numColMuxed), param->clkFreq);
 			}
 		} else {
 			if (param->parallelRead) {
-				Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) (desiredTileSizeCM)/(double) param->numColMuxed), param->clkFreq);
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) (desiredTileSizeCM)/(double) param->numColMuxed), param->clkFreq);
 			} else {
-				Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) (desiredTileSizeCM)/(double) param->numColMuxed), param->clkFreq);
+				ctx.Gaccumulation->Initialize((int) maxTileAdded, param->numBitInput, ceil((double) (desiredTileSizeCM)/(double) param->numColMuxed), param->clkFreq);
 			}
 		}
 	}
@@ -473,7 +518,7 @@ void ChipInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 
 
 
-vector<double> ChipCalculateArea(InputParameter& inputParameter, Technology& tech, MemCell& cell, double desiredNumTileNM, double numPENM, double desiredPESizeNM, double desiredNumTileCM, double desiredTileSizeCM, 
+vector<double> ChipCalculateArea(SimContext &ctx, double desiredNumTileNM, double numPENM, double desiredPESizeNM, double desiredNumTileCM, double desiredTileSizeCM, 
 						double desiredPESizeCM, int numTileRow, double *height, double *width, double *CMTileheight, double *CMTilewidth, double *NMTileheight, double *NMTilewidth) {
 	
 	vector<double> areaResults;
@@ -501,7 +546,7 @@ vector<double> ChipCalculateArea(InputParameter& inputParameter, Technology& tec
 	vector<double> areaNMTile;
 	
 	if (param->novelMapping) {
-		areaNMTile = TileCalculateArea(numPENM, desiredPESizeNM, true, &NMheight, &NMwidth);
+		areaNMTile = TileCalculateArea(ctx, numPENM, desiredPESizeNM, true, &NMheight, &NMwidth);
 		double NMTileArea = areaNMTile[0];
 		double NMTileAreaIC = areaNMTile[1];
 		double NMTileAreaADC = areaNMTile[2];
@@ -517,7 +562,7 @@ vector<double> ChipCalculateArea(InputParameter& inputParameter, Technology& tec
 		*NMTileheight = NMheight;
 		*NMTilewidth = NMwidth;
 	}
-	areaCMTile = TileCalculateArea(pow(ceil((double) desiredTileSizeCM/(double) desiredPESizeCM), 2), desiredPESizeCM, false, &CMheight, &CMwidth);
+	areaCMTile = TileCalculateArea(ctx, pow(ceil((double) desiredTileSizeCM/(double) desiredPESizeCM), 2), desiredPESizeCM, false, &CMheight, &CMwidth);
 	
 	double CMTileArea = areaCMTile[0];
 	double CMTileAreaIC = areaCMTile[1];
@@ -535,38 +580,38 @@ vector<double> ChipCalculateArea(InputParameter& inputParameter, Technology& tec
 	*CMTilewidth = CMwidth;
 	
 	// global buffer is made up by multiple cores
-	globalBuffer->CalculateArea(numTileRow*max(NMheight, CMheight), NULL, NONE);
-	double globalBufferArea = globalBuffer->area*numBufferCore;
+	ctx.globalBuffer->CalculateArea(numTileRow*max(NMheight, CMheight), NULL, NONE);
+	double globalBufferArea = ctx.globalBuffer->area*ctx.numBufferCore;
 	double globalBufferHeight = numTileRow*max(NMheight, CMheight);
 	double globalBufferWidth = globalBufferArea/globalBufferHeight;														
-	GhTree->CalculateArea(max(NMheight, CMheight), max(NMwidth, CMwidth), param->treeFoldedRatio);
-	maxPool->CalculateUnitArea(NONE);
-	maxPool->CalculateArea(globalBufferWidth);
-	Gaccumulation->CalculateArea(NULL, globalBufferHeight/3, NONE);
+	ctx.GhTree->CalculateArea(max(NMheight, CMheight), max(NMwidth, CMwidth), param->treeFoldedRatio);
+	ctx.maxPool->CalculateUnitArea(NONE);
+	ctx.maxPool->CalculateArea(globalBufferWidth);
+	ctx.Gaccumulation->CalculateArea(NULL, globalBufferHeight/3, NONE);
 	
 	double areaGreLu = 0;
 	double areaGsigmoid = 0;
 	
 	if (param->chipActivation) {
 		if (param->reLu) {
-			GreLu->CalculateArea(NULL, globalBufferWidth/3, NONE);
-			area += GreLu->area;
-			areaGreLu += GreLu->area;
+			ctx.GreLu->CalculateArea(NULL, globalBufferWidth/3, NONE);
+			area += ctx.GreLu->area;
+			areaGreLu += ctx.GreLu->area;
 		} else {
-			Gsigmoid->CalculateUnitArea(NONE);
-			Gsigmoid->CalculateArea(NULL, globalBufferWidth/3, NONE);
-			area += Gsigmoid->area;
-			areaGsigmoid += Gsigmoid->area;
+			ctx.Gsigmoid->CalculateUnitArea(NONE);
+			ctx.Gsigmoid->CalculateArea(NULL, globalBufferWidth/3, NONE);
+			area += ctx.Gsigmoid->area;
+			areaGsigmoid += ctx.Gsigmoid->area;
 		}
 	}
 	
-	area += globalBufferArea + GhTree->area + maxPool->area + Gaccumulation->area;
-	areaIC += GhTree->area;
+	area += globalBufferArea + ctx.GhTree->area + ctx.maxPool->area + ctx.Gaccumulation->area;
+	areaIC += ctx.GhTree->area;
 	areaResults.push_back(area);
 	areaResults.push_back(areaIC);
 	areaResults.push_back(areaADC);
-	areaResults.push_back(areaAccum + Gaccumulation->area);
-	areaResults.push_back(areaOther + globalBufferArea + maxPool->area + areaGreLu + areaGsigmoid);
+	areaResults.push_back(areaAccum + ctx.Gaccumulation->area);
+	areaResults.push_back(areaOther + globalBufferArea + ctx.maxPool->area + areaGreLu + areaGsigmoid);
 	areaResults.push_back(areaArray);
 	
 	*height = sqrt(area);
@@ -576,12 +621,41 @@ vector<double> ChipCalculateArea(InputParameter& inputParameter, Technology& tec
 }
 
 
-double ChipCalculatePerformance(InputParameter& inputParameter, Technology& tech, MemCell& cell, int layerNumber, const string &newweightfile, const string &oldweightfile, const string &inputfile, bool followedByMaxPool, 
+/*** Results of one tile, merged in tile order once every tile is evaluated ***/
+struct TileResult {
+	double readLatency, readDynamicEnergy, leakage;
+	double bufferLatency, bufferDynamicEnergy, icLatency, icDynamicEnergy;
+	double latencyADC, latencyAccum, latencyOther, energyADC, energyAccum, energyOther;
+	double clkPeriod;		// longest sensing latency of the tile
+};
+
+// The tiles of a layer are independent, so the workers take them one at a time from a shared counter (dynamic schedule).
+// A worker copies ctx when it takes its first tile and resets the tile/PE modules from ctx before each later one, so every
+// tile starts from the same state whatever the schedule; ctx itself is left untouched for the chip-level modules.
+static void EvaluateTiles(SimContext &ctx, int numTile, const function<void(SimContext &, int)> &evaluate) {
+	#pragma omp parallel num_threads(max(1, min(numTile, omp_get_max_threads())))
+	{
+		SimContext *worker = NULL;
+		#pragma omp for schedule(dynamic, 1)
+		for (int t=0; t<numTile; t++) {
+			if (worker) {
+				worker->ResetTileModules(ctx);
+			} else {
+				worker = new SimContext(ctx);
+			}
+			evaluate(*worker, t);
+		}
+		delete worker;
+	}
+}
+
+
+void ChipCalculatePerformance(SimContext &ctx, int layerNumber, const string &newweightfile, const string &oldweightfile, const string &inputfile, bool followedByMaxPool, 
 							const vector<vector<double> > &netStructure, const vector<int> &markNM, const vector<vector<double> > &numTileEachLayer, const vector<vector<double> > &utilizationEachLayer, 
 							const vector<vector<double> > &speedUpEachLayer, const vector<vector<double> > &tileLocaEachLayer, double numPENM, double desiredPESizeNM, double desiredTileSizeCM, 
 							double desiredPESizeCM, double CMTileheight, double CMTilewidth, double NMTileheight, double NMTilewidth,
 							double *readLatency, double *readDynamicEnergy, double *leakage, double *bufferLatency, double *bufferDynamicEnergy, double *icLatency, double *icDynamicEnergy, 
-							double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, bool CalculateclkFreq, double *clkPeriod) {
+							double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, double *clkPeriod) {
 	
 	
 	int numRowPerSynapse, numColPerSynapse;
@@ -594,11 +668,12 @@ double ChipCalculatePerformance(InputParameter& inputParameter, Technology& tech
 	int weightMatrixRow = netStructure[l][2]*netStructure[l][3]*netStructure[l][4]*numRowPerSynapse;
 	int weightMatrixCol = netStructure[l][5]*numColPerSynapse;
 	
-	// load in whole file 
-	vector<vector<double> > inputVector;
-	inputVector = LoadInInputData(inputfile); 
-	vector<vector<double> > newMemory;
-	newMemory = LoadInWeightData(newweightfile, numRowPerSynapse, numColPerSynapse, param->maxConductance, param->minConductance);
+	// load in whole file
+	LayerTrace trace;
+	LoadLayerTrace(l, newweightfile, inputfile, netStructure[l], numRowPerSynapse, numColPerSynapse, trace);
+	const InputStream &inputVector = trace.inputVector;
+	MatrixView newMemory = trace.newMemory.View();
+	MatrixView layerInput(inputVector.numRow);
 	
 	*readLatency = 0;
 	*readDynamicEnergy = 0;
@@ -624,238 +699,223 @@ double ChipCalculatePerformance(InputParameter& inputParameter, Technology& tech
 	}
 	
 	if (markNM[l] == 0) {   // conventional mapping
-		for (int i=0; i<ceil((double) netStructure[l][2]*(double) netStructure[l][3]*(double) netStructure[l][4]*(double) numRowPerSynapse/desiredTileSizeCM); i++) {       // # of tiles in row
-			for (int j=0; j<ceil((double) netStructure[l][5]*(double) numColPerSynapse/(double) desiredTileSizeCM); j++) {   // # of tiles in Column
-				
-				double tileReadLatency = 0;
-				double tileReadDynamicEnergy = 0;
-				double tilebufferLatency = 0;
-				double tilebufferDynamicEnergy = 0;
-				double tileicLatency = 0;
-				double tileicDynamicEnergy = 0;
-				double tileLatencyADC = 0;
-				double tileLatencyAccum = 0;
-				double tileLatencyOther = 0;
-				double tileEnergyADC = 0;
-				double tileEnergyAccum = 0;
-				double tileEnergyOther = 0;
-
-				int numRowMatrix = min(desiredTileSizeCM, weightMatrixRow-i*desiredTileSizeCM);
-				int numColMatrix = min(desiredTileSizeCM, weightMatrixCol-j*desiredTileSizeCM);
-				
-				// assign weight and input to specific tile
-				vector<vector<double> > tileMemory;
-				tileMemory = CopyArray(newMemory, i*desiredTileSizeCM, j*desiredTileSizeCM, numRowMatrix, numColMatrix);
-				
-				vector<vector<double> > tileInput;
-				tileInput = CopyInput(inputVector, i*desiredTileSizeCM, numInVector*param->numBitInput, numRowMatrix);
-				
-				TileCalculatePerformance(tileMemory, tileMemory, tileInput, markNM[l], ceil((double)desiredTileSizeCM/(double)desiredPESizeCM), desiredPESizeCM, speedUpEachLayer[0][l], speedUpEachLayer[1][l],
-									numRowMatrix, numColMatrix, numInVector*param->numBitInput, cell, &tileReadLatency, &tileReadDynamicEnergy, &tileLeakage,
-									&tilebufferLatency, &tilebufferDynamicEnergy, &tileicLatency, &tileicDynamicEnergy, 
-									&tileLatencyADC, &tileLatencyAccum, &tileLatencyOther, &tileEnergyADC, &tileEnergyAccum, &tileEnergyOther, CalculateclkFreq, clkPeriod);
-
-				*readLatency = MAX(tileReadLatency, (*readLatency));
-				*readDynamicEnergy += tileReadDynamicEnergy;
-				*bufferLatency = MAX(tilebufferLatency, (*bufferLatency));
-				*bufferDynamicEnergy += tilebufferDynamicEnergy;
-				*icLatency = MAX(tileicLatency, (*icLatency));
-				*icDynamicEnergy += tileicDynamicEnergy;
-				
-				*coreLatencyADC = MAX(tileLatencyADC, (*coreLatencyADC));
-				*coreLatencyAccum = MAX(tileLatencyAccum, (*coreLatencyAccum));
-				*coreLatencyOther = MAX(tileLatencyOther, (*coreLatencyOther));
-				
-				*coreEnergyADC += tileEnergyADC;
-				*coreEnergyAccum += tileEnergyAccum;
-				*coreEnergyOther += tileEnergyOther;
-			}
-		}
-		if(!CalculateclkFreq){
-			if (param->chipActivation) {
-				if (param->reLu) {
-					GreLu->CalculateLatency(ceil(numInVector*netStructure[l][5]/(double) GreLu->numUnit));
-					GreLu->CalculatePower(ceil(numInVector*netStructure[l][5]/(double) GreLu->numUnit));
-					*readLatency += GreLu->readLatency;
-					*readDynamicEnergy += GreLu->readDynamicEnergy;
-					*coreLatencyOther += GreLu->readLatency;
-					*coreEnergyOther += GreLu->readDynamicEnergy;
-				} else {
-					Gsigmoid->CalculateLatency(ceil(numInVector*netStructure[l][5]/Gsigmoid->numEntry));
-					Gsigmoid->CalculatePower(ceil(numInVector*netStructure[l][5]/Gsigmoid->numEntry));
-					*readLatency += Gsigmoid->readLatency;
-					*readDynamicEnergy += Gsigmoid->readDynamicEnergy;
-					*coreLatencyOther += Gsigmoid->readLatency;
-					*coreEnergyOther += Gsigmoid->readDynamicEnergy;
-				}
-			}
+		int numTileRowLayer = ceil((double) netStructure[l][2]*(double) netStructure[l][3]*(double) netStructure[l][4]*(double) numRowPerSynapse/desiredTileSizeCM);       // # of tiles in row
+		int numTileColLayer = ceil((double) netStructure[l][5]*(double) numColPerSynapse/(double) desiredTileSizeCM);   // # of tiles in Column
+		vector<TileResult> tileResult(numTileRowLayer*numTileColLayer);
+		EvaluateTiles(ctx, tileResult.size(), [&](SimContext &tileCtx, int t) {
+			int i = t/numTileColLayer;
+			int j = t%numTileColLayer;
+			TileResult &tile = tileResult[t];
 			
-			if (numTileEachLayer[0][l] > 1) {   
-				Gaccumulation->CalculateLatency(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) Gaccumulation->numAdderTree)), numTileEachLayer[0][l], 0);
-				Gaccumulation->CalculatePower(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) Gaccumulation->numAdderTree)), numTileEachLayer[0][l]);
-				*readLatency += Gaccumulation->readLatency;
-				*readDynamicEnergy += Gaccumulation->readDynamicEnergy;
-				*coreLatencyAccum += Gaccumulation->readLatency;
-				*coreEnergyAccum += Gaccumulation->readDynamicEnergy;
-			}
+			int numRowMatrix = min(desiredTileSizeCM, weightMatrixRow-i*desiredTileSizeCM);
+			int numColMatrix = min(desiredTileSizeCM, weightMatrixCol-j*desiredTileSizeCM);
+			
+			// assign weight and input to specific tile
+			MatrixView tileMemory = newMemory.Sub(i*desiredTileSizeCM, j*desiredTileSizeCM, numRowMatrix, numColMatrix);
 			
-			// if this layer is followed by Max Pool
-			if (followedByMaxPool) {
-				maxPool->CalculateLatency(1e20, 0, ceil((double) (numInVector/(double) maxPool->window)/(double) desiredTileSizeCM));
-				maxPool->CalculatePower(ceil((double) (numInVector/maxPool->window)/(double) desiredTileSizeCM));
-				*readLatency += maxPool->readLatency;
-				*readDynamicEnergy += maxPool->readDynamicEnergy;
-				*coreLatencyOther += maxPool->readLatency;
-				*coreEnergyOther += maxPool->readDynamicEnergy;
-			}							  
+			MatrixView tileInput = layerInput.Sub(i*desiredTileSizeCM, 0, numRowMatrix, 0);
 			
-			double numBitToLoadOut = weightMatrixRow*param->numBitInput*numInVector;
-			double numBitToLoadIn = ceil(weightMatrixCol/param->numColPerSynapse)*param->numBitInput*numInVector/(netStructure[l][6]? 4:1);
+			TileCalculatePerformance(tileCtx, tileMemory, tileMemory, inputVector, tileInput, markNM[l], ceil((double)desiredTileSizeCM/(double)desiredPESizeCM), desiredPESizeCM, speedUpEachLayer[0][l], speedUpEachLayer[1][l],
+								numRowMatrix, numColMatrix, numInVector*param->numBitInput, &tile.readLatency, &tile.readDynamicEnergy, &tile.leakage,
+								&tile.bufferLatency, &tile.bufferDynamicEnergy, &tile.icLatency, &tile.icDynamicEnergy, 
+								&tile.latencyADC, &tile.latencyAccum, &tile.latencyOther, &tile.energyADC, &tile.energyAccum, &tile.energyOther, &tile.clkPeriod);
+		});
+		
+		// merge in tile order, the sums do not depend on which worker evaluated which tile
+		for (int t=0; t<(int)tileResult.size(); t++) {
+			const TileResult &tile = tileResult[t];
+			*readLatency = MAX(tile.readLatency, (*readLatency));
+			*readDynamicEnergy += tile.readDynamicEnergy;
+			*bufferLatency = MAX(tile.bufferLatency, (*bufferLatency));
+			*bufferDynamicEnergy += tile.bufferDynamicEnergy;
+			*icLatency = MAX(tile.icLatency, (*icLatency));
+			*icDynamicEnergy += tile.icDynamicEnergy;
+			
+			*coreLatencyADC = MAX(tile.latencyADC, (*coreLatencyADC));
+			*coreLatencyAccum = MAX(tile.latencyAccum, (*coreLatencyAccum));
+			*coreLatencyOther = MAX(tile.latencyOther, (*coreLatencyOther));
 			
-			// GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/ceil(GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
-			// GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ceil(GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile)), 
-								// ceil((numBitToLoadOut+numBitToLoadIn)/ceil(GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
-			GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/GhTree->busWidth));
-			GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, GhTree->busWidth, 
-							ceil((numBitToLoadOut+numBitToLoadIn)/GhTree->busWidth));
-			globalBuffer->CalculateLatency(globalBuffer->interface_width, numBitToLoadOut/globalBuffer->interface_width,
-									globalBuffer->interface_width, numBitToLoadIn/globalBuffer->interface_width);
-			globalBuffer->CalculatePower(globalBuffer->interface_width, numBitToLoadOut/globalBuffer->interface_width,
-									globalBuffer->interface_width, numBitToLoadIn/globalBuffer->interface_width);
+			*coreEnergyADC += tile.energyADC;
+			*coreEnergyAccum += tile.energyAccum;
+			*coreEnergyOther += tile.energyOther;
 			
-			// since multi-core buffer has improve the parallelism
-			globalBuffer->readLatency /= MIN(numBufferCore, ceil(globalBusWidth/globalBuffer->interface_width));
-			globalBuffer->writeLatency /= MIN(numBufferCore, ceil(globalBusWidth/globalBuffer->interface_width));
-			// each time, only a part of the ic is used to transfer data to a part of the tiles
-			globalBuffer->readLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));
-			globalBuffer->writeLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));
+			tileLeakage = tile.leakage;
+			if (*clkPeriod < tile.clkPeriod) {
+				*clkPeriod = tile.clkPeriod;
+			}
+		}
+		if (param->chipActivation) {
+			if (param->reLu) {
+				ctx.GreLu->CalculateLatency(ceil(numInVector*netStructure[l][5]/(double) ctx.GreLu->numUnit));
+				ctx.GreLu->CalculatePower(ceil(numInVector*netStructure[l][5]/(double) ctx.GreLu->numUnit));
+				*readLatency += ctx.GreLu->readLatency;
+				*readDynamicEnergy += ctx.GreLu->readDynamicEnergy;
+				*coreLatencyOther += ctx.GreLu->readLatency;
+				*coreEnergyOther += ctx.GreLu->readDynamicEnergy;
+			} else {
+				ctx.Gsigmoid->CalculateLatency(ceil(numInVector*netStructure[l][5]/ctx.Gsigmoid->numEntry));
+				ctx.Gsigmoid->CalculatePower(ceil(numInVector*netStructure[l][5]/ctx.Gsigmoid->numEntry));
+				*readLatency += ctx.Gsigmoid->readLatency;
+				*readDynamicEnergy += ctx.Gsigmoid->readDynamicEnergy;
+				*coreLatencyOther += ctx.Gsigmoid->readLatency;
+				*coreEnergyOther += ctx.Gsigmoid->readDynamicEnergy;
+			}
 		}
+		
+		if (numTileEachLayer[0][l] > 1) {   
+			ctx.Gaccumulation->CalculateLatency(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) ctx.Gaccumulation->numAdderTree)), numTileEachLayer[0][l], 0);
+			ctx.Gaccumulation->CalculatePower(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) ctx.Gaccumulation->numAdderTree)), numTileEachLayer[0][l]);
+			*readLatency += ctx.Gaccumulation->readLatency;
+			*readDynamicEnergy += ctx.Gaccumulation->readDynamicEnergy;
+			*coreLatencyAccum += ctx.Gaccumulation->readLatency;
+			*coreEnergyAccum += ctx.Gaccumulation->readDynamicEnergy;
+		}
+		
+		// if this layer is followed by Max Pool
+		if (followedByMaxPool) {
+			ctx.maxPool->CalculateLatency(1e20, 0, ceil((double) (numInVector/(double) ctx.maxPool->window)/(double) desiredTileSizeCM));
+			ctx.maxPool->CalculatePower(ceil((double) (numInVector/ctx.maxPool->window)/(double) desiredTileSizeCM));
+			*readLatency += ctx.maxPool->readLatency;
+			*readDynamicEnergy += ctx.maxPool->readDynamicEnergy;
+			*coreLatencyOther += ctx.maxPool->readLatency;
+			*coreEnergyOther += ctx.maxPool->readDynamicEnergy;
+		}							  
+		
+		double numBitToLoadOut = weightMatrixRow*param->numBitInput*numInVector;
+		double numBitToLoadIn = ceil(weightMatrixCol/param->numColPerSynapse)*param->numBitInput*numInVector/(netStructure[l][6]? 4:1);
+		
+		// ctx.GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/ceil(ctx.GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
+		// ctx.GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ceil(ctx.GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile)), 
+							// ceil((numBitToLoadOut+numBitToLoadIn)/ceil(ctx.GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
+		ctx.GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/ctx.GhTree->busWidth));
+		ctx.GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], CMTileheight, CMTilewidth, ctx.GhTree->busWidth, 
+						ceil((numBitToLoadOut+numBitToLoadIn)/ctx.GhTree->busWidth));
+		ctx.globalBuffer->CalculateLatency(ctx.globalBuffer->interface_width, numBitToLoadOut/ctx.globalBuffer->interface_width,
+								ctx.globalBuffer->interface_width, numBitToLoadIn/ctx.globalBuffer->interface_width);
+		ctx.globalBuffer->CalculatePower(ctx.globalBuffer->interface_width, numBitToLoadOut/ctx.globalBuffer->interface_width,
+								ctx.globalBuffer->interface_width, numBitToLoadIn/ctx.globalBuffer->interface_width);
+		
+		// since multi-core buffer has improve the parallelism
+		ctx.globalBuffer->readLatency /= MIN(ctx.numBufferCore, ceil(ctx.globalBusWidth/ctx.globalBuffer->interface_width));
+		ctx.globalBuffer->writeLatency /= MIN(ctx.numBufferCore, ceil(ctx.globalBusWidth/ctx.globalBuffer->interface_width));
+		// each time, only a part of the ic is used to transfer data to a part of the tiles
+		ctx.globalBuffer->readLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));
+		ctx.globalBuffer->writeLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));
 	} else {   // novel Mapping
-		for (int i=0; i<ceil((double) netStructure[l][2]*(double) numRowPerSynapse/(double) desiredPESizeNM); i++) {       // # of tiles in row
-			for (int j=0; j<ceil((double) netStructure[l][5]*(double) numColPerSynapse/(double) desiredPESizeNM); j++) {   // # of tiles in Column
-				double tileReadLatency = 0;
-				double tileReadDynamicEnergy = 0;
-				double tilebufferLatency = 0;
-				double tilebufferDynamicEnergy = 0;
-				double tileicLatency = 0;
-				double tileicDynamicEnergy = 0;
-				double tileLatencyADC = 0;
-				double tileLatencyAccum = 0;
-				double tileLatencyOther = 0;
-				double tileEnergyADC = 0;
-				double tileEnergyAccum = 0;
-				double tileEnergyOther = 0;
-				
-				// novel mapping
-				int numtileEachLayerRow = ceil((double) netStructure[l][2]*(double) numRowPerSynapse/(double) desiredPESizeNM);
-				int numtileEachLayerCol = ceil((double) netStructure[l][5]*(double) numColPerSynapse/(double) desiredPESizeNM);
-				
-				int numRowMatrix = min(desiredPESizeNM*numPENM, weightMatrixRow-i*desiredPESizeNM*numPENM);
-				int numColMatrix = min(desiredPESizeNM, weightMatrixCol-j*desiredPESizeNM);
-				
-				// assign weight and input to specific tile
-				vector<vector<double> > tileMemory;
-				tileMemory = ReshapeArray(newMemory, i*desiredPESizeNM, j*desiredPESizeNM, (int) netStructure[l][2]*numRowPerSynapse/numtileEachLayerRow, 
-									(int) netStructure[l][5]*numColPerSynapse/numtileEachLayerCol, numPENM, (int) netStructure[l][2]*numRowPerSynapse);
+		int numtileEachLayerRow = ceil((double) netStructure[l][2]*(double) numRowPerSynapse/(double) desiredPESizeNM);       // # of tiles in row
+		int numtileEachLayerCol = ceil((double) netStructure[l][5]*(double) numColPerSynapse/(double) desiredPESizeNM);   // # of tiles in Column
+		vector<TileResult> tileResult(numtileEachLayerRow*numtileEachLayerCol);
+		EvaluateTiles(ctx, tileResult.size(), [&](SimContext &tileCtx, int t) {
+			int i = t/numtileEachLayerCol;
+			int j = t%numtileEachLayerCol;
+			TileResult &tile = tileResult[t];
+			
+			int numRowMatrix = min(desiredPESizeNM*numPENM, weightMatrixRow-i*desiredPESizeNM*numPENM);
+			int numColMatrix = min(desiredPESizeNM, weightMatrixCol-j*desiredPESizeNM);
+			
+			// assign weight and input to specific tile
+			MatrixView tileMemory = newMemory.Reshape(i*desiredPESizeNM, j*desiredPESizeNM, (int) netStructure[l][2]*numRowPerSynapse/numtileEachLayerRow, 
+								(int) netStructure[l][5]*numColPerSynapse/numtileEachLayerCol, numPENM, (int) netStructure[l][2]*numRowPerSynapse);
 
-				vector<vector<double> > tileInput;
-				tileInput = ReshapeInput(inputVector, i*desiredPESizeNM, (int) (netStructure[l][0]-netStructure[l][3]+1)*(netStructure[l][1]-netStructure[l][4]+1)*param->numBitInput, 
-									(int) netStructure[l][2]*numRowPerSynapse/numtileEachLayerRow, numPENM, (int) netStructure[l][2]*numRowPerSynapse);
+			MatrixView tileInput = layerInput.Reshape(i*desiredPESizeNM, 0, (int) netStructure[l][2]*numRowPerSynapse/numtileEachLayerRow, 0, numPENM, (int) netStructure[l][2]*numRowPerSynapse);
 	
-				
-				TileCalculatePerformance(tileMemory, tileMemory, tileInput, markNM[l], numPENM, desiredPESizeNM, speedUpEachLayer[0][l], speedUpEachLayer[1][l],
-									numRowMatrix, numColMatrix, numInVector*param->numBitInput, cell, 
-									&tileReadLatency, &tileReadDynamicEnergy, &tileLeakage, &tilebufferLatency, &tilebufferDynamicEnergy, &tileicLatency, &tileicDynamicEnergy,
-									&tileLatencyADC, &tileLatencyAccum, &tileLatencyOther, &tileEnergyADC, &tileEnergyAccum, &tileEnergyOther, CalculateclkFreq, clkPeriod);
-				
-				
-				*readLatency = MAX(tileReadLatency, (*readLatency));
-				*readDynamicEnergy += tileReadDynamicEnergy;
-				*bufferLatency = MAX(tilebufferLatency, (*bufferLatency));
-				*bufferDynamicEnergy += tilebufferDynamicEnergy;
-				*icLatency = MAX(tileicLatency, (*icLatency));
-				*icDynamicEnergy += tileicDynamicEnergy;
-				
-				*coreLatencyADC = MAX(tileLatencyADC, (*coreLatencyADC));
-				*coreLatencyAccum = MAX(tileLatencyAccum, (*coreLatencyAccum));
-				*coreLatencyOther = MAX(tileLatencyOther, (*coreLatencyOther));
-				
-				*coreEnergyADC += tileEnergyADC;
-				*coreEnergyAccum += tileEnergyAccum;
-				*coreEnergyOther += tileEnergyOther;
-			}
-		}
-		if(!CalculateclkFreq){
-			if (param->chipActivation) {
-				if (param->reLu) {
-					GreLu->CalculateLatency(ceil(numInVector*netStructure[l][5]/(double) GreLu->numUnit));
-					GreLu->CalculatePower(ceil(numInVector*netStructure[l][5]/(double) GreLu->numUnit));
-					*readLatency += GreLu->readLatency;
-					*readDynamicEnergy += GreLu->readDynamicEnergy;
-					*coreLatencyOther += GreLu->readLatency;
-					*coreEnergyOther += GreLu->readDynamicEnergy;
-				} else {
-					Gsigmoid->CalculateLatency(ceil(numInVector*netStructure[l][5]/Gsigmoid->numEntry));
-					Gsigmoid->CalculatePower(ceil(numInVector*netStructure[l][5]/Gsigmoid->numEntry));
-					*readLatency += Gsigmoid->readLatency;
-					*readDynamicEnergy += Gsigmoid->readDynamicEnergy;
-					*coreLatencyOther += Gsigmoid->readLatency;
-					*coreEnergyOther += Gsigmoid->readDynamicEnergy;
-				}
-			}
 			
-			if (numTileEachLayer[0][l] > 1) {   
-				Gaccumulation->CalculateLatency(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) Gaccumulation->numAdderTree)), numTileEachLayer[0][l], 0);
-				Gaccumulation->CalculatePower(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) Gaccumulation->numAdderTree)), numTileEachLayer[0][l]);
-				*readLatency += Gaccumulation->readLatency;
-				*readDynamicEnergy += Gaccumulation->readDynamicEnergy;
-				*coreLatencyAccum += Gaccumulation->readLatency;
-				*coreEnergyAccum += Gaccumulation->readDynamicEnergy;
-			}
+			TileCalculatePerformance(tileCtx, tileMemory, tileMemory, inputVector, tileInput, markNM[l], numPENM, desiredPESizeNM, speedUpEachLayer[0][l], speedUpEachLayer[1][l],
+								numRowMatrix, numColMatrix, numInVector*param->numBitInput, 
+								&tile.readLatency, &tile.readDynamicEnergy, &tile.leakage, &tile.bufferLatency, &tile.bufferDynamicEnergy, &tile.icLatency, &tile.icDynamicEnergy,
+								&tile.latencyADC, &tile.latencyAccum, &tile.latencyOther, &tile.energyADC, &tile.energyAccum, &tile.energyOther, &tile.clkPeriod);
+		});
+		
+		// merge in tile order, the sums do not depend on which worker evaluated which tile
+		for (int t=0; t<(int)tileResult.size(); t++) {
+			const TileResult &tile = tileResult[t];
+			*readLatency = MAX(tile.readLatency, (*readLatency));
+			*readDynamicEnergy += tile.readDynamicEnergy;
+			*bufferLatency = MAX(tile.bufferLatency, (*bufferLatency));
+			*bufferDynamicEnergy += tile.bufferDynamicEnergy;
+			*icLatency = MAX(tile.icLatency, (*icLatency));
+			*icDynamicEnergy += tile.icDynamicEnergy;
 			
-			// if this layer is followed by Max Pool
-			if (followedByMaxPool) {
-				maxPool->CalculateLatency(1e20, 0, ceil((double) (numInVector/(double) maxPool->window)/(double) desiredPESizeNM*sqrt((double) numPENM)));
-				maxPool->CalculatePower(ceil((double) (numInVector/maxPool->window)/(double) desiredPESizeNM*sqrt((double) numPENM)));
-				*readLatency += maxPool->readLatency;
-				*readDynamicEnergy += maxPool->readDynamicEnergy;
-				*coreLatencyOther += maxPool->readLatency;
-				*coreEnergyOther += maxPool->readDynamicEnergy;
-			}
-			double numBitToLoadOut = weightMatrixRow*param->numBitInput*numInVector/netStructure[l][3];
-			double numBitToLoadIn = ceil(weightMatrixCol/param->numColPerSynapse)*param->numBitInput*numInVector/(netStructure[l][6]? 4:1);
+			*coreLatencyADC = MAX(tile.latencyADC, (*coreLatencyADC));
+			*coreLatencyAccum = MAX(tile.latencyAccum, (*coreLatencyAccum));
+			*coreLatencyOther = MAX(tile.latencyOther, (*coreLatencyOther));
 			
-			// GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/ceil(GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
-			// GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ceil(GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile)), 
-								// ceil((numBitToLoadOut+numBitToLoadIn)/ceil(GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
-			GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/GhTree->busWidth));
-			GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, GhTree->busWidth, 
-							ceil((numBitToLoadOut+numBitToLoadIn)/GhTree->busWidth));
-			globalBuffer->CalculateLatency(globalBuffer->interface_width, numBitToLoadOut/globalBuffer->interface_width,
-									globalBuffer->interface_width, numBitToLoadIn/globalBuffer->interface_width);
-			globalBuffer->CalculatePower(globalBuffer->interface_width, numBitToLoadOut/globalBuffer->interface_width,
-									globalBuffer->interface_width, numBitToLoadIn/globalBuffer->interface_width);
-			// since multi-core buffer has improve the parallelism
-			globalBuffer->readLatency /= MIN(numBufferCore, ceil(globalBusWidth/globalBuffer->interface_width));
-			globalBuffer->writeLatency /= MIN(numBufferCore, ceil(globalBusWidth/globalBuffer->interface_width));
-			// each time, only a part of the ic is used to transfer data to a part of the tiles
-			globalBuffer->readLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));
-			globalBuffer->writeLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));	
+			*coreEnergyADC += tile.energyADC;
+			*coreEnergyAccum += tile.energyAccum;
+			*coreEnergyOther += tile.energyOther;
+			
+			tileLeakage = tile.leakage;
+			if (*clkPeriod < tile.clkPeriod) {
+				*clkPeriod = tile.clkPeriod;
+			}
 		}
-	}		
-	if(!CalculateclkFreq){
-		*bufferLatency += globalBuffer->readLatency + globalBuffer->writeLatency;
-		*bufferDynamicEnergy += globalBuffer->readDynamicEnergy + globalBuffer->writeDynamicEnergy;
-		*icLatency += GhTree->readLatency;
-		*icDynamicEnergy += GhTree->readDynamicEnergy;
+		if (param->chipActivation) {
+			if (param->reLu) {
+				ctx.GreLu->CalculateLatency(ceil(numInVector*netStructure[l][5]/(double) ctx.GreLu->numUnit));
+				ctx.GreLu->CalculatePower(ceil(numInVector*netStructure[l][5]/(double) ctx.GreLu->numUnit));
+				*readLatency += ctx.GreLu->readLatency;
+				*readDynamicEnergy += ctx.GreLu->readDynamicEnergy;
+				*coreLatencyOther += ctx.GreLu->readLatency;
+				*coreEnergyOther += ctx.GreLu->readDynamicEnergy;
+			} else {
+				ctx.Gsigmoid->CalculateLatency(ceil(numInVector*netStructure[l][5]/ctx.Gsigmoid->numEntry));
+				ctx.Gsigmoid->CalculatePower(ceil(numInVector*netStructure[l][5]/ctx.Gsigmoid->numEntry));
+				*readLatency += ctx.Gsigmoid->readLatency;
+				*readDynamicEnergy += ctx.Gsigmoid->readDynamicEnergy;
+				*coreLatencyOther += ctx.Gsigmoid->readLatency;
+				*coreEnergyOther += ctx.Gsigmoid->readDynamicEnergy;
+			}
+		}
+		
+		if (numTileEachLayer[0][l] > 1) {   
+			ctx.Gaccumulation->CalculateLatency(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) ctx.Gaccumulation->numAdderTree)), numTileEachLayer[0][l], 0);
+			ctx.Gaccumulation->CalculatePower(ceil(numTileEachLayer[1][l]*netStructure[l][5]*(numInVector/(double) ctx.Gaccumulation->numAdderTree)), numTileEachLayer[0][l]);
+			*readLatency += ctx.Gaccumulation->readLatency;
+			*readDynamicEnergy += ctx.Gaccumulation->readDynamicEnergy;
+			*coreLatencyAccum += ctx.Gaccumulation->readLatency;
+			*coreEnergyAccum += ctx.Gaccumulation->readDynamicEnergy;
+		}
+		
+		// if this layer is followed by Max Pool
+		if (followedByMaxPool) {
+			ctx.maxPool->CalculateLatency(1e20, 0, ceil((double) (numInVector/(double) ctx.maxPool->window)/(double) desiredPESizeNM*sqrt((double) numPENM)));
+			ctx.maxPool->CalculatePower(ceil((double) (numInVector/ctx.maxPool->window)/(double) desiredPESizeNM*sqrt((double) numPENM)));
+			*readLatency += ctx.maxPool->readLatency;
+			*readDynamicEnergy += ctx.maxPool->readDynamicEnergy;
+			*coreLatencyOther += ctx.maxPool->readLatency;
+			*coreEnergyOther += ctx.maxPool->readDynamicEnergy;
+		}
+		double numBitToLoadOut = weightMatrixRow*param->numBitInput*numInVector/netStructure[l][3];
+		double numBitToLoadIn = ceil(weightMatrixCol/param->numColPerSynapse)*param->numBitInput*numInVector/(netStructure[l][6]? 4:1);
 		
-		*readLatency += globalBuffer->readLatency + globalBuffer->writeLatency + GhTree->readLatency;
-		*readDynamicEnergy += globalBuffer->readDynamicEnergy + globalBuffer->writeDynamicEnergy + GhTree->readDynamicEnergy;
-		*coreLatencyOther += globalBuffer->readLatency + globalBuffer->writeLatency + GhTree->readLatency;
-		*coreEnergyOther += globalBuffer->readDynamicEnergy + globalBuffer->writeDynamicEnergy + GhTree->readDynamicEnergy;
+		// ctx.GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/ceil(ctx.GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
+		// ctx.GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ceil(ctx.GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile)), 
+							// ceil((numBitToLoadOut+numBitToLoadIn)/ceil(ctx.GhTree->busWidth*(numTileEachLayer[0][l]*numTileEachLayer[1][l]/totalNumTile))));
+		ctx.GhTree->CalculateLatency(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ceil((numBitToLoadOut+numBitToLoadIn)/ctx.GhTree->busWidth));
+		ctx.GhTree->CalculatePower(0, 0, tileLocaEachLayer[0][l], tileLocaEachLayer[1][l], NMTileheight, NMTilewidth, ctx.GhTree->busWidth, 
+						ceil((numBitToLoadOut+numBitToLoadIn)/ctx.GhTree->busWidth));
+		ctx.globalBuffer->CalculateLatency(ctx.globalBuffer->interface_width, numBitToLoadOut/ctx.globalBuffer->interface_width,
+								ctx.globalBuffer->interface_width, numBitToLoadIn/ctx.globalBuffer->interface_width);
+		ctx.globalBuffer->CalculatePower(ctx.globalBuffer->interface_width, numBitToLoadOut/ctx.globalBuffer->interface_width,
+								ctx.globalBuffer->interface_width, numBitToLoadIn/ctx.globalBuffer->interface_width);
+		// since multi-core buffer has improve the parallelism
+		ctx.globalBuffer->readLatency /= MIN(ctx.numBufferCore, ceil(ctx.globalBusWidth/ctx.globalBuffer->interface_width));
+		ctx.globalBuffer->writeLatency /= MIN(ctx.numBufferCore, ceil(ctx.globalBusWidth/ctx.globalBuffer->interface_width));
+		// each time, only a part of the ic is used to transfer data to a part of the tiles
+		ctx.globalBuffer->readLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));
+		ctx.globalBuffer->writeLatency *= ceil(totalNumTile/(numTileEachLayer[0][l]*numTileEachLayer[1][l]));	
+	}		
+	*bufferLatency += ctx.globalBuffer->readLatency + ctx.globalBuffer->writeLatency;
+	*bufferDynamicEnergy += ctx.globalBuffer->readDynamicEnergy + ctx.globalBuffer->writeDynamicEnergy;
+	*icLatency += ctx.GhTree->readLatency;
+	*icDynamicEnergy += ctx.GhTree->readDynamicEnergy;
+	
+	*readLatency += ctx.globalBuffer->readLatency + ctx.globalBuffer->writeLatency + ctx.GhTree->readLatency;
+	*readDynamicEnergy += ctx.globalBuffer->readDynamicEnergy + ctx.globalBuffer->writeDynamicEnergy + ctx.GhTree->readDynamicEnergy;
+	*coreLatencyOther += ctx.globalBuffer->readLatency + ctx.globalBuffer->writeLatency + ctx.GhTree->readLatency;
+	*coreEnergyOther += ctx.globalBuffer->readDynamicEnergy + ctx.globalBuffer->writeDynamicEnergy + ctx.GhTree->readDynamicEnergy;
 
-		*leakage = tileLeakage;
-	}
+	*leakage = tileLeakage;
 }
 
 
@@ -1090,34 +1150,58 @@ vector<vector<double> > OverallEachLayer(bool utilization, bool speedUp, const v
 
 
 
-vector<vector<double> > LoadInWeightData(const string &weightfile, int numRowPerSynapse, int numColPerSynapse, double maxConductance, double minConductance) {
+// write the level codes of one normalized integer weight (numColPerSynapse cells, or the BNN/XNOR pair),
+// ConductanceTable turns the codes into conductance
+static void MapWeightValue(int value, int numColPerSynapse, uint8_t *weightrow, uint8_t *weightrowb) {
+	int cellrange = pow(2, param->cellBit);
 	
-	ifstream fileone(weightfile.c_str());                           
-	string lineone;
-	string valone;
-	
-	int ROW = 0;
-	int COL = 0;
+	if (param->BNNparallelMode) {
+		weightrow[0] = (value == 1);
+		weightrow[1] = (value != 1);
+	} else if (param->XNORparallelMode || param->XNORsequentialMode) {
+		weightrow[0] = (value == 1);
+		weightrowb[0] = (value != 1);
+	} else {
+		// most significant cell first
+		int remainder;   
+		for (int z=numColPerSynapse-1; z>=0; z--) {   
+			remainder = ceil((double)(value%cellrange));
+			value = ceil((double)(value/cellrange));
+			weightrow[z] = MAX(0, MIN(remainder, cellrange-1));		// weights below algoWeightMin clip to level 0
+		}
+	}
+}
+
+
+
+WeightMatrix LoadInWeightData(const string &weightfile, int numRowPerSynapse, int numColPerSynapse) {
 	
-	if (!fileone.good()) {                                       
-		cerr << "Error: the fileone cannot be opened!" << endl;
-		exit(1);
-	}else{
-		while (getline(fileone, lineone, '\n')) {                   
-			ROW++;                                             
+	bool xnor = (param->XNORparallelMode || param->XNORsequentialMode);
+	TraceFile trace;
+	if (trace.Open(weightfile, param->traceChecksum)) {
+		// binary trace: integer codes are already normalized
+		if (trace.kind != TRACE_KIND_WEIGHT) {
+			cerr << "Error: " << weightfile << " is not a weight trace!" << endl;
+			exit(1);
 		}
-		fileone.clear();
-		fileone.seekg(0, ios::beg);                               
-		if (getline(fileone, lineone, '\n')) {                      
-			istringstream iss (lineone);                         
-			while (getline(iss, valone, ',')) {                   
-				COL++;
+		if (trace.bits != param->synapseBit) {
+			cerr << "Error: weight trace " << weightfile << " is " << trace.bits << "-bit but synapseBit is " << param->synapseBit << "!" << endl;
+			exit(1);
+		}
+		WeightMatrix weight;
+		weight.Resize(trace.rows*(xnor? 2:1), trace.cols*numColPerSynapse);
+		for (int row=0; row<trace.rows; row++) {
+			uint8_t *weightrow = weight.Row(xnor? 2*row : row);
+			uint8_t *weightrowb = xnor? weight.Row(2*row+1) : NULL;
+			const int32_t *code = trace.WeightRow(row);
+			for (int col=0; col<trace.cols; col++) {
+				MapWeightValue(code[col], numColPerSynapse, weightrow+col*numColPerSynapse, xnor? weightrowb+col : NULL);
 			}
-		}	
+		}
+		return weight;
 	}
-	fileone.clear();
-	fileone.seekg(0, ios::beg);                   
 	
+	CsvFile csv(weightfile);
 	
 	double NormalizedMin = 0;
 	double NormalizedMax = pow(2, param->synapseBit);
@@ -1125,245 +1209,82 @@ vector<vector<double> > LoadInWeightData(const string &weightfile, int numRowPer
 	double RealMax = param->algoWeightMax;
 	double RealMin = param->algoWeightMin;
 	
-	vector<vector<double> > weight;            
-	// load the data into a weight matrix ...
-	for (int row=0; row<ROW; row++) {	
-		vector<double> weightrow;
-		vector<double> weightrowb;
-		getline(fileone, lineone, '\n');              
-		istringstream iss;
-		iss.str(lineone);
-		for (int col=0; col<COL; col++) {       
-			while(getline(iss, valone, ',')){	
-				istringstream fs;
-				fs.str(valone);
-				double f=0;
-				fs >> f;	
-				//normalize weight to integer
-				double newdata = ((NormalizedMax-NormalizedMin)/(RealMax-RealMin)*(f-RealMax)+NormalizedMax);
-				if (newdata >= 0) {
-					newdata += 0.5;
-				}else {
-					newdata -= 0.5;
-				}
-				// map and expend the weight in memory array
-				int cellrange = pow(2, param->cellBit);
-				vector<double> synapsevector(numColPerSynapse);       
-				int value = newdata; 
-				
-				if (param->BNNparallelMode) {
-					if (value == 1) {
-						weightrow.push_back(maxConductance);
-						weightrow.push_back(minConductance);
-					} else {
-						weightrow.push_back(minConductance);
-						weightrow.push_back(maxConductance);
-					}
-				} else if (param->XNORparallelMode || param->XNORsequentialMode) {
-					if (value == 1) {
-						weightrow.push_back(maxConductance);
-						weightrowb.push_back(minConductance);
-					} else {
-						weightrow.push_back(minConductance);
-						weightrowb.push_back(maxConductance);
-					}
-				} else {
-					int remainder;   
-					for (int z=0; z<numColPerSynapse; z++) {   
-						remainder = ceil((double)(value%cellrange));
-						value = ceil((double)(value/cellrange));
-						synapsevector.insert(synapsevector.begin(), remainder);
-					}
-					for (int u=0; u<numColPerSynapse; u++) {
-						double cellvalue = synapsevector[u];
-						double conductance = cellvalue/(cellrange-1) * (maxConductance-minConductance) + minConductance;
-						weightrow.push_back(conductance);
-					}
-				}
+	WeightMatrix weight;
+	weight.Resize(csv.rows*(xnor? 2:1), csv.cols*numColPerSynapse);
+	// map the parsed rows into the weight matrix ...
+	#pragma omp parallel for schedule(dynamic, 16)
+	for (int row=0; row<csv.rows; row++) {	
+		uint8_t *weightrow = weight.Row(xnor? 2*row : row);
+		uint8_t *weightrowb = xnor? weight.Row(2*row+1) : NULL;
+		const double *value = csv.Row(row);
+		for (int col=0; col<csv.cols; col++) {       
+			double f = value[col];
+			//normalize weight to integer
+			double newdata = ((NormalizedMax-NormalizedMin)/(RealMax-RealMin)*(f-RealMax)+NormalizedMax);
+			if (newdata >= 0) {
+				newdata += 0.5;
+			}else {
+				newdata -= 0.5;
 			}
-		}
-		if (param->XNORparallelMode || param->XNORsequentialMode) {
-			weight.push_back(weightrow);
-			weightrow.clear();
-			weight.push_back(weightrowb);
-			weightrowb.clear();
-		} else {
-			weight.push_back(weightrow);
-			weightrow.clear();
+			// map and expend the weight in memory array
+			MapWeightValue((int)newdata, numColPerSynapse, weightrow+col*numColPerSynapse, xnor? weightrowb+col : NULL);
 		}
 	}
-	fileone.close();
 	
 	return weight;
-	weight.clear();
 }
 
 
 
-vector<vector<double> > CopyArray(const vector<vector<double> > &orginal, int positionRow, int positionCol, int numRow, int numCol) {
-	
-	vector<vector<double> > copy;
-	for (int i=0; i<numRow; i++) {
-		vector<double> copyRow;
-		for (int j=0; j<numCol; j++) {
-			copyRow.push_back(orginal[positionRow+i][positionCol+j]);
-		}
-		copy.push_back(copyRow);
-		copyRow.clear();
+// set one input bit of the vector-major layer matrix (in XNOR mode every trace row is followed by its complement)
+static void MapInputValue(double f, int row, int col, BitMatrix &inputvector) {
+	if (param->XNORparallelMode || param->XNORsequentialMode) {
+		inputvector.Set(col, 2*row + (f == 1? 0:1));
+	} else if (f == 1) {
+		inputvector.Set(col, row);
 	}
-	
-	return copy;
-	copy.clear();
-} 
+}
 
 
 
-vector<vector<double> > ReshapeArray(const vector<vector<double> > &orginal, int positionRow, int positionCol, int numRow, int numCol, int numPE, int weightMatrixRow) {
+BitMatrix LoadInInputData(const string &inputfile) {
 	
-	vector<vector<double> > copy;
-
-	for (int k=0; k<numPE; k++) {
-		for (int i=0; i<numRow; i++) {
-			vector<double> copyRow;
-			for (int j=0; j<numCol; j++) {
-				copyRow.push_back(orginal[positionRow+k*weightMatrixRow+i][positionCol+j]);
-			}
-			copy.push_back(copyRow);
-			copyRow.clear();
+	bool xnor = (param->XNORparallelMode || param->XNORsequentialMode);
+	BitMatrix inputvector;
+	TraceFile trace;
+	if (trace.Open(inputfile, param->traceChecksum)) {
+		// binary trace: bit-planes packed 64 per word
+		if (trace.kind != TRACE_KIND_INPUT) {
+			cerr << "Error: " << inputfile << " is not an input trace!" << endl;
+			exit(1);
 		}
-	}
-	
-	return copy;
-	copy.clear();
-} 
-
-
-
-vector<vector<double> > LoadInInputData(const string &inputfile) {
-	
-	ifstream infile(inputfile.c_str());     
-	string inputline;
-	string inputval;
-	
-	int ROWin=0, COLin=0;      
-	if (!infile.good()) {       
-		cerr << "Error: the input file cannot be opened!" << endl;
-		exit(1);
-	}else{
-		while (getline(infile, inputline, '\n')) {      
-			ROWin++;                               
+		if (trace.bits != param->numBitInput) {
+			cerr << "Error: input trace " << inputfile << " is " << trace.bits << "-bit but numBitInput is " << param->numBitInput << "!" << endl;
+			exit(1);
 		}
-		infile.clear();
-		infile.seekg(0, ios::beg);    
-		if (getline(infile, inputline, '\n')) {        
-			istringstream iss (inputline);      
-			while (getline(iss, inputval, ',')) {       
-				COLin++;
-			}
-		}	
-	}
-	infile.clear();
-	infile.seekg(0, ios::beg);          
-
-	vector<vector<double> > inputvector;              
-	// load the data into inputvector ...
-	for (int row=0; row<ROWin; row++) {	
-		vector<double> inputvectorrow;
-		vector<double> inputvectorrowb;
-		getline(infile, inputline, '\n');             
-		istringstream iss;
-		iss.str(inputline);
-		for (int col=0; col<COLin; col++) {
-			while(getline(iss, inputval, ',')){	
-				istringstream fs;
-				fs.str(inputval);
-				double f=0;
-				fs >> f;
-				
-				if (param->BNNparallelMode) {
-					if (f == 1) {
-						inputvectorrow.push_back(1);
-					} else {
-						inputvectorrow.push_back(0);
-					}
-				} else if (param->XNORparallelMode || param->XNORsequentialMode) {
-					if (f == 1) {
-						inputvectorrow.push_back(1);
-						inputvectorrowb.push_back(0);
-					} else {
-						inputvectorrow.push_back(0);
-						inputvectorrowb.push_back(1);
-					}
-				} else {
-					inputvectorrow.push_back(f);
-				}
+		inputvector.Resize(trace.cols, trace.rows*(xnor? 2:1));
+		for (int row=0; row<trace.rows; row++) {
+			for (int col=0; col<trace.cols; col++) {
+				MapInputValue(trace.InputBit(row, col), row, col, inputvector);
 			}
 		}
-		if (param->XNORparallelMode || param->XNORsequentialMode) {
-			inputvector.push_back(inputvectorrow);
-			inputvectorrow.clear();
-			inputvector.push_back(inputvectorrowb);
-			inputvectorrowb.clear();
-		} else {
-			inputvector.push_back(inputvectorrow);
-			inputvectorrow.clear();
-		}
+		return inputvector;
 	}
-	// close the input file ...
-	infile.close();
-	
-	return inputvector;
-	inputvector.clear();
-}
-
-
-
-
-vector<vector<double> > CopyInput(const vector<vector<double> > &orginal, int positionRow, int numInputVector, int numRow) {
-	
-	vector<vector<double> > copy;
-	for (int i=0; i<numRow; i++) {
-		vector<double> copyRow;
-		for (int j=0; j<numInputVector; j++) {
-			copyRow.push_back(orginal[positionRow+i][j]);
-		}
-		copy.push_back(copyRow);
-		copyRow.clear();
-	}
-	
-	return copy;
-	copy.clear();
 	
-} 
-
-
-
-vector<vector<double> > ReshapeInput(const vector<vector<double> > &orginal, int positionRow, int numInputVector, int numRow, int numPE, int weightMatrixRow) {
-	
-	vector<vector<double> > copy;
-
-	for (int k=0; k<numPE; k++) {
-		for (int i=0; i<numRow; i++) {
-			vector<double> copyRow;
-			for (int j=0; j<numInputVector; j++) {
-				copyRow.push_back(orginal[positionRow+k*weightMatrixRow+i][j]);
+	CsvFile csv(inputfile);
+	
+	inputvector.Resize(csv.cols, csv.rows*(xnor? 2:1));
+	// map the parsed rows into inputvector, one thread per 64 layer rows so that no two threads share a word ...
+	int rowsPerWord = xnor? 32 : 64;
+	#pragma omp parallel for schedule(dynamic)
+	for (int block=0; block<(csv.rows+rowsPerWord-1)/rowsPerWord; block++) {
+		for (int row=block*rowsPerWord; row<min(csv.rows, (block+1)*rowsPerWord); row++) {
+			const double *value = csv.Row(row);
+			for (int col=0; col<csv.cols; col++) {
+				MapInputValue(value[col], row, col, inputvector);
 			}
-			copy.push_back(copyRow);
-			copyRow.clear();
 		}
 	}
 	
-	return copy;
-	copy.clear();
-} 
-
-
-
-
-
-
-
-
-
-
-
+	return inputvector;
+}
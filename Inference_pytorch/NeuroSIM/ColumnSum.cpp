@@ -0,0 +1,249 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <stdint.h>
+#include <string.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define COLUMNSUM_X86
+#endif
+#include "ColumnSum.h"
+
+typedef void (*ColumnSumFunction)(const double *, int, int, const uint64_t *, double *);
+
+static void ColumnSumPortable(const double *cellG, int numRow, int numCol, const uint64_t *input, double *columnG) {
+	memset(columnG, 0, numCol*sizeof(double));
+	for (int w=0; w<(numRow+63)/64; w++) {
+		for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+			const double *row = cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol;
+			for (int j=0; j<numCol; j++) {
+				columnG[j] += row[j];
+			}
+		}
+	}
+}
+
+// fixed subArray width: the row stride is a constant and the accumulators live on the stack, so the
+// compiler vectorizes the column loop with the baseline ISA without aliasing checks
+template <int numCol>
+static void ColumnSumPortableFixed(const double *cellG, int numRow, int, const uint64_t *input, double *columnG) {
+	double acc[numCol] = {};
+	for (int w=0; w<(numRow+63)/64; w++) {
+		for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+			const double *row = cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol;
+			for (int j=0; j<numCol; j++) {
+				acc[j] += row[j];
+			}
+		}
+	}
+	memcpy(columnG, acc, numCol*sizeof(double));
+}
+
+#ifdef COLUMNSUM_X86
+__attribute__((target("avx2")))
+static void ColumnSumAVX2(const double *cellG, int numRow, int numCol, const uint64_t *input, double *columnG) {
+	int numWord = (numRow+63)/64;
+	int j = 0;
+	// 16 columns (4 independent accumulators) per pass over the active rows
+	for (; j+16<=numCol; j+=16) {
+		__m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd(), acc2 = _mm256_setzero_pd(), acc3 = _mm256_setzero_pd();
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				const double *row = cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol + j;
+				acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(row));
+				acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(row+4));
+				acc2 = _mm256_add_pd(acc2, _mm256_loadu_pd(row+8));
+				acc3 = _mm256_add_pd(acc3, _mm256_loadu_pd(row+12));
+			}
+		}
+		_mm256_storeu_pd(columnG+j, acc0);
+		_mm256_storeu_pd(columnG+j+4, acc1);
+		_mm256_storeu_pd(columnG+j+8, acc2);
+		_mm256_storeu_pd(columnG+j+12, acc3);
+	}
+	for (; j+4<=numCol; j+=4) {
+		__m256d acc = _mm256_setzero_pd();
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				acc = _mm256_add_pd(acc, _mm256_loadu_pd(cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol + j));
+			}
+		}
+		_mm256_storeu_pd(columnG+j, acc);
+	}
+	for (; j<numCol; j++) {
+		double acc = 0;
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				acc += cellG[(size_t)(w*64 + __builtin_ctzll(bits))*numCol + j];
+			}
+		}
+		columnG[j] = acc;
+	}
+}
+
+__attribute__((target("avx512f")))
+static void ColumnSumAVX512(const double *cellG, int numRow, int numCol, const uint64_t *input, double *columnG) {
+	int numWord = (numRow+63)/64;
+	int j = 0;
+	// 32 columns (4 independent accumulators) per pass over the active rows
+	for (; j+32<=numCol; j+=32) {
+		__m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd(), acc2 = _mm512_setzero_pd(), acc3 = _mm512_setzero_pd();
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				const double *row = cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol + j;
+				acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(row));
+				acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(row+8));
+				acc2 = _mm512_add_pd(acc2, _mm512_loadu_pd(row+16));
+				acc3 = _mm512_add_pd(acc3, _mm512_loadu_pd(row+24));
+			}
+		}
+		_mm512_storeu_pd(columnG+j, acc0);
+		_mm512_storeu_pd(columnG+j+8, acc1);
+		_mm512_storeu_pd(columnG+j+16, acc2);
+		_mm512_storeu_pd(columnG+j+24, acc3);
+	}
+	// remaining columns 8 at a time, the last block masked
+	for (; j<numCol; j+=8) {
+		__mmask8 mask = (numCol-j >= 8)? 0xff : (__mmask8)((1u << (numCol-j)) - 1);
+		__m512d acc = _mm512_setzero_pd();
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				acc = _mm512_add_pd(acc, _mm512_maskz_loadu_pd(mask, cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol + j));
+			}
+		}
+		_mm512_mask_storeu_pd(columnG+j, mask, acc);
+	}
+}
+
+// fixed subArray width: 32 columns (8 accumulators) per pass, no remainder, inner loops fully unrolled
+template <int numCol>
+__attribute__((target("avx2")))
+static void ColumnSumAVX2Fixed(const double *cellG, int numRow, int, const uint64_t *input, double *columnG) {
+	int numWord = (numRow+63)/64;
+	for (int j=0; j<numCol; j+=32) {
+		__m256d acc[8];
+#pragma GCC unroll 8
+		for (int k=0; k<8; k++) {
+			acc[k] = _mm256_setzero_pd();
+		}
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				const double *row = cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol + j;
+#pragma GCC unroll 8
+				for (int k=0; k<8; k++) {
+					acc[k] = _mm256_add_pd(acc[k], _mm256_loadu_pd(row+4*k));
+				}
+			}
+		}
+#pragma GCC unroll 8
+		for (int k=0; k<8; k++) {
+			_mm256_storeu_pd(columnG+j+4*k, acc[k]);
+		}
+	}
+}
+
+// fixed subArray width: up to 128 columns (16 accumulators) per pass, so 64 and 128 columns walk the active rows once
+template <int numCol>
+__attribute__((target("avx512f")))
+static void ColumnSumAVX512Fixed(const double *cellG, int numRow, int, const uint64_t *input, double *columnG) {
+	constexpr int block = (numCol < 128)? numCol : 128;
+	constexpr int numAcc = block/8;
+	int numWord = (numRow+63)/64;
+	for (int j=0; j<numCol; j+=block) {
+		__m512d acc[numAcc];
+#pragma GCC unroll 16
+		for (int k=0; k<numAcc; k++) {
+			acc[k] = _mm512_setzero_pd();
+		}
+		for (int w=0; w<numWord; w++) {
+			for (uint64_t bits = input[w]; bits; bits &= bits-1) {
+				const double *row = cellG + (size_t)(w*64 + __builtin_ctzll(bits))*numCol + j;
+#pragma GCC unroll 16
+				for (int k=0; k<numAcc; k++) {
+					acc[k] = _mm512_add_pd(acc[k], _mm512_loadu_pd(row+8*k));
+				}
+			}
+		}
+#pragma GCC unroll 16
+		for (int k=0; k<numAcc; k++) {
+			_mm512_storeu_pd(columnG+j+8*k, acc[k]);
+		}
+	}
+}
+#endif
+
+// generic kernel plus the fixed-width ones for the usual subArray sizes (64, 128 and 256 columns)
+struct ColumnSumKernels {
+	const char *name;
+	ColumnSumFunction generic;
+	ColumnSumFunction fixed64;
+	ColumnSumFunction fixed128;
+	ColumnSumFunction fixed256;
+};
+
+static ColumnSumKernels SelectColumnSum() {
+#ifdef COLUMNSUM_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f")) {
+		return { "avx512", ColumnSumAVX512, ColumnSumAVX512Fixed<64>, ColumnSumAVX512Fixed<128>, ColumnSumAVX512Fixed<256> };
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		return { "avx2", ColumnSumAVX2, ColumnSumAVX2Fixed<64>, ColumnSumAVX2Fixed<128>, ColumnSumAVX2Fixed<256> };
+	}
+#endif
+	return { "portable", ColumnSumPortable, ColumnSumPortableFixed<64>, ColumnSumPortableFixed<128>, ColumnSumPortableFixed<256> };
+}
+
+static const ColumnSumKernels columnSum = SelectColumnSum();
+
+void ColumnSum(const double *cellG, int numRow, int numCol, const uint64_t *input, double *columnG) {
+	switch (numCol) {
+		case 64:	columnSum.fixed64(cellG, numRow, numCol, input, columnG); break;
+		case 128:	columnSum.fixed128(cellG, numRow, numCol, input, columnG); break;
+		case 256:	columnSum.fixed256(cellG, numRow, numCol, input, columnG); break;
+		default:	columnSum.generic(cellG, numRow, numCol, input, columnG); break;
+	}
+}
+
+void ColumnSumGeneric(const double *cellG, int numRow, int numCol, const uint64_t *input, double *columnG) {
+	columnSum.generic(cellG, numRow, numCol, input, columnG);
+}
+
+const char *ColumnSumKernel() {
+	return columnSum.name;
+}
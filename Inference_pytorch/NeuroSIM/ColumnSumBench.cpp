@@ -0,0 +1,126 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <cstdio>
+#include <stdint.h>
+#include <stdlib.h>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "MemCell.h"
+#include "InputParameter.h"
+#include "Technology.h"
+#include "Param.h"
+#include "ColumnSum.h"
+#include "Definition.h"
+
+using namespace std;
+
+/*** Micro-benchmark of the masked column sum: fixed-width kernels (64/128/256 columns) against the generic one ***/
+// usage: ./ColumnSumBench [numVector] [activity]
+// Every case also checks that both kernels give the same sums bit for bit.
+
+static double TimeKernel(void (*kernel)(const double *, int, int, const uint64_t *, double *), const vector<double> &cellG,
+						int numRow, int numCol, const vector<uint64_t> &input, int numVector) {
+	// best of 5 passes over the vectors, the sums land in one cache-resident row as they would in a subArray pass
+	int numWord = (numRow+63)/64;
+	vector<double> columnG(numCol);
+	double best = 0;
+	for (int pass=0; pass<5; pass++) {
+		auto start = chrono::high_resolution_clock::now();
+		for (int v=0; v<numVector; v++) {
+			kernel(cellG.data(), numRow, numCol, &input[(size_t)v*numWord], columnG.data());
+		}
+		auto stop = chrono::high_resolution_clock::now();
+		double t = chrono::duration<double, nano>(stop - start).count()/numVector;
+		best = (pass == 0)? t : min(best, t);
+	}
+	return best;
+}
+
+int main(int argc, char * argv[]) {
+	int numVector = (argc > 1)? atoi(argv[1]) : 20000;
+	double activity = (argc > 2)? atof(argv[2]) : 0.5;
+	if (numVector <= 0 || activity < 0 || activity > 1) {
+		cout << "Error: usage ./ColumnSumBench [numVector > 0] [activity in 0~1]" << endl;
+		exit(-1);
+	}
+	cout << "ColumnSum kernel: " << ColumnSumKernel() << ", " << numVector << " input vectors, row activity " << activity << endl;
+	cout << "numRow  numCol   generic(ns/vector)   fixed(ns/vector)   speedup" << endl;
+	
+	mt19937 gen(1);
+	uniform_real_distribution<double> conductance(1e-7, 1e-5);
+	bernoulli_distribution active(activity);
+	const int size[] = {64, 128, 256};
+	bool mismatch = false;
+	for (int numRow : size) {
+		for (int numCol : size) {
+			int numWord = (numRow+63)/64;
+			vector<double> cellG((size_t)numRow*numCol);
+			for (double &g : cellG) {
+				g = conductance(gen);
+			}
+			vector<uint64_t> input((size_t)numVector*numWord, 0);
+			for (int v=0; v<numVector; v++) {
+				for (int i=0; i<numRow; i++) {
+					if (active(gen)) {
+						input[(size_t)v*numWord + i/64] |= (uint64_t) 1 << (i%64);
+					}
+				}
+			}
+			double tGeneric = TimeKernel(ColumnSumGeneric, cellG, numRow, numCol, input, numVector);
+			double tFixed = TimeKernel(ColumnSum, cellG, numRow, numCol, input, numVector);
+			vector<double> generic(numCol), fixed(numCol);
+			for (int v=0; v<numVector; v++) {
+				ColumnSumGeneric(cellG.data(), numRow, numCol, &input[(size_t)v*numWord], generic.data());
+				ColumnSum(cellG.data(), numRow, numCol, &input[(size_t)v*numWord], fixed.data());
+				if (generic != fixed) {
+					mismatch = true;
+				}
+			}
+			printf("%6d  %6d   %18.1f   %16.1f   %6.2fx\n", numRow, numCol, tGeneric, tFixed, tGeneric/tFixed);
+		}
+	}
+	if (mismatch) {
+		cout << "Error: fixed-width and generic kernels disagree!" << endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <cmath>
+#include <vector>
+#include "ColumnTable.h"
+
+using namespace std;
+
+#define COLUMNTABLE_MIN_EXP	0		// 1 ohm
+#define COLUMNTABLE_MAX_EXP	48		// 2.8e14 ohm
+#define COLUMNTABLE_MIN_SEGMENT_BIT	4
+#define COLUMNTABLE_MAX_SEGMENT_BIT	12	// 48 binades x 4096 segments = 1.5 MB
+
+ColumnTable::ColumnTable() {
+	segmentBit = 0;
+	error = 0;
+	xMin = xMax = 0;		// empty, every lookup falls back to the analytic model
+	shift = 0;
+	indexOffset = fractionMask = 0;
+	fractionScale = 0;
+}
+
+bool ColumnTable::Initialize(const function<double(double)> &f, double maxError) {
+	// refine until the interpolation error is within maxError
+	for (int bit=COLUMNTABLE_MIN_SEGMENT_BIT; bit<=COLUMNTABLE_MAX_SEGMENT_BIT; bit++) {
+		Build(f, bit);
+		if (error <= maxError) {
+			return true;
+		}
+	}
+	value.clear();
+	xMin = xMax = 0;
+	return false;
+}
+
+void ColumnTable::Build(const function<double(double)> &f, int _segmentBit) {
+	segmentBit = _segmentBit;
+	shift = 52 - segmentBit;
+	fractionMask = ((uint64_t) 1 << shift) - 1;
+	fractionScale = ldexp(1.0, -shift);
+	indexOffset = (uint64_t) (1023 + COLUMNTABLE_MIN_EXP) << segmentBit;
+	xMin = ldexp(1.0, COLUMNTABLE_MIN_EXP);
+	xMax = ldexp(1.0, COLUMNTABLE_MAX_EXP);
+	
+	size_t numSegment = (size_t) (COLUMNTABLE_MAX_EXP - COLUMNTABLE_MIN_EXP) << segmentBit;
+	value.resize(numSegment + 1);
+	for (size_t i=0; i<=numSegment; i++) {
+		value[i] = f(Node(i, false));
+	}
+	error = 0;
+	for (size_t i=0; i<numSegment; i++) {
+		double x = Node(i, true);
+		double exact = f(x);
+		double y = 0;
+		Lookup(x, &y);
+		if (exact != 0) {
+			error = max(error, fabs(y - exact) / fabs(exact));
+		} else {
+			error = max(error, fabs(y));
+		}
+	}
+}
+
+double ColumnTable::Node(size_t index, bool midpoint) const {
+	uint64_t bits = (uint64_t) (index + indexOffset) << shift;
+	if (midpoint) {
+		bits |= (uint64_t) 1 << (shift - 1);
+	}
+	double x;
+	memcpy(&x, &bits, sizeof(x));
+	return x;
+}
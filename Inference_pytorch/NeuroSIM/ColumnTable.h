@@ -0,0 +1,85 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef COLUMNTABLE_H_
+#define COLUMNTABLE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+/*** Column resistance -> column power of the read circuit ***/
+// Log-spaced table of a smooth function of the column resistance: every binade of [2^minExp, 2^maxExp) ohm is split into
+// 2^segmentBit equal segments with linear interpolation in between. The segment is taken from the exponent/mantissa
+// bits of the resistance, so a lookup needs no log/exp. Out of range (0, inf) the caller evaluates the analytic model.
+class ColumnTable {
+public:
+	ColumnTable();
+	virtual ~ColumnTable() {}
+	
+	bool Initialize(const function<double(double)> &f, double maxError);	// false if maxError cannot be met, the table stays empty
+	bool Lookup(double x, double *y) const {
+		if (!(x >= xMin && x < xMax)) {
+			return false;
+		}
+		uint64_t bits;
+		memcpy(&bits, &x, sizeof(bits));
+		size_t index = (bits >> shift) - indexOffset;
+		double t = (double) (bits & fractionMask) * fractionScale;
+		*y = value[index] + t * (value[index+1] - value[index]);
+		return true;
+	}
+	
+	int segmentBit;		// # of segments per binade = 2^segmentBit
+	double error;		// max relative error against f, measured at every segment midpoint
+	
+private:
+	void Build(const function<double(double)> &f, int _segmentBit);
+	double Node(size_t index, bool midpoint) const;
+	
+	vector<double> value;
+	double xMin, xMax;
+	int shift;
+	uint64_t indexOffset, fractionMask;
+	double fractionScale;
+};
+
+#endif /* COLUMNTABLE_H_ */
@@ -0,0 +1,131 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <cstdio>
+#include <stdlib.h>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <functional>
+#include <algorithm>
+#include "MemCell.h"
+#include "InputParameter.h"
+#include "Technology.h"
+#include "Param.h"
+#include "ColumnTable.h"
+#include "MultilevelSenseAmp.h"
+#include "SarADC.h"
+#include "Definition.h"
+
+using namespace std;
+
+/*** Accuracy check of the column power tables (param->columnTable) against the analytic MLSA/SAR ADC models ***/
+// usage: ./ColumnTableCheck [numSample]
+// For every supported technode and device roadmap, the tables of the voltage/current mode MLSA and of the SAR ADC are
+// built as in a run, then compared with GetColumnPower at numSample random resistances per binade of the table range.
+// Fails if any relative error is above param->columnTableError.
+
+static double MaxTableError(const ColumnTable &table, const function<double(double)> &f, int numSample, mt19937 &gen) {
+	uniform_real_distribution<double> mantissa(1, 2);
+	double error = 0;
+	for (int e=0; e<48; e++) {		// the table covers [1, 2^48) ohm
+		for (int s=0; s<numSample; s++) {
+			double x = ldexp(mantissa(gen), e);
+			double exact = f(x);
+			double y = 0;
+			if (!table.Lookup(x, &y)) {
+				return INFINITY;		// table left empty
+			}
+			error = max(error, (exact != 0)? fabs(y - exact) / fabs(exact) : fabs(y));
+		}
+	}
+	return error;
+}
+
+int main(int argc, char * argv[]) {
+	int numSample = (argc > 1)? atoi(argv[1]) : 2000;
+	if (numSample <= 0) {
+		cout << "Error: usage ./ColumnTableCheck [numSample > 0]" << endl;
+		exit(-1);
+	}
+	param->columnTable = true;
+	cout << "Column power tables, columnTableError = " << param->columnTableError << ", " << numSample << " samples per binade" << endl;
+	cout << "technode  roadmap  circuit         segments/binade   max relative error" << endl;
+	
+	mt19937 gen(1);
+	const int technode[] = {130, 90, 65, 45, 32, 22, 14, 10, 7};
+	bool fail = false;
+	for (int node : technode) {
+		for (int roadmap=1; roadmap<=2; roadmap++) {
+			param->technode = node;
+			param->deviceroadmap = roadmap;
+			inputParameter.deviceRoadmap = (roadmap == 1)? HP : LSTP;
+			inputParameter.processNode = node;
+			if (!tech.Initialize(node, inputParameter.deviceRoadmap, conventional)) {
+				return 1;
+			}
+			
+			MultilevelSenseAmp currentMLSA(inputParameter, tech, cell), voltageMLSA(inputParameter, tech, cell);
+			SarADC sarADC(inputParameter, tech, cell);
+			int numCol = param->numColSubArray/param->numColMuxed;
+			currentMLSA.Initialize(numCol, param->levelOutput, param->clkFreq, param->numColMuxed, true, true);
+			voltageMLSA.Initialize(numCol, param->levelOutput, param->clkFreq, param->numColMuxed, true, false);
+			sarADC.Initialize(numCol, param->levelOutput, param->clkFreq, param->numColMuxed);
+			
+			const char *name[] = {"MLSA current", "MLSA voltage", "SAR ADC"};
+			const ColumnTable *table[] = {&currentMLSA.powerTable, &voltageMLSA.powerTable, &sarADC.powerTable};
+			function<double(double)> model[] = {
+				[&currentMLSA](double columnRes) { return currentMLSA.GetColumnPower(columnRes); },
+				[&voltageMLSA](double columnRes) { return voltageMLSA.GetColumnPower(columnRes); },
+				[&sarADC](double columnRes) { return sarADC.GetColumnPower(columnRes); }
+			};
+			for (int c=0; c<3; c++) {
+				double error = MaxTableError(*table[c], model[c], numSample, gen);
+				bool ok = (error <= param->columnTableError);
+				printf("%8d  %7s  %-14s  %15d   %18.3e%s\n", node, (roadmap == 1)? "HP" : "LP", name[c], 1 << table[c]->segmentBit, error, ok? "" : "  FAIL");
+				fail = fail || !ok;
+			}
+			tech.initialized = false;
+		}
+	}
+	if (fail) {
+		cout << "Error: a column power table is off the analytic model by more than columnTableError!" << endl;
+		return 1;
+	}
+	return 0;
+}
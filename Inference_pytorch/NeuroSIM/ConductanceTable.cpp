@@ -0,0 +1,88 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <cmath>
+#include <vector>
+#include "Param.h"
+#include "ConductanceTable.h"
+
+using namespace std;
+
+extern Param *param;
+
+ConductanceTable::ConductanceTable() {
+	numLevel = numRow = numCol = 0;
+	resistanceAccess = 0;
+}
+
+void ConductanceTable::Initialize(const MemCell &cell, int numRowSubArray, int numColSubArray) {
+	// binary synapses (see MapWeightValue) only use the two extreme conductances
+	bool binary = (param->BNNparallelMode || param->XNORparallelMode || param->XNORsequentialMode);
+	numLevel = binary? 2 : pow(2, param->cellBit);
+	conductance.resize(numLevel);
+	for (int level=0; level<numLevel; level++) {
+		if (binary) {
+			conductance[level] = level? param->maxConductance : param->minConductance;
+		} else {
+			double cellvalue = level;
+			conductance[level] = cellvalue/(numLevel-1) * (param->maxConductance-param->minConductance) + param->minConductance;
+		}
+	}
+	// only RRAM with a 1T1R access transistor sees the access resistance
+	resistanceAccess = (cell.memCellType == Type::RRAM && cell.accessType == CMOS_access)? cell.resistanceAccess : 0;
+	
+	// keep the wire table within a few MB (cellBit above 4 falls back to direct evaluation)
+	numRow = numCol = 0;
+	wireConductance.clear();
+	if ((double) numLevel*numRowSubArray*numColSubArray <= (1 << 18)) {
+		numRow = numRowSubArray;
+		numCol = numColSubArray;
+		wireConductance.resize((size_t)numRow*numCol*numLevel);
+		for (int i=1; i<=numRow; i++) {
+			for (int j=0; j<numCol; j++) {
+				for (int level=0; level<numLevel; level++) {
+					wireConductance[((size_t)(i-1)*numCol + j)*numLevel + level] = (double) 1.0/WireResistance(level, i, j);
+				}
+			}
+		}
+	}
+}
+
+double ConductanceTable::WireResistance(int level, int rowToEnd, int col) const {
+	return (double) 1.0/conductance[level] + (col + 1) * param->wireResistanceRow + rowToEnd * param->wireResistanceCol + resistanceAccess;
+}
@@ -0,0 +1,77 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef CONDUCTANCETABLE_H_
+#define CONDUCTANCETABLE_H_
+
+#include <stdint.h>
+#include <vector>
+#include "MemCell.h"
+
+using namespace std;
+
+/*** Weight cell level -> conductance ***/
+// Mapped weights are kept as uint8 level codes: the cell value 0 ~ 2^cellBit-1, or 0/1 (min/max conductance) for parallel BNN and XNOR.
+// Besides the cell conductance, the table holds the conductance seen through the row/column wires for every
+// cell position of a subArray (same expression as GetColumnResistance used to evaluate per cell).
+class ConductanceTable {
+public:
+	ConductanceTable();
+	virtual ~ConductanceTable() {}
+	
+	void Initialize(const MemCell &cell, int numRowSubArray, int numColSubArray);
+	double Conductance(int level) const { return conductance[level]; }
+	double WireConductance(int level, int rowToEnd, int col) const {		// rowToEnd: the last row of the array is 1
+		if (rowToEnd <= numRow && col < numCol) {
+			return wireConductance[((size_t)(rowToEnd-1)*numCol + col)*numLevel + level];
+		}
+		return (double) 1.0/WireResistance(level, rowToEnd, col);
+	}
+	
+	int numLevel;
+	
+private:
+	double WireResistance(int level, int rowToEnd, int col) const;
+	
+	vector<double> conductance;
+	vector<double> wireConductance;
+	int numRow, numCol;			// extent of wireConductance, 0 if the table would be too large
+	double resistanceAccess;
+};
+
+#endif /* CONDUCTANCETABLE_H_ */
@@ -0,0 +1,209 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <charconv>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+#include "CsvFile.h"
+
+using namespace std;
+
+double CsvFile::bytesParsed = 0;
+double CsvFile::secondsParsed = 0;
+
+CsvFile::CsvFile(const string &filename) {
+	rows = cols = 0;
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		cerr << "Error: the file " << filename << " cannot be opened!" << endl;
+		exit(1);
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		cerr << "Error: the file " << filename << " cannot be opened!" << endl;
+		exit(1);
+	}
+	size_t size = st.st_size;
+	if (size == 0) {
+		close(fd);
+		return;
+	}
+	void *mapped = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		cerr << "Error: the file " << filename << " cannot be mapped!" << endl;
+		exit(1);
+	}
+	madvise(mapped, size, MADV_SEQUENTIAL);
+	double start = omp_get_wtime();
+	const char *text = (const char *)mapped;
+	const char *textEnd = text + size;
+	
+	// the first non-blank line fixes the column count and the expected bytes per row
+	const char *p = text;
+	const char *eol = p;
+	vector<double> first;
+	const char *error = NULL;
+	while (p < textEnd && first.empty() && !error) {
+		eol = (const char *)memchr(p, '\n', textEnd-p);
+		if (!eol) eol = textEnd;
+		error = ParseLine(p, eol, first);
+		p = eol + 1;
+	}
+	cols = first.size();
+	double bytesPerRow = max<double>(eol-text, 1);
+	
+	// cut the rest into line-aligned chunks, a few per thread for load balance
+	p = min(p, textEnd);
+	size_t remain = textEnd - p;
+	int numChunk = max(1, min(omp_get_max_threads()*4, (int)(remain >> 16)));
+	chunks.resize(numChunk+1);
+	chunks[0].begin = text;
+	chunks[0].end = p;
+	chunks[0].values.swap(first);
+	chunks[0].rows = cols? 1 : 0;
+	chunks[0].error = error;
+	chunks[0].errorCols = -1;
+	const char *begin = p;
+	for (int i=1; i<=numChunk; i++) {
+		const char *end = (i == numChunk)? textEnd : p + remain*i/numChunk;
+		if (end < begin) {
+			end = begin;
+		} else if (end < textEnd) {
+			end = (const char *)memchr(end, '\n', textEnd-end);
+			end = end? end+1 : textEnd;
+		}
+		chunks[i].begin = begin;
+		chunks[i].end = end;
+		chunks[i].values.reserve((size_t)((end-begin)/bytesPerRow*1.05 + 1) * cols);
+		begin = end;
+	}
+	
+	if (!error) {
+		#pragma omp parallel for schedule(dynamic)
+		for (int i=1; i<=numChunk; i++) {
+			ParseChunk(chunks[i], cols);
+		}
+	}
+	
+	for (size_t i=0; i<chunks.size(); i++) {
+		if (chunks[i].error) {
+			int line = 1 + count(text, chunks[i].error, '\n');
+			if (chunks[i].errorCols < 0) {
+				cerr << "Error: cannot parse line " << line << " of " << filename << "!" << endl;
+			} else {
+				cerr << "Error: line " << line << " of " << filename << " has " << chunks[i].errorCols << " columns instead of " << cols << "!" << endl;
+			}
+			exit(1);
+		}
+		for (int r=0; r<chunks[i].rows; r++) {
+			rowValue.push_back(&chunks[i].values[(size_t)r*cols]);
+		}
+	}
+	rows = rowValue.size();
+	
+	double seconds = omp_get_wtime() - start;
+	#pragma omp atomic
+	secondsParsed += seconds;
+	#pragma omp atomic
+	bytesParsed += size;
+	munmap(mapped, size);
+}
+
+// append the fields of one line, return the first malformed field or NULL
+const char *CsvFile::ParseLine(const char *p, const char *eol, vector<double> &values) {
+	while (p < eol) {
+		while (p < eol && (*p == ' ' || *p == '\t' || *p == '\r')) p++;
+		if (p == eol) {
+			break;		// blank line, or a trailing comma
+		}
+		double f = 0;
+		if (*p != ',') {
+			const char *q = (*p == '+')? p+1 : p;
+			from_chars_result result = from_chars(q, eol, f);
+			if (result.ec != errc()) {
+				return p;
+			}
+			q = result.ptr;
+			while (q < eol && (*q == ' ' || *q == '\t' || *q == '\r')) q++;
+			if (q < eol && *q != ',') {
+				return p;
+			}
+			p = q;
+		}
+		values.push_back(f);
+		p++;		// past the comma
+	}
+	return NULL;
+}
+
+void CsvFile::ParseChunk(Chunk &chunk, int cols) {
+	chunk.rows = 0;
+	chunk.error = NULL;
+	chunk.errorCols = -1;
+	const char *p = chunk.begin;
+	while (p < chunk.end) {
+		const char *eol = (const char *)memchr(p, '\n', chunk.end-p);
+		if (!eol) eol = chunk.end;
+		size_t first = chunk.values.size();
+		chunk.error = ParseLine(p, eol, chunk.values);
+		if (chunk.error) {
+			return;
+		}
+		int n = chunk.values.size() - first;
+		if (n > 0) {
+			if (n != cols) {
+				chunk.error = p;
+				chunk.errorCols = n;
+				return;
+			}
+			chunk.rows++;
+		}
+		p = eol + 1;
+	}
+}
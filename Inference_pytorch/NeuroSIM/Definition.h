@@ -36,14 +36,11 @@
 *   Xiaochen Peng   Email: xpeng15 at asu dot edu
 ********************************************************************************/
 
-// This file cannot be compiled alone. Only include this file in main.cpp.
+// This file cannot be compiled alone. Only include this file in the file holding main() (main.cpp, ColumnSumBench.cpp).
 
 /* Global variables */
 Param *param = new Param(); // Parameter set
 
-/* Random number generator engine */
-std::mt19937 gen;
-
 InputParameter inputParameter;
 Technology tech;
 MemCell cell;
@@ -0,0 +1,279 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include <algorithm>
+#include "Param.h"
+#include "InputStream.h"
+
+using namespace std;
+
+extern Param *param;
+
+InputStream::InputStream() {
+	numRow = numCol = 0;
+	streaming = false;
+	complementRow = false;
+	implicit = false;
+	ifmWidth = kernelHeight = kernelWidth = stride = outWidth = 0;
+}
+
+void InputStream::Assign(BitMatrix &_matrix) {
+	matrix.Swap(_matrix);
+	trace.Close();
+	streaming = false;
+	complementRow = false;
+	implicit = false;
+	numRow = matrix.numCol;
+	numCol = matrix.numRow;
+}
+
+void InputStream::Open(const string &inputfile, const vector<double> &layerStructure) {
+	BitMatrix empty;
+	matrix.Swap(empty);
+	if (!trace.Open(inputfile, param->traceChecksum)) {
+		string tempfile;
+		Transcode(inputfile, &tempfile);
+		trace.Open(tempfile, false);		// just written, nothing to verify
+		unlink(tempfile.c_str());		// the mapping stays valid until Close()
+	}
+	if (trace.kind != TRACE_KIND_INPUT && trace.kind != TRACE_KIND_IFM) {
+		cerr << "Error: " << inputfile << " is not an input trace!" << endl;
+		exit(1);
+	}
+	if (trace.bits != param->numBitInput) {
+		cerr << "Error: input trace " << inputfile << " is " << trace.bits << "-bit but numBitInput is " << param->numBitInput << "!" << endl;
+		exit(1);
+	}
+	streaming = true;
+	complementRow = (param->XNORparallelMode || param->XNORsequentialMode);
+	implicit = (trace.kind == TRACE_KIND_IFM);
+	if (implicit) {
+		// netStructure: H, W, C, kernel H, kernel W, Cout, followedByMaxPool, stride
+		int height = layerStructure[0];
+		ifmWidth = layerStructure[1];
+		kernelHeight = layerStructure[3];
+		kernelWidth = layerStructure[4];
+		stride = layerStructure[7];
+		if ((int)trace.header.height != height || (int)trace.header.width != ifmWidth || trace.rows != layerStructure[2] || trace.cols != height*ifmWidth*trace.bits) {
+			cerr << "Error: feature map " << inputfile << " is " << trace.header.height << "x" << trace.header.width << "x" << trace.rows
+					<< " but the layer expects " << height << "x" << ifmWidth << "x" << layerStructure[2] << "!" << endl;
+			exit(1);
+		}
+		outWidth = (ifmWidth-kernelWidth)/stride + 1;
+		int outHeight = (height-kernelHeight)/stride + 1;
+		numRow = trace.rows*kernelHeight*kernelWidth*(complementRow? 2:1);
+		numCol = outHeight*outWidth*trace.bits;
+	} else {
+		numRow = trace.rows*(complementRow? 2:1);
+		numCol = trace.cols;
+	}
+}
+
+void InputStream::Transcode(const string &inputfile, string *tempfile) {
+	ifstream infile(inputfile.c_str());
+	if (!infile.good()) {
+		cerr << "Error: the input file cannot be opened!" << endl;
+		exit(1);
+	}
+	const char *tmpdir = getenv("TMPDIR");
+	string name = string(tmpdir? tmpdir : "/tmp") + "/neurosim_inputXXXXXX";
+	vector<char> path(name.begin(), name.end());
+	path.push_back('\0');
+	int fd = mkstemp(&path[0]);
+	FILE *out = (fd < 0)? NULL : fdopen(fd, "wb");
+	if (!out) {
+		cerr << "Error: cannot create a temporary trace for " << inputfile << "!" << endl;
+		exit(1);
+	}
+	*tempfile = &path[0];
+	
+	TraceHeader header;
+	memset(&header, 0, sizeof(header));
+	header.magic = TRACE_MAGIC;
+	header.version = TRACE_VERSION;
+	header.kind = TRACE_KIND_INPUT;
+	header.bits = param->numBitInput;
+	header.layer = TRACE_LAYER_ANY;
+	fwrite(&header, sizeof(header), 1, out);
+	
+	// one line in memory at a time
+	string line;
+	vector<uint64_t> words;
+	int rows = 0, cols = -1;
+	while (getline(infile, line, '\n')) {
+		if (line.find_first_not_of(" \t\r") == string::npos) {
+			continue;
+		}
+		fill(words.begin(), words.end(), 0);
+		int col = 0;
+		const char *p = line.c_str();
+		while (*p) {
+			char *end;
+			double f = strtod(p, &end);
+			if (end == p) {
+				cerr << "Error: cannot parse row " << rows << " of " << inputfile << "!" << endl;
+				exit(1);
+			}
+			if ((size_t)col/64 >= words.size()) {
+				words.resize(col/64+1, 0);
+			}
+			if (f == 1) {
+				words[col/64] |= (uint64_t)1 << (col%64);
+			}
+			col++;
+			p = end;
+			while (*p == ',' || *p == ' ' || *p == '\t' || *p == '\r') {
+				p++;
+			}
+		}
+		if (cols < 0) {
+			cols = col;
+			words.resize((cols+63)/64, 0);
+		} else if (col != cols) {
+			cerr << "Error: row " << rows << " of " << inputfile << " has " << col << " columns instead of " << cols << "!" << endl;
+			exit(1);
+		}
+		fwrite(&words[0], sizeof(uint64_t), words.size(), out);
+		header.checksum = TraceFile::Checksum(&words[0], words.size()*sizeof(uint64_t), header.checksum);
+		rows++;
+	}
+	header.rows = rows;
+	header.cols = (cols < 0)? 0 : cols;
+	fseek(out, 0, SEEK_SET);
+	fwrite(&header, sizeof(header), 1, out);
+	if (fclose(out) != 0) {
+		cerr << "Error: cannot write the temporary trace for " << inputfile << "!" << endl;
+		exit(1);
+	}
+}
+
+void InputStream::ReadWindow(const MatrixView &rows, int firstVector, int numVector, BitMatrix &window) const {
+	window.Resize(numVector, rows.numRow);
+	for (int i=0; i<rows.numRow; i++) {
+		int rowIndex = rows.RowIndex(i);
+		if (rowIndex >= numRow || firstVector+numVector > numCol) {
+			cerr << "Error: input vector " << firstVector+numVector-1 << " of row " << rowIndex << " is out of the input trace (" << numRow << "x" << numCol << ")!" << endl;
+			exit(1);
+		}
+	}
+	if (!streaming) {
+		// the view maps runs of consecutive subArray rows to consecutive layer rows
+		vector<int> runStart, runLength;
+		for (int i=0; i<rows.numRow; i++) {
+			int rowIndex = rows.RowIndex(i);
+			if (i > 0 && rowIndex == runStart.back() + runLength.back()) {
+				runLength.back()++;
+			} else {
+				runStart.push_back(rowIndex);
+				runLength.push_back(1);
+			}
+		}
+		for (int j=0; j<numVector; j++) {
+			const uint64_t *record = matrix.Row(firstVector+j);
+			uint64_t *windowRow = window.Row(j);
+			for (int r=0, i=0; r<(int)runStart.size(); i+=runLength[r], r++) {
+				BitMatrix::CopyBits(record, runStart[r], windowRow, i, runLength[r]);
+			}
+		}
+		return;
+	}
+	for (int i=0; i<rows.numRow; i++) {
+		int rowIndex = rows.RowIndex(i);
+		if (!implicit) {
+			int row = complementRow? rowIndex/2 : rowIndex;
+			bool complement = complementRow && (rowIndex%2 == 1);
+			for (int j=0; j<numVector; j++) {
+				if (trace.InputBit(row, firstVector+j) != complement) {
+					window.Set(j, i);
+				}
+			}
+		} else {
+			// row = (channel, kernel y, kernel x) as in hook.py stretch_input, column = (output pixel, bit)
+			int row = complementRow? rowIndex/2 : rowIndex;
+			bool complement = complementRow && (rowIndex%2 == 1);
+			int channel = row/(kernelHeight*kernelWidth);
+			int dy = row/kernelWidth%kernelHeight;
+			int dx = row%kernelWidth;
+			int bit = firstVector%trace.bits;
+			int pixel = firstVector/trace.bits;
+			int y = pixel/outWidth*stride + dy;
+			int x = pixel%outWidth*stride + dx;
+			for (int j=0; j<numVector; j++) {
+				if (trace.InputBit(channel, (y*ifmWidth+x)*trace.bits+bit) != complement) {
+					window.Set(j, i);
+				}
+				if (++bit == trace.bits) {
+					bit = 0;
+					x += stride;
+					if (x >= outWidth*stride + dx) {
+						x = dx;
+						y += stride;
+					}
+				}
+			}
+		}
+	}
+}
+
+double InputStream::Size() const {
+	return matrix.Size();
+}
+
+
+InputWindow::InputWindow(const InputStream &_inputStream, const MatrixView &_rows, int _numVector)
+		: inputStream(_inputStream), rows(_rows) {
+	numVector = _numVector;
+	windowSize = (param->inputWindowSize > 0)? param->inputWindowSize : numVector;
+	firstVector = -1;
+}
+
+int InputWindow::Seek(int k) {
+	if (firstVector < 0 || k < firstVector || k >= firstVector+windowSize) {
+		firstVector = k;
+		inputStream.ReadWindow(rows, firstVector, min(windowSize, numVector-firstVector), window);
+	}
+	return k-firstVector;
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef INPUTSTREAM_H_
+#define INPUTSTREAM_H_
+
+#include <string>
+#include <vector>
+#include "TraceFile.h"
+#include "BitMatrix.h"
+#include "MatrixView.h"
+
+using namespace std;
+
+/*** Input activation of one layer ***/
+// Either the whole parsed matrix (Assign) or a mapped binary trace that is read window by window (Open).
+// The parsed matrix is held vector-major (one packed record of all layer rows per input column), so a
+// window is filled from contiguous records with word copies of the row runs of the subArray.
+// CSV traces opened for streaming are first transcoded line by line into a temporary binary trace.
+// An IFM trace holds the unexpanded feature map; each row (channel, kernel y, kernel x) and column
+// (input vector, bit) is then looked up in it with the kernel and stride of the layer (implicit im2col).
+// Rows are the layer rows after XNOR expansion; Tile/PE/subArray refer to them through row lists.
+class InputStream {
+public:
+	InputStream();
+	virtual ~InputStream() {}
+	
+	void Assign(BitMatrix &matrix);		// takes over the vector-major matrix content (row = input column)
+	void Open(const string &inputfile, const vector<double> &layerStructure);		// layerStructure: one netStructure row
+	void ReadWindow(const MatrixView &rows, int firstVector, int numVector, BitMatrix &window) const;		// window row j = input column firstVector+j over rows
+	double Size() const;		// bytes held in memory
+	
+	int numRow, numCol;
+	
+private:
+	BitMatrix matrix;
+	TraceFile trace;
+	bool streaming;
+	bool complementRow;			// XNOR: odd rows are the complement of the trace row
+	bool implicit;				// IFM trace
+	int ifmWidth, kernelHeight, kernelWidth, stride, outWidth;
+	
+	void Transcode(const string &inputfile, string *tempfile);
+};
+
+/*** Sliding window of input vectors for one subArray ***/
+class InputWindow {
+public:
+	InputWindow(const InputStream &inputStream, const MatrixView &rows, int numVector);
+	
+	int Seek(int k);		// make input vector k resident, return its column in window
+	
+	BitMatrix window;			// one packed row per input column, bit i = subArray row i
+	
+private:
+	const InputStream &inputStream;
+	MatrixView rows;
+	int numVector, windowSize, firstVector;
+};
+
+#endif /* INPUTSTREAM_H_ */
@@ -0,0 +1,105 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <iostream>
+#include <climits>
+#include <stdlib.h>
+#include "MatrixView.h"
+
+using namespace std;
+
+MatrixView::MatrixView() {
+	data = NULL;
+	numRow = numCol = rowStride = colOffset = 0;
+	rowBase = rowOffset = blockStride = 0;
+	blockRows = INT_MAX;
+}
+
+MatrixView::MatrixView(const uint8_t *_data, int _numRow, int _numCol, int _rowStride) {
+	data = _data;
+	numRow = _numRow;
+	numCol = _numCol;
+	rowStride = _rowStride;
+	colOffset = 0;
+	rowBase = rowOffset = blockStride = 0;
+	blockRows = INT_MAX;
+}
+
+MatrixView::MatrixView(int _numRow) {
+	data = NULL;
+	numRow = _numRow;
+	numCol = rowStride = colOffset = 0;
+	rowBase = rowOffset = blockStride = 0;
+	blockRows = INT_MAX;
+}
+
+MatrixView MatrixView::Sub(int positionRow, int positionCol, int _numRow, int _numCol) const {
+	MatrixView sub = *this;
+	sub.rowOffset += positionRow;
+	sub.colOffset += positionCol;
+	sub.numRow = _numRow;
+	sub.numCol = _numCol;
+	return sub;
+}
+
+MatrixView MatrixView::Reshape(int positionRow, int positionCol, int _numRow, int _numCol, int numPE, int _blockStride) const {
+	if (blockRows != INT_MAX) {
+		cerr << "Error: a reshaped matrix view cannot be reshaped again!" << endl;
+		exit(1);
+	}
+	MatrixView reshape = *this;
+	reshape.rowBase += rowOffset + positionRow;
+	reshape.rowOffset = 0;
+	reshape.blockRows = _numRow;
+	reshape.blockStride = _blockStride;
+	reshape.colOffset += positionCol;
+	reshape.numRow = _numRow*numPE;
+	reshape.numCol = _numCol;
+	return reshape;
+}
+
+
+WeightMatrix::WeightMatrix() {
+	numRow = numCol = 0;
+}
+
+void WeightMatrix::Resize(int _numRow, int _numCol) {
+	numRow = _numRow;
+	numCol = _numCol;
+	data.assign((size_t)numRow*numCol, 0);
+}
@@ -0,0 +1,89 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef MATRIXVIEW_H_
+#define MATRIXVIEW_H_
+
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+
+/*** Non-owning view of a sub-matrix of weight level codes ***/
+// Row r of the view is row rowBase + (rowOffset+r)/blockRows*blockStride + (rowOffset+r)%blockRows of the
+// underlying matrix: a plain sub-matrix is a single block, the novel mapping (Reshape) stacks numPE blocks
+// of rows that sit blockStride rows apart. A view without data only carries the row mapping, which is
+// how Tile/PE/subArray address the rows of the layer input.
+class MatrixView {
+public:
+	MatrixView();
+	MatrixView(const uint8_t *data, int numRow, int numCol, int rowStride);
+	explicit MatrixView(int numRow);		// rows 0 ~ numRow-1, no data
+	
+	MatrixView Sub(int positionRow, int positionCol, int numRow, int numCol) const;
+	MatrixView Reshape(int positionRow, int positionCol, int numRow, int numCol, int numPE, int blockStride) const;
+	
+	int RowIndex(int row) const { row += rowOffset; return rowBase + row/blockRows*blockStride + row%blockRows; }
+	const uint8_t *Row(int row) const { return data + (size_t)RowIndex(row)*rowStride + colOffset; }
+	
+	int numRow, numCol;
+	
+private:
+	const uint8_t *data;
+	int rowStride, colOffset;
+	int rowBase, rowOffset, blockRows, blockStride;
+};
+
+/*** Row-major matrix of weight level codes (one contiguous buffer) ***/
+class WeightMatrix {
+public:
+	WeightMatrix();
+	virtual ~WeightMatrix() {}
+	
+	void Resize(int numRow, int numCol);
+	uint8_t *Row(int row) { return data.data() + (size_t)row*numCol; }
+	MatrixView View() const { return MatrixView(data.data(), numRow, numCol, numCol); }
+	double Size() const { return data.capacity()*sizeof(uint8_t); }		// bytes
+	
+	int numRow, numCol;
+	
+private:
+	vector<uint8_t> data;
+};
+
+#endif /* MATRIXVIEW_H_ */
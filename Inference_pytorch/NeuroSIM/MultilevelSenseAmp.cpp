@@ -83,10 +83,94 @@ void MultilevelSenseAmp::Initialize(int _numCol, int _levelOutput, double _clkFr
 		// Initialize SenseAmp
 		currentSenseAmp.Initialize((levelOutput-1)*numCol, false, false, clkFreq, numReadCellPerOperationNeuro);        // use real-traced mode ... 
 		
+		InitializeColumnModel();
+		if (param->columnTable) {
+			if (!powerTable.Initialize([this](double columnRes) { return GetColumnPower(columnRes); }, param->columnTableError)) {
+				cout << "[MultilevelSenseAmp] Warning: column power table cannot meet columnTableError, using the analytic model" << endl;
+			}
+		}
+		
 		initialized = true;
 	}
 }
 
+void MultilevelSenseAmp::InitializeColumnModel() {
+	// pick the Cadence fits of the technode once, GetColumnLatency/GetColumnPower run for every column of every input vector
+	latencyFit = false;
+	tMaxSlope = tMaxOffset = 0;
+	if (param->deviceroadmap != 1) {  // LP (HP is 1e-9)
+		if (param->technode == 130) {
+			double low[4] = {0.3856, 2.4653, -5.3996, 3.915}, high[5] = {1.2211, -0.2725, 0.0742, -0.0087, 0.0004};
+			SetLatencyFit(0.2679, 0.0478, low, high);
+		} else if (param->technode == 90) {
+			double low[4] = {0.3574, 2.8249, -5.651, 3.726}, high[5] = {0.9835, -0.0188, 0.0017, -0.00007, 0.0000008};
+			SetLatencyFit(0.0586, 1.41, low, high);
+		} else if (param->technode == 65) {
+			double low[4] = {0.3202, 2.0483, -2.6913, 1.3899}, high[5] = {1.0512, -0.0346, 0.1043, -0.0363, 0.0036};
+			SetLatencyFit(0.1239, 0.6642, low, high);
+		} else if (param->technode == 45 || param->technode == 32) {
+			double low[4] = {0.4807, 2.6492, -5.6685, 3.7949}, high[5] = {1.0057, -0.0171, 0.0001, -0.00006, 0.000001};
+			SetLatencyFit(0.0714, 0.7651, low, high);
+		}   // technode below and equal to 22nm is 1e-9
+	}
+	
+	double powerPerLevel;	// uW per reference level
+	if (currentMode) {
+		if (param->deviceroadmap == 1) {  // HP
+			if (param->technode == 130)		{ powerPerLevel = 19.898; powerCoeff = 0.17452; powerExponent = -2.367; }
+			else if (param->technode == 90)	{ powerPerLevel = 13.09; powerCoeff = 0.14900; powerExponent = -2.345; }
+			else if (param->technode == 65)	{ powerPerLevel = 9.9579; powerCoeff = 0.1083; powerExponent = -2.321; }
+			else if (param->technode == 45)	{ powerPerLevel = 7.7017; powerCoeff = 0.0754; powerExponent = -2.296; }
+			else if (param->technode == 32)	{ powerPerLevel = 3.9648; powerCoeff = 0.079; powerExponent = -2.313; }
+			else if (param->technode == 22)	{ powerPerLevel = 1.8939; powerCoeff = 0.073; powerExponent = -2.311; }
+			else if (param->technode == 14)	{ powerPerLevel = 1.2; powerCoeff = 0.0584; powerExponent = -2.311; }
+			else if (param->technode == 10)	{ powerPerLevel = 0.8; powerCoeff = 0.0318; powerExponent = -2.311; }
+			else							{ powerPerLevel = 0.5; powerCoeff = 0.0210; powerExponent = -2.311; }   // 7nm
+		} else {                         // LP
+			if (param->technode == 130)		{ powerPerLevel = 18.09; powerCoeff = 0.1380; powerExponent = -2.303; }
+			else if (param->technode == 90)	{ powerPerLevel = 12.612; powerCoeff = 0.1023; powerExponent = -2.303; }
+			else if (param->technode == 65)	{ powerPerLevel = 8.4147; powerCoeff = 0.0972; powerExponent = -2.303; }
+			else if (param->technode == 45)	{ powerPerLevel = 6.3162; powerCoeff = 0.075; powerExponent = -2.303; }
+			else if (param->technode == 32)	{ powerPerLevel = 3.0875; powerCoeff = 0.0649; powerExponent = -2.297; }
+			else if (param->technode == 22)	{ powerPerLevel = 1.7; powerCoeff = 0.0631; powerExponent = -2.303; }
+			else if (param->technode == 14)	{ powerPerLevel = 1.0; powerCoeff = 0.0508; powerExponent = -2.303; }
+			else if (param->technode == 10)	{ powerPerLevel = 0.55; powerCoeff = 0.0315; powerExponent = -2.303; }
+			else							{ powerPerLevel = 0.35; powerCoeff = 0.0235; powerExponent = -2.303; }   // 7nm
+		}
+	} else {
+		if (param->deviceroadmap == 1) {  // HP
+			if (param->technode == 130)		{ powerPerLevel = 27.84; powerCoeff = 0.207452; powerExponent = -2.367; }
+			else if (param->technode == 90)	{ powerPerLevel = 22.2; powerCoeff = 0.164900; powerExponent = -2.345; }
+			else if (param->technode == 65)	{ powerPerLevel = 13.058; powerCoeff = 0.128483; powerExponent = -2.321; }
+			else if (param->technode == 45)	{ powerPerLevel = 8.162; powerCoeff = 0.097754; powerExponent = -2.296; }
+			else if (param->technode == 32)	{ powerPerLevel = 4.76; powerCoeff = 0.083709; powerExponent = -2.313; }
+			else if (param->technode == 22)	{ powerPerLevel = 2.373; powerCoeff = 0.084273; powerExponent = -2.311; }
+			else if (param->technode == 14)	{ powerPerLevel = 1.467; powerCoeff = 0.060584; powerExponent = -2.311; }
+			else if (param->technode == 10)	{ powerPerLevel = 0.9077; powerCoeff = 0.049418; powerExponent = -2.311; }
+			else							{ powerPerLevel = 0.5614; powerCoeff = 0.040310; powerExponent = -2.311; }   // 7nm
+		} else {                         // LP
+			if (param->technode == 130)		{ powerPerLevel = 23.4; powerCoeff = 0.169380; powerExponent = -2.303; }
+			else if (param->technode == 90)	{ powerPerLevel = 14.42; powerCoeff = 0.144323; powerExponent = -2.303; }
+			else if (param->technode == 65)	{ powerPerLevel = 10.18; powerCoeff = 0.121272; powerExponent = -2.303; }
+			else if (param->technode == 45)	{ powerPerLevel = 7.062; powerCoeff = 0.100225; powerExponent = -2.303; }
+			else if (param->technode == 32)	{ powerPerLevel = 3.692; powerCoeff = 0.079449; powerExponent = -2.297; }
+			else if (param->technode == 22)	{ powerPerLevel = 1.866; powerCoeff = 0.072341; powerExponent = -2.303; }
+			else if (param->technode == 14)	{ powerPerLevel = 1.126; powerCoeff = 0.061085; powerExponent = -2.303; }
+			else if (param->technode == 10)	{ powerPerLevel = 0.6917; powerCoeff = 0.051580; powerExponent = -2.303; }
+			else							{ powerPerLevel = 0.4211; powerCoeff = 0.043555; powerExponent = -2.303; }   // 7nm
+		}
+	}
+	powerLevel = powerPerLevel*(levelOutput-1)*1e-6;
+}
+
+void MultilevelSenseAmp::SetLatencyFit(double slope, double offset, const double *low, const double *high) {
+	latencyFit = true;
+	tMaxSlope = slope;
+	tMaxOffset = offset;
+	for (int i=0; i<4; i++) latencyLow[i] = low[i];
+	for (int i=0; i<5; i++) latencyHigh[i] = high[i];
+}
+
 void MultilevelSenseAmp::CalculateArea(double heightArray, double widthArray, AreaModify _option) {
 	if (!initialized) {
 		cout << "[MultilevelSenseAmp] Error: Require initialization first!" << endl;
@@ -153,15 +237,8 @@ void MultilevelSenseAmp::CalculateLatency(const vector<double> &columnResistance
 	} else {
 		readLatency = 0;
 		double LatencyCol = 0;
-		for (double j=0; j<columnResistance.size(); j++){
-			double T_Col = 0;
-			T_Col = GetColumnLatency(columnResistance[j]);
-			LatencyCol = max(LatencyCol, T_Col);
-			if (LatencyCol < 1e-9) {
-				LatencyCol = 1e-9;
-			} else if (LatencyCol > 10e-9) {
-				LatencyCol = 10e-9;
-			}
+		if (currentMode) {		// only the current mode S/A waits for the slowest column
+			LatencyCol = GetSlowestColumnLatency(columnResistance);
 		}
 		if (currentMode) {
 			readLatency = LatencyCol*numColMuxed;
@@ -182,20 +259,15 @@ void MultilevelSenseAmp::CalculatePower(const vector<double> &columnResistance,
 		readDynamicEnergy = 0;
 		
 		double LatencyCol = 0;
-		for (double j=0; j<columnResistance.size(); j++){
-			double T_Col = 0;
-			T_Col = GetColumnLatency(columnResistance[j]);
-			LatencyCol = max(LatencyCol, T_Col);
-			if (LatencyCol < 1e-9) {
-				LatencyCol = 1e-9;
-			} else if (LatencyCol > 10e-9) {
-				LatencyCol = 10e-9;
-			}
+		if (currentMode) {		// only the current mode S/A waits for the slowest column
+			LatencyCol = GetSlowestColumnLatency(columnResistance);
 		}
 
 		for (double i=0; i<columnResistance.size(); i++) {
 			double P_Col = 0;
-			P_Col = GetColumnPower(columnResistance[i]);
+			if (!powerTable.Lookup(columnResistance[i], &P_Col)) {
+				P_Col = GetColumnPower(columnResistance[i]);
+			}
 			if (currentMode) {
 				readDynamicEnergy += MAX(P_Col*LatencyCol, 0);
 			} else {
@@ -206,6 +278,24 @@ void MultilevelSenseAmp::CalculatePower(const vector<double> &columnResistance,
 	}
 } 
 
+double MultilevelSenseAmp::GetSlowestColumnLatency(const vector<double> &columnResistance) {
+	if (!latencyFit) {		// every column takes 0 or 1e-9, which the 1ns floor below turns into 1e-9
+		return columnResistance.empty()? 0 : 1e-9;
+	}
+	double LatencyCol = 0;
+	for (double j=0; j<columnResistance.size(); j++){
+		double T_Col = 0;
+		T_Col = GetColumnLatency(columnResistance[j]);
+		LatencyCol = max(LatencyCol, T_Col);
+		if (LatencyCol < 1e-9) {
+			LatencyCol = 1e-9;
+		} else if (LatencyCol > 10e-9) {
+			LatencyCol = 10e-9;
+		}
+	}
+	return LatencyCol;
+}
+
 void MultilevelSenseAmp::PrintProperty(const char* str) {
 	FunctionUnit::PrintProperty(str);
 }
@@ -213,104 +303,28 @@ void MultilevelSenseAmp::PrintProperty(const char* str) {
 
 double MultilevelSenseAmp::GetColumnLatency(double columnRes) {
 	double Column_Latency = 0;
-	double up_bound = 3, mid_bound = 1.1, low_bound = 0.9;
-	double T_max = 0;
+	double low_bound = 0.9;
 	// in Cadence simulation, we fix Vread to 0.5V, with user-defined Vread (different from 0.5V)
 	// we should modify the equivalent columnRes
 	columnRes *= 0.5/param->readVoltage;
 	if (((double) 1/columnRes == 0) || (columnRes == 0)) {
 		Column_Latency = 0;
+	} else if (!latencyFit) {   // HP, or LP technode below and equal to 22nm
+		Column_Latency = 1e-9;
 	} else {
-		if (param->deviceroadmap == 1) {  // HP
-			Column_Latency = 1e-9;
-		} else {                         // LP
-			if (param->technode == 130) {
-				T_max = (0.2679*log(columnRes/1000)+0.0478)*1e-9;   // T_max = (0.2679*log(R_BL/1000)+0.0478)*10^-9;
-
-				for (int i=1; i<levelOutput-1; i++){
-					double ratio = Rref[i]/columnRes;
-					double T = 0;
-					if (ratio >= 20 || ratio <= 0.05) {
-						T = 1e-9;
-					} else {
-						if (ratio <= low_bound){
-							T = T_max * (3.915*pow(ratio,3)-5.3996*pow(ratio,2)+2.4653*ratio+0.3856);  // y = 3.915*x^3-5.3996*x^2+2.4653*x+0.3856;
-						} else if (mid_bound <= ratio <= up_bound){
-							T = T_max * (0.0004*pow(ratio,4)-0.0087*pow(ratio,3)+0.0742*pow(ratio,2)-0.2725*ratio+1.2211);  // y = 0.0004*x^4-0.0087*x^3+0.0742*x^2-0.2725*x+1.2211;
-						} else if (ratio>up_bound){
-							T = T_max * (0.0004*pow(ratio,4)-0.0087*pow(ratio,3)+0.0742*pow(ratio,2)-0.2725*ratio+1.2211);
-						} else {
-							T = T_max;
-						}
-					}
-					Column_Latency = max(Column_Latency, T);
-				}
-			} else if (param->technode == 90) {
-				T_max = (0.0586*log(columnRes/1000)+1.41)*1e-9;   // T_max = (0.0586*log(R_BL/1000)+1.41)*10^-9;
-
-				for (int i=1; i<levelOutput-1; i++){
-					double ratio = Rref[i]/columnRes;
-					double T = 0;
-					if (ratio >= 20 || ratio <= 0.05) {
-						T = 1e-9;
-					} else {
-						if (ratio <= low_bound){
-							T = T_max * (3.726*pow(ratio,3)-5.651*pow(ratio,2)+2.8249*ratio+0.3574);    // y = 3.726*x^3-5.651*x^2+2.8249*x+0.3574;
-						} else if (mid_bound <= ratio <= up_bound){
-							T = T_max * (0.0000008*pow(ratio,4)-0.00007*pow(ratio,3)+0.0017*pow(ratio,2)-0.0188*ratio+0.9835);  // y = 0.0000008*x^4-0.00007*x^3+0.0017*x^2-0.0188*x+0.9835;
-						} else if (ratio>up_bound){
-							T = T_max * (0.0000008*pow(ratio,4)-0.00007*pow(ratio,3)+0.0017*pow(ratio,2)-0.0188*ratio+0.9835);
-						} else {
-							T = T_max;
-						}
-					}
-					Column_Latency = max(Column_Latency, T);
-				}
-			} else if (param->technode == 65) {
-				T_max = (0.1239*log(columnRes/1000)+0.6642)*1e-9;   // T_max = (0.1239*log(R_BL/1000)+0.6642)*10^-9;
+		double T_max = (tMaxSlope*log(columnRes/1000)+tMaxOffset)*1e-9;
 
-				for (int i=1; i<levelOutput-1; i++){
-					double ratio = Rref[i]/columnRes;
-					double T = 0;
-					if (ratio >= 20 || ratio <= 0.05) {
-						T = 1e-9;
-					} else {
-						if (ratio <= low_bound){
-							T = T_max * (1.3899*pow(ratio,3)-2.6913*pow(ratio,2)+2.0483*ratio+0.3202);    // y = 1.3899*x^3-2.6913*x^2+2.0483*x+0.3202;
-						} else if (mid_bound <= ratio <= up_bound){
-							T = T_max * (0.0036*pow(ratio,4)-0.0363*pow(ratio,3)+0.1043*pow(ratio,2)-0.0346*ratio+1.0512);   // y = 0.0036*x^4-0.0363*x^3+0.1043*x^2-0.0346*x+1.0512;
-						} else if (ratio>up_bound){
-							T = T_max * (0.0036*pow(ratio,4)-0.0363*pow(ratio,3)+0.1043*pow(ratio,2)-0.0346*ratio+1.0512);
-						} else {
-							T = T_max;
-						}
-					}
-					Column_Latency = max(Column_Latency, T);
-				}
-			} else if (param->technode == 45 || param->technode == 32) {
-				T_max = (0.0714*log(columnRes/1000)+0.7651)*1e-9;    // T_max = (0.0714*log(R_BL/1000)+0.7651)*10^-9;
-
-				for (int i=1; i<levelOutput-1; i++){
-					double ratio = Rref[i]/columnRes;
-					double T = 0;
-					if (ratio >= 20 || ratio <= 0.05) {
-						T = 1e-9;
-					} else {
-						if (ratio <= low_bound){
-							T = T_max * (3.7949*pow(ratio,3)-5.6685*pow(ratio,2)+2.6492*ratio+0.4807);    // y = 3.7949*x^3-5.6685*x^2+2.6492*x+0.4807
-						} else if (mid_bound <= ratio <= up_bound){
-							T = T_max * (0.000001*pow(ratio,4)-0.00006*pow(ratio,3)+0.0001*pow(ratio,2)-0.0171*ratio+1.0057);   // 0.000001*x^4-0.00006*x^3+0.0001*x^2-0.0171*x+1.0057;
-						} else if (ratio>up_bound){
-							T = T_max * (0.000001*pow(ratio,4)-0.00006*pow(ratio,3)+0.0001*pow(ratio,2)-0.0171*ratio+1.0057);
-						} else {
-							T = T_max;
-						}
-					}
-					Column_Latency = max(Column_Latency, T);
-				}
-			} else {   // technode below and equal to 22nm
-				Column_Latency = 1e-9;
+		for (int i=1; i<levelOutput-1; i++){
+			double ratio = Rref[i]/columnRes;
+			double T = 0;
+			if (ratio >= 20 || ratio <= 0.05) {
+				T = 1e-9;
+			} else if (ratio <= low_bound) {
+				T = T_max * (latencyLow[3]*pow(ratio,3)+latencyLow[2]*pow(ratio,2)+latencyLow[1]*ratio+latencyLow[0]);
+			} else {   // the fits above mid_bound and up_bound are the same one (and the test of mid_bound was always true)
+				T = T_max * (latencyHigh[4]*pow(ratio,4)+latencyHigh[3]*pow(ratio,3)+latencyHigh[2]*pow(ratio,2)+latencyHigh[1]*ratio+latencyHigh[0]);
 			}
+			Column_Latency = max(Column_Latency, T);
 		}
 	}
 	return Column_Latency;
@@ -323,139 +337,13 @@ double MultilevelSenseAmp::GetColumnPower(double columnRes) {
 	// in Cadence simulation, we fix Vread to 0.5V, with user-defined Vread (different from 0.5V)
 	// we should modify the equivalent columnRes
 	columnRes *= 0.5/param->readVoltage;
-	if (currentMode) {
-		if ((double) 1/columnRes == 0) { 
-			Column_Power = 1e-6;
-		} else if (columnRes == 0) {
-			Column_Power = 0;
-		} else {
-			if (param->deviceroadmap == 1) {  // HP
-				if (param->technode == 130) {
-					Column_Power = 19.898*(levelOutput-1)*1e-6;
-					Column_Power += 0.17452*exp(-2.367*log10(columnRes));
-				} else if (param->technode == 90) {
-					Column_Power = 13.09*(levelOutput-1)*1e-6;
-					Column_Power += 0.14900*exp(-2.345*log10(columnRes));
-				} else if (param->technode == 65) {
-					Column_Power = 9.9579*(levelOutput-1)*1e-6;
-					Column_Power += 0.1083*exp(-2.321*log10(columnRes));
-				} else if (param->technode == 45) {
-					Column_Power = 7.7017*(levelOutput-1)*1e-6;
-					Column_Power += 0.0754*exp(-2.296*log10(columnRes));
-				} else if (param->technode == 32){  
-					Column_Power = 3.9648*(levelOutput-1)*1e-6;
-					Column_Power += 0.079*exp(-2.313*log10(columnRes));
-				} else if (param->technode == 22){   
-					Column_Power = 1.8939*(levelOutput-1)*1e-6;
-					Column_Power += 0.073*exp(-2.311*log10(columnRes));
-				} else if (param->technode == 14){  
-					Column_Power = 1.2*(levelOutput-1)*1e-6;
-					Column_Power += 0.0584*exp(-2.311*log10(columnRes));
-				} else if (param->technode == 10){  
-					Column_Power = 0.8*(levelOutput-1)*1e-6;
-					Column_Power += 0.0318*exp(-2.311*log10(columnRes));
-				} else {   // 7nm
-					Column_Power = 0.5*(levelOutput-1)*1e-6;
-					Column_Power += 0.0210*exp(-2.311*log10(columnRes));
-				}
-			} else {                         // LP
-				if (param->technode == 130) {
-					Column_Power = 18.09*(levelOutput-1)*1e-6;
-					Column_Power += 0.1380*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 90) {
-					Column_Power = 12.612*(levelOutput-1)*1e-6;
-					Column_Power += 0.1023*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 65) {
-					Column_Power = 8.4147*(levelOutput-1)*1e-6;
-					Column_Power += 0.0972*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 45) {
-					Column_Power = 6.3162*(levelOutput-1)*1e-6;
-					Column_Power += 0.075*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 32){  
-					Column_Power = 3.0875*(levelOutput-1)*1e-6;
-					Column_Power += 0.0649*exp(-2.297*log10(columnRes));
-				} else if (param->technode == 22){   
-					Column_Power = 1.7*(levelOutput-1)*1e-6;
-					Column_Power += 0.0631*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 14){   
-					Column_Power = 1.0*(levelOutput-1)*1e-6;
-					Column_Power += 0.0508*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 10){   
-					Column_Power = 0.55*(levelOutput-1)*1e-6;
-					Column_Power += 0.0315*exp(-2.303*log10(columnRes));
-				} else {   // 7nm
-					Column_Power = 0.35*(levelOutput-1)*1e-6;
-					Column_Power += 0.0235*exp(-2.303*log10(columnRes));
-				}
-			}
-		}
-		
+	if ((double) 1/columnRes == 0) { 
+		Column_Power = 1e-6;
+	} else if (columnRes == 0) {
+		Column_Power = 0;
 	} else {
-		if ((double) 1/columnRes == 0) { 
-			Column_Power = 1e-6;
-		} else if (columnRes == 0) {
-			Column_Power = 0;
-		} else {
-			if (param->deviceroadmap == 1) {  // HP
-				if (param->technode == 130) {
-					Column_Power = 27.84*(levelOutput-1)*1e-6;
-					Column_Power += 0.207452*exp(-2.367*log10(columnRes));
-				} else if (param->technode == 90) {
-					Column_Power = 22.2*(levelOutput-1)*1e-6;
-					Column_Power += 0.164900*exp(-2.345*log10(columnRes));
-				} else if (param->technode == 65) {
-					Column_Power = 13.058*(levelOutput-1)*1e-6;
-					Column_Power += 0.128483*exp(-2.321*log10(columnRes));
-				} else if (param->technode == 45) {
-					Column_Power = 8.162*(levelOutput-1)*1e-6;
-					Column_Power += 0.097754*exp(-2.296*log10(columnRes));
-				} else if (param->technode == 32){  
-					Column_Power = 4.76*(levelOutput-1)*1e-6;
-					Column_Power += 0.083709*exp(-2.313*log10(columnRes));
-				} else if (param->technode == 22){   
-					Column_Power = 2.373*(levelOutput-1)*1e-6;
-					Column_Power += 0.084273*exp(-2.311*log10(columnRes));
-				} else if (param->technode == 14){  
-					Column_Power = 1.467*(levelOutput-1)*1e-6;
-					Column_Power += 0.060584*exp(-2.311*log10(columnRes));
-				} else if (param->technode == 10){  
-					Column_Power = 0.9077*(levelOutput-1)*1e-6;
-					Column_Power += 0.049418*exp(-2.311*log10(columnRes));
-				} else {   // 7nm
-					Column_Power = 0.5614*(levelOutput-1)*1e-6;
-					Column_Power += 0.040310*exp(-2.311*log10(columnRes));
-				}
-			} else {                         // LP
-				if (param->technode == 130) {
-					Column_Power = 23.4*(levelOutput-1)*1e-6;
-					Column_Power += 0.169380*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 90) {
-					Column_Power = 14.42*(levelOutput-1)*1e-6;
-					Column_Power += 0.144323*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 65) {
-					Column_Power = 10.18*(levelOutput-1)*1e-6;
-					Column_Power += 0.121272*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 45) {
-					Column_Power = 7.062*(levelOutput-1)*1e-6;
-					Column_Power += 0.100225*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 32){  
-					Column_Power = 3.692*(levelOutput-1)*1e-6;
-					Column_Power += 0.079449*exp(-2.297*log10(columnRes));
-				} else if (param->technode == 22){   
-					Column_Power = 1.866*(levelOutput-1)*1e-6;
-					Column_Power += 0.072341*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 14){   
-					Column_Power = 1.126*(levelOutput-1)*1e-6;
-					Column_Power += 0.061085*exp(-2.303*log10(columnRes));
-				} else if (param->technode == 10){   
-					Column_Power = 0.6917*(levelOutput-1)*1e-6;
-					Column_Power += 0.051580*exp(-2.303*log10(columnRes));
-				} else {   // 7nm
-					Column_Power = 0.4211*(levelOutput-1)*1e-6;
-					Column_Power += 0.043555*exp(-2.303*log10(columnRes));
-				}
-			}
-		}
+		Column_Power = powerLevel;
+		Column_Power += powerCoeff*exp(powerExponent*log10(columnRes));
 	}
 	Column_Power *= (1+1.3e-3*(param->temp-300));
 	return Column_Power;
@@ -46,6 +46,7 @@
 #include "MemCell.h"
 #include "FunctionUnit.h"
 #include "CurrentSenseAmp.h"
+#include "ColumnTable.h"
 
 using namespace std;
 
@@ -64,7 +65,10 @@ public:
 	void CalculateLatency(const vector<double> &columnResistance, double numColMuxed, double numRead);
 	void CalculatePower(const vector<double> &columnResistance, double numRead);
 	double GetColumnLatency(double columnRes);
+	double GetSlowestColumnLatency(const vector<double> &columnResistance);
 	double GetColumnPower(double columnRes);
+	void InitializeColumnModel();
+	void SetLatencyFit(double slope, double offset, const double *low, const double *high);
 
 	/* Properties */
 	bool initialized;		/* Initialization flag */
@@ -80,6 +84,14 @@ public:
 	double clkFreq;
 	int numReadCellPerOperationNeuro;
 	vector<double> Rref;
+	
+	/* Column models of the technode, resolved at initialization */
+	bool latencyFit;				/* LP 130~32nm: latency from the Cadence fits, otherwise 1e-9 */
+	double tMaxSlope, tMaxOffset;	/* T_max = (tMaxSlope*log(R/1000)+tMaxOffset)*1e-9 */
+	double latencyLow[4];			/* T/T_max polynomial (by power of the ratio Rref/R) below low_bound */
+	double latencyHigh[5];			/* T/T_max polynomial above low_bound */
+	double powerLevel, powerCoeff, powerExponent;	/* P = powerLevel + powerCoeff*exp(powerExponent*log10(R)) */
+	ColumnTable powerTable;			/* GetColumnPower tabulated when param->columnTable */
 
 	CurrentSenseAmp currentSenseAmp;
 };
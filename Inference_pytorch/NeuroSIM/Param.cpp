@@ -116,6 +116,16 @@ Param::Param() {
 	algoWeightMax = 1;
 	algoWeightMin = -1;
 	
+	/*** simulator memory options ***/
+	inputWindowSize = 0;                // # of input vectors held in memory per subArray at a time, the input trace is then streamed from a mapped file
+										// 0: load the whole input trace of the layer in memory
+	subArrayCache = true;               // reuse the subArray results of an input vector that repeats an earlier one on the same subArray (exact)
+	subArrayCacheSize = 4096;           // max # of distinct input vectors remembered per subArray, the least recently used are dropped
+	layerParallel = false;              // evaluate the layers of the performance pass concurrently, each on its own copy of the modules (more memory)
+	columnTable = false;                // evaluate the MLSA/SAR ADC column power from a log-spaced table built at initialization
+	columnTableError = 1e-6;            // max relative error of that table against the analytic model (checked at every table segment)
+	traceChecksum = true;               // verify the payload CRC-32 of binary traces when they are opened (reads a streamed input trace once up front)
+	
 	/*** conventional hardware design options ***/
 	clkFreq = 1e9;                      // Clock frequency
 	temp = 300;                         // Temperature (K)
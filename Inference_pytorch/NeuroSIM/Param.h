@@ -63,6 +63,13 @@ public:
 	double globalBusDelayTolerance, localBusDelayTolerance;
 	double treeFoldedRatio, maxGlobalBusWidth;
 	double algoWeightMax, algoWeightMin;
+	int inputWindowSize;
+	bool subArrayCache;
+	int subArrayCacheSize;
+	bool layerParallel;
+	bool columnTable;
+	double columnTableError;
+	bool traceChecksum;
 	
 	int neuro, multifunctional, parallelWrite, parallelRead;
 	int numlut, numColMuxed, numWriteColMuxed, levelOutput, avgWeightBit, numBitInput;
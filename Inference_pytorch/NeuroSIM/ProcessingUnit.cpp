@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include <vector>
 #include <sstream>
+#include <functional>
+#include <omp.h>
 #include "Bus.h"
 #include "SubArray.h"
 #include "constant.h"
@@ -52,24 +54,22 @@
 #include "AdderTree.h"
 #include "Bus.h"
 #include "DFF.h"
+#include "ConductanceTable.h"
+#include "ColumnSum.h"
+#include "SubArrayCache.h"
+#include "SimContext.h"
 
 using namespace std;
 
 extern Param *param;
 
-AdderTree *adderTreeNM;
-Bus *busInputNM;
-Bus *busOutputNM;
-DFF *bufferInputNM;
-DFF *bufferOutputNM;
+static ColumnResistanceFunction SelectColumnResistance(MemCell& cell);
 
-AdderTree *adderTreeCM;
-Bus *busInputCM;
-Bus *busOutputCM;
-DFF *bufferInputCM;
-DFF *bufferOutputCM;
-
-void ProcessingUnitInitialize(SubArray *& subArray, InputParameter& inputParameter, Technology& tech, MemCell& cell, int _numSubArrayRowNM, int _numSubArrayColNM, int _numSubArrayRowCM, int _numSubArrayColCM) {
+void ProcessingUnitInitialize(SimContext &ctx, int _numSubArrayRowNM, int _numSubArrayColNM, int _numSubArrayRowCM, int _numSubArrayColCM) {
+	InputParameter& inputParameter = ctx.inputParameter;
+	Technology& tech = ctx.tech;
+	MemCell& cell = ctx.cell;
+	SubArray *subArray = ctx.subArrayInPE;
 
 	/*** circuit level parameters ***/
 	switch(param->memcelltype) {
@@ -103,22 +103,16 @@ void ProcessingUnitInitialize(SubArray *& subArray, InputParameter& inputParamet
 		default:	exit(-1);
 	}
 	
-	subArray = new SubArray(inputParameter, tech, cell);
-	adderTreeNM = new AdderTree(inputParameter, tech, cell);
-	busInputNM = new Bus(inputParameter, tech, cell);
-	busOutputNM = new Bus(inputParameter, tech, cell);
-	bufferInputNM = new DFF(inputParameter, tech, cell);
-	bufferOutputNM = new DFF(inputParameter, tech, cell);
-	adderTreeCM = new AdderTree(inputParameter, tech, cell);
-	busInputCM = new Bus(inputParameter, tech, cell);
-	busOutputCM = new Bus(inputParameter, tech, cell);
-	bufferInputCM = new DFF(inputParameter, tech, cell);
-	bufferOutputCM = new DFF(inputParameter, tech, cell);
 		
 	/* Create SubArray object and link the required global objects (not initialization) */
 	inputParameter.temperature = param->temp;   // Temperature (K)
 	inputParameter.processNode = param->technode;    // Technology node
-	tech.Initialize(inputParameter.processNode, inputParameter.deviceRoadmap, inputParameter.transistorType);
+	if (!tech.Initialize(inputParameter.processNode, inputParameter.deviceRoadmap, inputParameter.transistorType)) {
+		exit(-1);
+	}
+	if (inputParameter.temperature < 300 || inputParameter.temperature > 400) {
+		cout << "Warning: temperature " << inputParameter.temperature << "K is outside the 300K~400K of the device tables, the transistor currents are clamped" << endl;
+	}
 	
 	cell.resistanceOn = param->resistanceOn;	                                // Ron resistance at Vr in the reported measurement data (need to recalculate below if considering the nonlinearity)
 	cell.resistanceOff = param->resistanceOff;	                                // Roff resistance at Vr in the reported measurement dat (need to recalculate below if considering the nonlinearity)
@@ -127,6 +121,8 @@ void ProcessingUnitInitialize(SubArray *& subArray, InputParameter& inputParamet
 	cell.readPulseWidth = param->readPulseWidth;
 	cell.accessVoltage = param->accessVoltage;                                       // Gate voltage for the transistor in 1T1R
 	cell.resistanceAccess = param->resistanceAccess;
+	ctx.conductanceTable.Initialize(cell, param->numRowSubArray, param->numColSubArray);
+	ctx.columnResistanceKernel = SelectColumnResistance(cell);
 	cell.featureSize = param->featuresize; 
 	cell.writeVoltage = param->writeVoltage;
 
@@ -187,40 +183,41 @@ void ProcessingUnitInitialize(SubArray *& subArray, InputParameter& inputParamet
 	subArray->CalculateArea();
 	if (param->novelMapping) {
 		if (param->parallelRead) {
-			adderTreeNM->Initialize(numSubArrayRowNM, log2((double)param->levelOutput)+param->numBitInput+1, ceil((double)numSubArrayColNM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
+			ctx.adderTreeNM->Initialize(numSubArrayRowNM, log2((double)param->levelOutput)+param->numBitInput+1, ceil((double)numSubArrayColNM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
 		} else {
-			adderTreeNM->Initialize(numSubArrayRowNM, (log2((double)numRow)+param->cellBit-1)+param->numBitInput+1, ceil((double)numSubArrayColNM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
+			ctx.adderTreeNM->Initialize(numSubArrayRowNM, (log2((double)numRow)+param->cellBit-1)+param->numBitInput+1, ceil((double)numSubArrayColNM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
 		}
 		
-		bufferInputNM->Initialize(param->numBitInput*numRow, param->clkFreq);
+		ctx.bufferInputNM->Initialize(param->numBitInput*numRow, param->clkFreq);
 		if (param->parallelRead) {
-			bufferOutputNM->Initialize((numCol/param->numColMuxed)*(log2((double)param->levelOutput)+param->numBitInput+adderTreeNM->numStage), param->clkFreq);
+			ctx.bufferOutputNM->Initialize((numCol/param->numColMuxed)*(log2((double)param->levelOutput)+param->numBitInput+ctx.adderTreeNM->numStage), param->clkFreq);
 		} else {
-			bufferOutputNM->Initialize((numCol/param->numColMuxed)*((log2((double)numRow)+param->cellBit-1)+param->numBitInput+adderTreeNM->numStage), param->clkFreq);
+			ctx.bufferOutputNM->Initialize((numCol/param->numColMuxed)*((log2((double)numRow)+param->cellBit-1)+param->numBitInput+ctx.adderTreeNM->numStage), param->clkFreq);
 		}
 		
-		busInputNM->Initialize(HORIZONTAL, numSubArrayRowNM, numSubArrayColNM, 0, numRow, subArray->height, subArray->width, param->clkFreq);
-		busOutputNM->Initialize(VERTICAL, numSubArrayRowNM, numSubArrayColNM, 0, numCol, subArray->height, subArray->width, param->clkFreq);
+		ctx.busInputNM->Initialize(HORIZONTAL, numSubArrayRowNM, numSubArrayColNM, 0, numRow, subArray->height, subArray->width, param->clkFreq);
+		ctx.busOutputNM->Initialize(VERTICAL, numSubArrayRowNM, numSubArrayColNM, 0, numCol, subArray->height, subArray->width, param->clkFreq);
 	}
 	if (param->parallelRead) {
-		adderTreeCM->Initialize(numSubArrayRowCM, log2((double)param->levelOutput)+param->numBitInput+1, ceil((double)numSubArrayColCM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
+		ctx.adderTreeCM->Initialize(numSubArrayRowCM, log2((double)param->levelOutput)+param->numBitInput+1, ceil((double)numSubArrayColCM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
 	} else {
-		adderTreeCM->Initialize(numSubArrayRowCM, (log2((double)numRow)+param->cellBit-1)+param->numBitInput+1, ceil((double)numSubArrayColCM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
+		ctx.adderTreeCM->Initialize(numSubArrayRowCM, (log2((double)numRow)+param->cellBit-1)+param->numBitInput+1, ceil((double)numSubArrayColCM*(double)numCol/(double)param->numColMuxed), param->clkFreq);
 	}
 	
-	bufferInputCM->Initialize(param->numBitInput*numRow, param->clkFreq);
+	ctx.bufferInputCM->Initialize(param->numBitInput*numRow, param->clkFreq);
 	if (param->parallelRead) {
-		bufferOutputCM->Initialize((numCol/param->numColMuxed)*(log2((double)param->levelOutput)+param->numBitInput+adderTreeCM->numStage), param->clkFreq);
+		ctx.bufferOutputCM->Initialize((numCol/param->numColMuxed)*(log2((double)param->levelOutput)+param->numBitInput+ctx.adderTreeCM->numStage), param->clkFreq);
 	} else {
-		bufferOutputCM->Initialize((numCol/param->numColMuxed)*((log2((double)numRow)+param->cellBit-1)+param->numBitInput+adderTreeCM->numStage), param->clkFreq);
+		ctx.bufferOutputCM->Initialize((numCol/param->numColMuxed)*((log2((double)numRow)+param->cellBit-1)+param->numBitInput+ctx.adderTreeCM->numStage), param->clkFreq);
 	}
 	
-	busInputCM->Initialize(HORIZONTAL, numSubArrayRowCM, numSubArrayColCM, 0, numRow, subArray->height, subArray->width, param->clkFreq);
-	busOutputCM->Initialize(VERTICAL, numSubArrayRowCM, numSubArrayColCM, 0, numCol, subArray->height, subArray->width, param->clkFreq);	
+	ctx.busInputCM->Initialize(HORIZONTAL, numSubArrayRowCM, numSubArrayColCM, 0, numRow, subArray->height, subArray->width, param->clkFreq);
+	ctx.busOutputCM->Initialize(VERTICAL, numSubArrayRowCM, numSubArrayColCM, 0, numCol, subArray->height, subArray->width, param->clkFreq);	
 }
 
 
-vector<double> ProcessingUnitCalculateArea(SubArray *subArray, int numSubArrayRow, int numSubArrayCol, bool NMpe, double *height, double *width, double *bufferArea) {
+vector<double> ProcessingUnitCalculateArea(SimContext &ctx, int numSubArrayRow, int numSubArrayCol, bool NMpe, double *height, double *width, double *bufferArea) {
+	SubArray *subArray = ctx.subArrayInPE;
 	vector<double> areaResults;
 	*height = 0;
 	*width = 0;
@@ -229,38 +226,38 @@ vector<double> ProcessingUnitCalculateArea(SubArray *subArray, int numSubArrayRo
 	
 	subArray->CalculateArea();
 	if (NMpe) {
-		adderTreeNM->CalculateArea(NULL, subArray->width, NONE);
-		bufferInputNM->CalculateArea(numSubArrayRow*subArray->height, NULL, NONE);
-		bufferOutputNM->CalculateArea(NULL, numSubArrayCol*subArray->width, NONE);
+		ctx.adderTreeNM->CalculateArea(NULL, subArray->width, NONE);
+		ctx.bufferInputNM->CalculateArea(numSubArrayRow*subArray->height, NULL, NONE);
+		ctx.bufferOutputNM->CalculateArea(NULL, numSubArrayCol*subArray->width, NONE);
 		
-		busInputNM->CalculateArea(1, true); 
-		busOutputNM->CalculateArea(1, true);	
-		area += subArray->usedArea * (numSubArrayRow*numSubArrayCol) + adderTreeNM->area + bufferInputNM->area + bufferOutputNM->area;
+		ctx.busInputNM->CalculateArea(1, true); 
+		ctx.busOutputNM->CalculateArea(1, true);	
+		area += subArray->usedArea * (numSubArrayRow*numSubArrayCol) + ctx.adderTreeNM->area + ctx.bufferInputNM->area + ctx.bufferOutputNM->area;
 
 		*height = sqrt(area);
 		*width = area/(*height);
 		
 		areaResults.push_back(area);
 		areaResults.push_back(subArray->areaADC*(numSubArrayRow*numSubArrayCol));
-		areaResults.push_back(subArray->areaAccum*(numSubArrayRow*numSubArrayCol)+adderTreeNM->area);
-		areaResults.push_back(subArray->areaOther*(numSubArrayRow*numSubArrayCol)+ bufferInputNM->area + bufferOutputNM->area);
+		areaResults.push_back(subArray->areaAccum*(numSubArrayRow*numSubArrayCol)+ctx.adderTreeNM->area);
+		areaResults.push_back(subArray->areaOther*(numSubArrayRow*numSubArrayCol)+ ctx.bufferInputNM->area + ctx.bufferOutputNM->area);
 		areaResults.push_back(subArray->areaArray*(numSubArrayRow*numSubArrayCol));
 	} else {
-		adderTreeCM->CalculateArea(NULL, subArray->width, NONE);
-		bufferInputCM->CalculateArea(numSubArrayRow*subArray->height, NULL, NONE);
-		bufferOutputCM->CalculateArea(NULL, numSubArrayCol*subArray->width, NONE);
+		ctx.adderTreeCM->CalculateArea(NULL, subArray->width, NONE);
+		ctx.bufferInputCM->CalculateArea(numSubArrayRow*subArray->height, NULL, NONE);
+		ctx.bufferOutputCM->CalculateArea(NULL, numSubArrayCol*subArray->width, NONE);
 	
-		busInputCM->CalculateArea(1, true); 
-		busOutputCM->CalculateArea(1, true);	
-		area += subArray->usedArea * (numSubArrayRow*numSubArrayCol) + adderTreeCM->area + bufferInputCM->area + bufferOutputCM->area;
+		ctx.busInputCM->CalculateArea(1, true); 
+		ctx.busOutputCM->CalculateArea(1, true);	
+		area += subArray->usedArea * (numSubArrayRow*numSubArrayCol) + ctx.adderTreeCM->area + ctx.bufferInputCM->area + ctx.bufferOutputCM->area;
 		
 		*height = sqrt(area);
 		*width = area/(*height);
 		
 		areaResults.push_back(area);
 		areaResults.push_back(subArray->areaADC*(numSubArrayRow*numSubArrayCol));
-		areaResults.push_back(subArray->areaAccum*(numSubArrayRow*numSubArrayCol)+adderTreeCM->area);
-		areaResults.push_back(subArray->areaOther*(numSubArrayRow*numSubArrayCol)+ bufferInputCM->area + bufferOutputCM->area);
+		areaResults.push_back(subArray->areaAccum*(numSubArrayRow*numSubArrayCol)+ctx.adderTreeCM->area);
+		areaResults.push_back(subArray->areaOther*(numSubArrayRow*numSubArrayCol)+ ctx.bufferInputCM->area + ctx.bufferOutputCM->area);
 		areaResults.push_back(subArray->areaArray*(numSubArrayRow*numSubArrayCol));
 	}
 	
@@ -268,13 +265,112 @@ vector<double> ProcessingUnitCalculateArea(SubArray *subArray, int numSubArrayRo
 }
 
 
-double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vector<double> > &newMemory, const vector<vector<double> > &oldMemory, 
-											const vector<vector<double> > &inputVector,
+// run one input vector through the subArray and read back its results
+static void CalculateSubArrayVector(const SimContext &ctx, SubArray *subArray, const uint64_t *input, double activityRowRead, const CellConductance &cellConductance,
+									SubArrayResult *result) {
+	vector<double> columnResistance(cellConductance.numCol);
+	GetColumnResistance(ctx, input, cellConductance, columnResistance.data());
+	
+	subArray->Evaluate(columnResistance, activityRowRead);
+	result->readLatency = subArray->readLatency;
+	result->sensingLatency = subArray->sensingLatency;
+	result->readLatencyADC = subArray->readLatencyADC;
+	result->readLatencyAccum = subArray->readLatencyAccum;
+	result->readLatencyOther = subArray->readLatencyOther;
+	result->readDynamicEnergy = subArray->readDynamicEnergy;
+	result->readDynamicEnergyADC = subArray->readDynamicEnergyADC;
+	result->readDynamicEnergyAccum = subArray->readDynamicEnergyAccum;
+	result->readDynamicEnergyOther = subArray->readDynamicEnergyOther;
+	result->leakage = subArray->leakage;
+}
+
+
+// run all input vectors of one subArray (subArray->Prepare() done), accumulate is called on the results of each vector in order
+// The vectors go in batches of one input window, so only a batch of results is held at a time. A vector seen before on this
+// subArray gives the same results, so only the first of each distinct vector is evaluated. Those of a batch are split among
+// the threads in chunks, each thread on its own copy of the prepared subArray. The last vector is always evaluated on
+// subArray itself at the end, so that it is left in the same state as after the serial loop.
+static void CalculateSubArrayVectors(const SimContext &ctx, SubArray *subArray, InputWindow &subArrayInput, const CellConductance &cellConductance,
+									int numInVector, const function<void(const SubArrayResult &)> &accumulate) {
+	const int chunk = 16;		// input vectors per work item
+	const int batchSize = (param->inputWindowSize > 0)? param->inputWindowSize : 1024;
+	
+	// the window slides, so the bits of the vectors to evaluate are copied out
+	int numWord = (cellConductance.numRow+63)/64;
+	SubArrayCache subArrayCache(cellConductance.numRow, param->subArrayCacheSize);
+	vector<SubArrayResult> result(min(batchSize, max(numInVector, 0)));
+	vector<int> source;		// vector of the batch whose results vector b takes
+	vector<int> pending;
+	vector<uint64_t> pendingInput;
+	vector<double> pendingActivity;
+	for (int first=0; first<numInVector; first+=batchSize) {
+		int numBatch = min(batchSize, numInVector-first);
+		bool lastBatch = (first+numBatch == numInVector);
+		source.resize(numBatch);
+		pending.clear();
+		pendingInput.clear();
+		pendingActivity.clear();
+		for (int b=0; b<numBatch; b++) {
+			int k = first+b;
+			double activityRowRead = 0;
+			int column = subArrayInput.Seek(k);
+			const uint64_t *input = GetInputVector(subArrayInput.window, column, &activityRowRead);
+			const SubArrayCache::Entry *entry = (param->subArrayCache && k < numInVector-1)? subArrayCache.Find(input) : NULL;
+			source[b] = b;
+			if (entry && entry->pending >= 0) {
+				source[b] = entry->pending;
+			} else if (entry) {
+				result[b] = entry->result;		// evaluated in an earlier batch
+			} else {
+				if (param->subArrayCache) {
+					subArrayCache.Insert(input, b);
+				}
+				pending.push_back(b);
+				pendingInput.insert(pendingInput.end(), input, input+numWord);
+				pendingActivity.push_back(activityRowRead);
+			}
+		}
+		
+		int numPending = pending.size();
+		int numParallel = lastBatch? numPending-1 : numPending;
+		#pragma omp parallel if (numParallel > 2*chunk)
+		{
+			SubArray *worker = (omp_get_num_threads() > 1)? NULL : subArray;
+			#pragma omp for schedule(dynamic, chunk)
+			for (int p=0; p<numParallel; p++) {
+				if (!worker) {
+					worker = new SubArray(*subArray);
+				}
+				CalculateSubArrayVector(ctx, worker, &pendingInput[(size_t)p*numWord], pendingActivity[p], cellConductance, &result[pending[p]]);
+			}
+			if (worker != subArray) {
+				delete worker;
+			}
+		}
+		if (lastBatch) {
+			CalculateSubArrayVector(ctx, subArray, &pendingInput[(size_t)(numPending-1)*numWord], pendingActivity[numPending-1], cellConductance, &result[numBatch-1]);
+		}
+		
+		if (param->subArrayCache) {
+			for (int p=0; p<numPending; p++) {
+				subArrayCache.Store(&pendingInput[(size_t)p*numWord], result[pending[p]]);
+			}
+		}
+		for (int b=0; b<numBatch; b++) {
+			accumulate(result[source[b]]);
+		}
+	}
+}
+
+
+void ProcessingUnitCalculatePerformance(SimContext &ctx, const MatrixView &newMemory, const MatrixView &oldMemory, 
+											const InputStream &inputStream, const MatrixView &inputRow,
 											int arrayDupRow, int arrayDupCol, int numSubArrayRow, int numSubArrayCol, int weightMatrixRow,
-											int weightMatrixCol, int numInVector, MemCell& cell, bool NMpe, double *readLatency, double *readDynamicEnergy, double *leakage, 
+											int weightMatrixCol, int numInVector, bool NMpe, double *readLatency, double *readDynamicEnergy, double *leakage, 
 											double *bufferLatency, double *bufferDynamicEnergy, double *icLatency, double *icDynamicEnergy,
 											double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, 
-											double *coreEnergyAccum, double *coreEnergyOther, bool CalculateclkFreq, double *clkPeriod) {
+											double *coreEnergyAccum, double *coreEnergyOther, double *clkPeriod) {
+	SubArray *subArray = ctx.subArrayInPE;
 	
 	/*** define how many subArray are used to map the whole layer ***/
 	*readLatency = 0;
@@ -292,6 +388,7 @@ double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vecto
 	*coreLatencyOther = 0;
 	
 	double subArrayReadLatency, subArrayReadDynamicEnergy, subArrayLeakage, subArrayLatencyADC, subArrayLatencyAccum, subArrayLatencyOther;
+	subArray->Prepare();	// peripheries that do not depend on the input vectors, once per layer
 
 	if (arrayDupRow*arrayDupCol > 1) {
 		// weight matrix is duplicated among subArray
@@ -305,70 +402,51 @@ double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vecto
 					
 					if ((i*param->numRowSubArray < weightMatrixRow) && (j*param->numColSubArray < weightMatrixCol) && (i*param->numRowSubArray < weightMatrixRow) ) {
 						// assign weight and input to specific subArray
-						vector<vector<double> > subArrayMemory;
-						subArrayMemory = CopySubArray(newMemory, i*param->numRowSubArray, j*param->numColSubArray, numRowMatrix, numColMatrix);
-						vector<vector<double> > subArrayInput;
-						subArrayInput = CopySubInput(inputVector, i*param->numRowSubArray, numInVector, numRowMatrix);
-						
+						MatrixView subArrayMemory = newMemory.Sub(i*param->numRowSubArray, j*param->numColSubArray, numRowMatrix, numColMatrix);
+						MatrixView subArrayInputRow = inputRow.Sub(i*param->numRowSubArray, 0, numRowMatrix, 0);
+						InputWindow subArrayInput(inputStream, subArrayInputRow, numInVector);
+						CellConductance subArrayConductance;
+						GetCellConductance(ctx, subArrayMemory, subArray->resCellAccess, &subArrayConductance);
 						subArrayReadLatency = 0;
 						subArrayLatencyADC = 0;
 						subArrayLatencyAccum = 0;
 						subArrayLatencyOther = 0;
-
-						for (int k=0; k<numInVector; k++) {                 // calculate single subArray through the total input vectors
-							double activityRowRead = 0;
-							vector<double> input; 
-							input = GetInputVector(subArrayInput, k, &activityRowRead);
-							subArray->activityRowRead = activityRowRead;
-							
-							int cellRange = pow(2, param->cellBit);
-							if (param->parallelRead) {
-								subArray->levelOutput = param->levelOutput;               // # of levels of the multilevelSenseAmp output
-							} else {
-								subArray->levelOutput = cellRange;
+						
+						CalculateSubArrayVectors(ctx, subArray, subArrayInput, subArrayConductance, numInVector, [&](const SubArrayResult &result) {                 // calculate single subArray through the total input vectors
+							if(*clkPeriod < result.sensingLatency){
+								*clkPeriod = result.sensingLatency;				//clk freq is decided by the longest sensing latency
 							}
+
+							*readDynamicEnergy += result.readDynamicEnergy;
+							subArrayLeakage = result.leakage;
 							
-							vector<double> columnResistance;
-							columnResistance = GetColumnResistance(input, subArrayMemory, cell, param->parallelRead, subArray->resCellAccess);
-							
-							subArray->CalculateLatency(1e20, columnResistance, CalculateclkFreq);
-							if(CalculateclkFreq && (*clkPeriod < subArray->readLatency)){
-								*clkPeriod = subArray->readLatency;					//clk freq is decided by the longest sensing latency
-							}							
+							subArrayLatencyADC += result.readLatencyADC;			//sensing cycle
+							subArrayLatencyAccum += result.readLatencyAccum;		//#cycles
+							subArrayReadLatency += result.readLatency;		//#cycles + sensing cycle
+							subArrayLatencyOther += result.readLatencyOther;
 							
-							if(!CalculateclkFreq){
-								subArray->CalculatePower(columnResistance);
-								*readDynamicEnergy += subArray->readDynamicEnergy;
-								subArrayLeakage = subArray->leakage;
-
-								subArrayLatencyADC += subArray->readLatencyADC;			//sensing cycle
-								subArrayLatencyAccum += subArray->readLatencyAccum;		//#cycles
-								subArrayReadLatency += subArray->readLatency;		//#cycles + sensing cycle
-								subArrayLatencyOther += subArray->readLatencyOther;		
-								
-								*coreEnergyADC += subArray->readDynamicEnergyADC;
-								*coreEnergyAccum += subArray->readDynamicEnergyAccum;
-								*coreEnergyOther += subArray->readDynamicEnergyOther;
-							}
-						}
+							*coreEnergyADC += result.readDynamicEnergyADC;
+							*coreEnergyAccum += result.readDynamicEnergyAccum;
+							*coreEnergyOther += result.readDynamicEnergyOther;
+						});
 						if (NMpe) {
-							adderTreeNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
-							adderTreeNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
-							*readLatency = MAX(subArrayReadLatency + adderTreeNM->readLatency, (*readLatency));
-							*readDynamicEnergy += adderTreeNM->readDynamicEnergy;
+							ctx.adderTreeNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
+							ctx.adderTreeNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
+							*readLatency = MAX(subArrayReadLatency + ctx.adderTreeNM->readLatency, (*readLatency));
+							*readDynamicEnergy += ctx.adderTreeNM->readDynamicEnergy;
 							*coreLatencyADC = MAX(subArrayLatencyADC, (*coreLatencyADC));
-							*coreLatencyAccum = MAX(subArrayLatencyAccum + adderTreeNM->readLatency, (*coreLatencyAccum));
+							*coreLatencyAccum = MAX(subArrayLatencyAccum + ctx.adderTreeNM->readLatency, (*coreLatencyAccum));
 							*coreLatencyOther = MAX(subArrayLatencyOther, (*coreLatencyOther));
-							*coreEnergyAccum += adderTreeNM->readDynamicEnergy;
+							*coreEnergyAccum += ctx.adderTreeNM->readDynamicEnergy;
 						} else {
-							adderTreeCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
-							adderTreeCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
-							*readLatency = MAX(subArrayReadLatency + adderTreeCM->readLatency, (*readLatency));
-							*readDynamicEnergy += adderTreeCM->readDynamicEnergy;
+							ctx.adderTreeCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
+							ctx.adderTreeCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
+							*readLatency = MAX(subArrayReadLatency + ctx.adderTreeCM->readLatency, (*readLatency));
+							*readDynamicEnergy += ctx.adderTreeCM->readDynamicEnergy;
 							*coreLatencyADC = MAX(subArrayLatencyADC, (*coreLatencyADC));
-							*coreLatencyAccum = MAX(subArrayLatencyAccum + adderTreeCM->readLatency, (*coreLatencyAccum));
+							*coreLatencyAccum = MAX(subArrayLatencyAccum + ctx.adderTreeCM->readLatency, (*coreLatencyAccum));
 							*coreLatencyOther = MAX(subArrayLatencyOther, (*coreLatencyOther));
-							*coreEnergyAccum += adderTreeCM->readDynamicEnergy;
+							*coreEnergyAccum += ctx.adderTreeCM->readDynamicEnergy;
 						}
 					}
 				}
@@ -380,52 +458,33 @@ double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vecto
 			*coreLatencyOther = (*coreLatencyOther)/(arrayDupRow*arrayDupCol);
 		} else {
 			// assign weight and input to specific subArray
-			vector<vector<double> > subArrayMemory;
-			subArrayMemory = CopySubArray(newMemory, 0, 0, weightMatrixRow, weightMatrixCol);
-			vector<vector<double> > subArrayInput;
-			subArrayInput = CopySubInput(inputVector, 0, numInVector, weightMatrixRow);
-
+			MatrixView subArrayMemory = newMemory.Sub(0, 0, weightMatrixRow, weightMatrixCol);
+			MatrixView subArrayInputRow = inputRow.Sub(0, 0, weightMatrixRow, 0);
+			InputWindow subArrayInput(inputStream, subArrayInputRow, numInVector);
+			CellConductance subArrayConductance;
+			GetCellConductance(ctx, subArrayMemory, subArray->resCellAccess, &subArrayConductance);
 			subArrayReadLatency = 0;
 			subArrayLatencyADC = 0;
 			subArrayLatencyAccum = 0;
 			subArrayLatencyOther = 0;
-
-			for (int k=0; k<numInVector; k++) {                 // calculate single subArray through the total input vectors
-				double activityRowRead = 0;
-				vector<double> input;
-				input = GetInputVector(subArrayInput, k, &activityRowRead);
-				subArray->activityRowRead = activityRowRead;
-				int cellRange = pow(2, param->cellBit);
-				
-				if (param->parallelRead) {
-					subArray->levelOutput = param->levelOutput;               // # of levels of the multilevelSenseAmp output
-				} else {
-					subArray->levelOutput = cellRange;
+			
+			CalculateSubArrayVectors(ctx, subArray, subArrayInput, subArrayConductance, numInVector, [&](const SubArrayResult &result) {                 // calculate single subArray through the total input vectors
+				if(*clkPeriod < result.sensingLatency){
+					*clkPeriod = result.sensingLatency;				//clk freq is decided by the longest sensing latency
 				}
+
+				*readDynamicEnergy += result.readDynamicEnergy;
+				subArrayLeakage = result.leakage;
 				
-				vector<double> columnResistance;
-				columnResistance = GetColumnResistance(input, subArrayMemory, cell, param->parallelRead, subArray->resCellAccess);
+				subArrayLatencyADC += result.readLatencyADC;			//sensing cycle
+				subArrayLatencyAccum += result.readLatencyAccum;		//#cycles
+				subArrayReadLatency += result.readLatency;		//#cycles + sensing cycle
+				subArrayLatencyOther += result.readLatencyOther;
 				
-				subArray->CalculateLatency(1e20, columnResistance, CalculateclkFreq);
-				if(CalculateclkFreq && (*clkPeriod < subArray->readLatency)){
-					*clkPeriod = subArray->readLatency;					//clk freq is decided by the longest sensing latency
-				}
-				
-				if(!CalculateclkFreq){
-					subArray->CalculatePower(columnResistance);
-					*readDynamicEnergy += subArray->readDynamicEnergy;
-					subArrayLeakage = subArray->leakage;
-					
-					subArrayLatencyADC += subArray->readLatencyADC;			//sensing cycle
-					subArrayLatencyAccum += subArray->readLatencyAccum;		//#cycles
-					subArrayReadLatency += subArray->readLatency;		//#cycles + sensing cycle
-					subArrayLatencyOther += subArray->readLatencyOther;
-					
-					*coreEnergyADC += subArray->readDynamicEnergyADC;
-					*coreEnergyAccum += subArray->readDynamicEnergyAccum;
-					*coreEnergyOther += subArray->readDynamicEnergyOther;
-				}
-			}
+				*coreEnergyADC += result.readDynamicEnergyADC;
+				*coreEnergyAccum += result.readDynamicEnergyAccum;
+				*coreEnergyOther += result.readDynamicEnergyOther;
+			});
 			
 			// do not pass adderTree 
 			*readLatency = subArrayReadLatency/(arrayDupRow*arrayDupCol);
@@ -441,52 +500,33 @@ double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vecto
 					int numRowMatrix = min(param->numRowSubArray, weightMatrixRow-i*param->numRowSubArray);
 					int numColMatrix = min(param->numColSubArray, weightMatrixCol-j*param->numColSubArray);
 					// assign weight and input to specific subArray
-					vector<vector<double> > subArrayMemory;
-					subArrayMemory = CopySubArray(newMemory, i*param->numRowSubArray, j*param->numColSubArray, numRowMatrix, numColMatrix);
-					vector<vector<double> > subArrayInput;
-					subArrayInput = CopySubInput(inputVector, i*param->numRowSubArray, numInVector, numRowMatrix);
-					
+					MatrixView subArrayMemory = newMemory.Sub(i*param->numRowSubArray, j*param->numColSubArray, numRowMatrix, numColMatrix);
+					MatrixView subArrayInputRow = inputRow.Sub(i*param->numRowSubArray, 0, numRowMatrix, 0);
+					InputWindow subArrayInput(inputStream, subArrayInputRow, numInVector);
+					CellConductance subArrayConductance;
+					GetCellConductance(ctx, subArrayMemory, subArray->resCellAccess, &subArrayConductance);
 					subArrayReadLatency = 0;
 					subArrayLatencyADC = 0;
 					subArrayLatencyAccum = 0;
 					subArrayLatencyOther = 0;
 					
-					for (int k=0; k<numInVector; k++) {                 // calculate single subArray through the total input vectors
-						double activityRowRead = 0;
-						vector<double> input;
-						input = GetInputVector(subArrayInput, k, &activityRowRead);
-						subArray->activityRowRead = activityRowRead;
-						
-						int cellRange = pow(2, param->cellBit);
-						if (param->parallelRead) {
-							subArray->levelOutput = param->levelOutput;               // # of levels of the multilevelSenseAmp output
-						} else {
-							subArray->levelOutput = cellRange;
+					CalculateSubArrayVectors(ctx, subArray, subArrayInput, subArrayConductance, numInVector, [&](const SubArrayResult &result) {                 // calculate single subArray through the total input vectors
+						if(*clkPeriod < result.sensingLatency){
+							*clkPeriod = result.sensingLatency;				//clk freq is decided by the longest sensing latency
 						}
-						
-						vector<double> columnResistance;
-						columnResistance = GetColumnResistance(input, subArrayMemory, cell, param->parallelRead, subArray->resCellAccess);
 
-						subArray->CalculateLatency(1e20, columnResistance, CalculateclkFreq);
-						if(CalculateclkFreq && (*clkPeriod < subArray->readLatency)){
-							*clkPeriod = subArray->readLatency;					//clk freq is decided by the longest sensing latency
-						}
+						*readDynamicEnergy += result.readDynamicEnergy;
+						subArrayLeakage = result.leakage;
 						
-						if(!CalculateclkFreq){
-							subArray->CalculatePower(columnResistance);
-							*readDynamicEnergy += subArray->readDynamicEnergy;
-							subArrayLeakage = subArray->leakage;
-							
-							subArrayLatencyADC += subArray->readLatencyADC;			//sensing cycle
-							subArrayLatencyAccum += subArray->readLatencyAccum;		//#cycles
-							subArrayReadLatency += subArray->readLatency;		//#cycles + sensing cycle
-							subArrayLatencyOther += subArray->readLatencyOther;
-							
-							*coreEnergyADC += subArray->readDynamicEnergyADC;
-							*coreEnergyAccum += subArray->readDynamicEnergyAccum;
-							*coreEnergyOther += subArray->readDynamicEnergyOther;
-						}
-					}
+						subArrayLatencyADC += result.readLatencyADC;			//sensing cycle
+						subArrayLatencyAccum += result.readLatencyAccum;		//#cycles
+						subArrayReadLatency += result.readLatency;		//#cycles + sensing cycle
+						subArrayLatencyOther += result.readLatencyOther;
+						
+						*coreEnergyADC += result.readDynamicEnergyADC;
+						*coreEnergyAccum += result.readDynamicEnergyAccum;
+						*coreEnergyOther += result.readDynamicEnergyOther;
+					});
 					*readLatency = MAX(subArrayReadLatency, (*readLatency));
 					*coreLatencyADC = MAX(subArrayLatencyADC, (*coreLatencyADC));
 					*coreLatencyAccum = MAX(subArrayLatencyAccum, (*coreLatencyAccum));
@@ -495,196 +535,174 @@ double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vecto
 			}
 		}
 		if (NMpe) {
-			adderTreeNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
-			adderTreeNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
-			*readLatency += adderTreeNM->readLatency;
-			*coreLatencyAccum += adderTreeNM->readLatency;
-			*readDynamicEnergy += adderTreeNM->readDynamicEnergy;
-			*coreEnergyAccum += adderTreeNM->readDynamicEnergy;
+			ctx.adderTreeNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
+			ctx.adderTreeNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
+			*readLatency += ctx.adderTreeNM->readLatency;
+			*coreLatencyAccum += ctx.adderTreeNM->readLatency;
+			*readDynamicEnergy += ctx.adderTreeNM->readDynamicEnergy;
+			*coreEnergyAccum += ctx.adderTreeNM->readDynamicEnergy;
 		} else {
-			adderTreeCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
-			adderTreeCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
-			*readLatency += adderTreeCM->readLatency;
-			*coreLatencyAccum += adderTreeCM->readLatency;
-			*readDynamicEnergy += adderTreeCM->readDynamicEnergy;
-			*coreEnergyAccum += adderTreeCM->readDynamicEnergy;
+			ctx.adderTreeCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray), 0);
+			ctx.adderTreeCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double) weightMatrixRow/(double) param->numRowSubArray));
+			*readLatency += ctx.adderTreeCM->readLatency;
+			*coreLatencyAccum += ctx.adderTreeCM->readLatency;
+			*readDynamicEnergy += ctx.adderTreeCM->readDynamicEnergy;
+			*coreEnergyAccum += ctx.adderTreeCM->readDynamicEnergy;
 		}
 		
 	}
-	if(!CalculateclkFreq){
-		//considering buffer activation: no matter speedup or not, the total number of data transferred is fixed
-		// input buffer: total num of data loaded in = weightMatrixRow*numInVector
-		// output buffer: total num of data transferred = weightMatrixRow*numInVector/param->numBitInput (total num of IFM in the PE) *adderTree->numAdderTree*adderTree->numAdderBit (bit precision of OFMs) 
-		if (NMpe) {
-			bufferInputNM->CalculateLatency(0, weightMatrixRow/param->numRowPerSynapse*numInVector/(bufferInputNM->numDff));
-			bufferOutputNM->CalculateLatency(0, weightMatrixCol/param->numColPerSynapse*adderTreeNM->numAdderBit*numInVector/param->numBitInput/(bufferOutputNM->numDff));
-			bufferInputNM->CalculatePower(weightMatrixRow/param->numRowPerSynapse*numInVector/(bufferInputNM->numDff), bufferInputNM->numDff, false);
-			bufferOutputNM->CalculatePower(weightMatrixCol/param->numColPerSynapse*adderTreeNM->numAdderBit*numInVector/param->numBitInput/(bufferOutputNM->numDff), bufferOutputNM->numDff, false);
-			
-			busInputNM->CalculateLatency(weightMatrixRow/param->numRowPerSynapse*numInVector/(busInputNM->busWidth)); 
-			busInputNM->CalculatePower(busInputNM->busWidth, weightMatrixRow/param->numRowPerSynapse*numInVector/(busInputNM->busWidth));
-			
-			if (param->parallelRead) {
-				busOutputNM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(busOutputNM->numRow*busOutputNM->busWidth));
-				busOutputNM->CalculatePower(busOutputNM->numRow*busOutputNM->busWidth, (weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(busOutputNM->numRow*busOutputNM->busWidth));
-			} else {
-				busOutputNM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(busOutputNM->numRow*busOutputNM->busWidth));
-				busOutputNM->CalculatePower(busOutputNM->numRow*busOutputNM->busWidth, (weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(busOutputNM->numRow*busOutputNM->busWidth));
-			}
+	//considering buffer activation: no matter speedup or not, the total number of data transferred is fixed
+	// input buffer: total num of data loaded in = weightMatrixRow*numInVector
+	// output buffer: total num of data transferred = weightMatrixRow*numInVector/param->numBitInput (total num of IFM in the PE) *adderTree->numAdderTree*adderTree->numAdderBit (bit precision of OFMs) 
+	if (NMpe) {
+		ctx.bufferInputNM->CalculateLatency(0, weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.bufferInputNM->numDff));
+		ctx.bufferOutputNM->CalculateLatency(0, weightMatrixCol/param->numColPerSynapse*ctx.adderTreeNM->numAdderBit*numInVector/param->numBitInput/(ctx.bufferOutputNM->numDff));
+		ctx.bufferInputNM->CalculatePower(weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.bufferInputNM->numDff), ctx.bufferInputNM->numDff, false);
+		ctx.bufferOutputNM->CalculatePower(weightMatrixCol/param->numColPerSynapse*ctx.adderTreeNM->numAdderBit*numInVector/param->numBitInput/(ctx.bufferOutputNM->numDff), ctx.bufferOutputNM->numDff, false);
+		
+		ctx.busInputNM->CalculateLatency(weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.busInputNM->busWidth)); 
+		ctx.busInputNM->CalculatePower(ctx.busInputNM->busWidth, weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.busInputNM->busWidth));
+		
+		if (param->parallelRead) {
+			ctx.busOutputNM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(ctx.busOutputNM->numRow*ctx.busOutputNM->busWidth));
+			ctx.busOutputNM->CalculatePower(ctx.busOutputNM->numRow*ctx.busOutputNM->busWidth, (weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(ctx.busOutputNM->numRow*ctx.busOutputNM->busWidth));
+		} else {
+			ctx.busOutputNM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(ctx.busOutputNM->numRow*ctx.busOutputNM->busWidth));
+			ctx.busOutputNM->CalculatePower(ctx.busOutputNM->numRow*ctx.busOutputNM->busWidth, (weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(ctx.busOutputNM->numRow*ctx.busOutputNM->busWidth));
+		}
 
-			*bufferLatency = bufferInputNM->readLatency + bufferOutputNM->readLatency;	//considered in ic
-			if (!param->synchronous) {
-				*icLatency = busInputNM->readLatency + busOutputNM->readLatency;	
-			}				
-			*bufferDynamicEnergy += bufferInputNM->readDynamicEnergy + bufferOutputNM->readDynamicEnergy;
-			*icDynamicEnergy += busInputNM->readDynamicEnergy + busOutputNM->readDynamicEnergy;
-			*leakage = subArrayLeakage*numSubArrayRow*numSubArrayCol + adderTreeNM->leakage + bufferInputNM->leakage + bufferOutputNM->leakage;
+		*bufferLatency = ctx.bufferInputNM->readLatency + ctx.bufferOutputNM->readLatency;	//considered in ic
+		if (!param->synchronous) {
+			*icLatency = ctx.busInputNM->readLatency + ctx.busOutputNM->readLatency;	
+		}				
+		*bufferDynamicEnergy += ctx.bufferInputNM->readDynamicEnergy + ctx.bufferOutputNM->readDynamicEnergy;
+		*icDynamicEnergy += ctx.busInputNM->readDynamicEnergy + ctx.busOutputNM->readDynamicEnergy;
+		*leakage = subArrayLeakage*numSubArrayRow*numSubArrayCol + ctx.adderTreeNM->leakage + ctx.bufferInputNM->leakage + ctx.bufferOutputNM->leakage;
+	} else {
+		ctx.bufferInputCM->CalculateLatency(0, weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.bufferInputCM->numDff));
+		ctx.bufferOutputCM->CalculateLatency(0, weightMatrixCol/param->numColPerSynapse*ctx.adderTreeNM->numAdderBit*numInVector/param->numBitInput/(ctx.bufferOutputCM->numDff));
+		ctx.bufferInputCM->CalculatePower(weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.bufferInputCM->numDff), ctx.bufferInputCM->numDff, false);
+		ctx.bufferOutputCM->CalculatePower(weightMatrixCol/param->numColPerSynapse*ctx.adderTreeNM->numAdderBit*numInVector/param->numBitInput/(ctx.bufferOutputCM->numDff), ctx.bufferOutputCM->numDff, false);
+		
+		ctx.busInputCM->CalculateLatency(weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.busInputCM->busWidth)); 
+		ctx.busInputCM->CalculatePower(ctx.busInputCM->busWidth, weightMatrixRow/param->numRowPerSynapse*numInVector/(ctx.busInputCM->busWidth));
+		
+		if (param->parallelRead) {
+			ctx.busOutputCM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(ctx.busOutputCM->numRow*ctx.busOutputCM->busWidth));
+			ctx.busOutputCM->CalculatePower(ctx.busOutputCM->numRow*ctx.busOutputCM->busWidth, (weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(ctx.busOutputCM->numRow*ctx.busOutputCM->busWidth));
 		} else {
-			bufferInputCM->CalculateLatency(0, weightMatrixRow/param->numRowPerSynapse*numInVector/(bufferInputCM->numDff));
-			bufferOutputCM->CalculateLatency(0, weightMatrixCol/param->numColPerSynapse*adderTreeNM->numAdderBit*numInVector/param->numBitInput/(bufferOutputCM->numDff));
-			bufferInputCM->CalculatePower(weightMatrixRow/param->numRowPerSynapse*numInVector/(bufferInputCM->numDff), bufferInputCM->numDff, false);
-			bufferOutputCM->CalculatePower(weightMatrixCol/param->numColPerSynapse*adderTreeNM->numAdderBit*numInVector/param->numBitInput/(bufferOutputCM->numDff), bufferOutputCM->numDff, false);
-			
-			busInputCM->CalculateLatency(weightMatrixRow/param->numRowPerSynapse*numInVector/(busInputCM->busWidth)); 
-			busInputCM->CalculatePower(busInputCM->busWidth, weightMatrixRow/param->numRowPerSynapse*numInVector/(busInputCM->busWidth));
-			
-			if (param->parallelRead) {
-				busOutputCM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(busOutputCM->numRow*busOutputCM->busWidth));
-				busOutputCM->CalculatePower(busOutputCM->numRow*busOutputCM->busWidth, (weightMatrixCol/param->numColPerSynapse*log2((double)param->levelOutput)*numInVector/param->numBitInput)/(busOutputCM->numRow*busOutputCM->busWidth));
-			} else {
-				busOutputCM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(busOutputCM->numRow*busOutputCM->busWidth));
-				busOutputCM->CalculatePower(busOutputCM->numRow*busOutputCM->busWidth, (weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(busOutputCM->numRow*busOutputCM->busWidth));
-			}
+			ctx.busOutputCM->CalculateLatency((weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(ctx.busOutputCM->numRow*ctx.busOutputCM->busWidth));
+			ctx.busOutputCM->CalculatePower(ctx.busOutputCM->numRow*ctx.busOutputCM->busWidth, (weightMatrixCol/param->numColPerSynapse*(log2((double)param->numRowSubArray)+param->cellBit-1)*numInVector/param->numBitInput)/(ctx.busOutputCM->numRow*ctx.busOutputCM->busWidth));
+		}
 
-			*bufferLatency = bufferInputCM->readLatency + bufferOutputCM->readLatency;	//considered in ic
-			if (!param->synchronous) {
-				*icLatency = busInputCM->readLatency + busOutputCM->readLatency;	
-			}
-			*bufferDynamicEnergy += bufferInputCM->readDynamicEnergy + bufferOutputCM->readDynamicEnergy;
-			*icDynamicEnergy += busInputCM->readDynamicEnergy + busOutputCM->readDynamicEnergy;
-			*leakage = subArrayLeakage*numSubArrayRow*numSubArrayCol + adderTreeCM->leakage + bufferInputCM->leakage + bufferOutputCM->leakage;
+		*bufferLatency = ctx.bufferInputCM->readLatency + ctx.bufferOutputCM->readLatency;	//considered in ic
+		if (!param->synchronous) {
+			*icLatency = ctx.busInputCM->readLatency + ctx.busOutputCM->readLatency;	
 		}
-		*readLatency += (*bufferLatency) + (*icLatency);	
-		*readDynamicEnergy += (*bufferDynamicEnergy) + (*icDynamicEnergy);
-		*coreLatencyOther += (*bufferLatency) + (*icLatency);	
-		*coreEnergyOther += (*bufferDynamicEnergy) + (*icDynamicEnergy);		
+		*bufferDynamicEnergy += ctx.bufferInputCM->readDynamicEnergy + ctx.bufferOutputCM->readDynamicEnergy;
+		*icDynamicEnergy += ctx.busInputCM->readDynamicEnergy + ctx.busOutputCM->readDynamicEnergy;
+		*leakage = subArrayLeakage*numSubArrayRow*numSubArrayCol + ctx.adderTreeCM->leakage + ctx.bufferInputCM->leakage + ctx.bufferOutputCM->leakage;
 	}
+	*readLatency += (*bufferLatency) + (*icLatency);	
+	*readDynamicEnergy += (*bufferDynamicEnergy) + (*icDynamicEnergy);
+	*coreLatencyOther += (*bufferLatency) + (*icLatency);	
+	*coreEnergyOther += (*bufferDynamicEnergy) + (*icDynamicEnergy);		
 }
 
 
-vector<vector<double> > CopySubArray(const vector<vector<double> > &orginal, int positionRow, int positionCol, int numRow, int numCol) {
-	vector<vector<double> > copy;
-	for (int i=0; i<numRow; i++) {
-		vector<double> copyRow;
-		for (int j=0; j<numCol; j++) {
-			copyRow.push_back(orginal[positionRow+i][positionCol+j]);
-		}
-		copy.push_back(copyRow);
-		copyRow.clear();
-	}
-	return copy;
-	copy.clear();
+const uint64_t *GetInputVector(const BitMatrix &input, int numInput, double *activityRowRead) {
+	// the window is packed per input vector, so the read-row activity is a popcount
+	double numofreadrow = input.Count(numInput);
+	double totalnumRow = input.numCol;
+	*(activityRowRead) = numofreadrow/totalnumRow;
+	return input.Row(numInput);
 } 
 
 
-vector<vector<double> > CopySubInput(const vector<vector<double> > &orginal, int positionRow, int numInputVector, int numRow) {
-	vector<vector<double> > copy;
-	for (int i=0; i<numRow; i++) {
-		vector<double> copyRow;
-		for (int j=0; j<numInputVector; j++) {
-			copyRow.push_back(orginal[positionRow+i][j]);
+void GetCellConductance(const SimContext &ctx, const MatrixView &weight, double resCellAccess, CellConductance *cellConductance) {
+	const MemCell& cell = ctx.cell;
+	// none of this depends on the input, so it is done once per subArray rather than per input vector
+	cellConductance->numRow = weight.numRow;
+	cellConductance->numCol = weight.numCol;
+	cellConductance->conductance.clear();
+	cellConductance->columnConductance.clear();
+	if (cell.memCellType == Type::SRAM) {
+		// SRAM: weight value do not affect sense energy --> read energy calculated in subArray.cpp (based on wireRes wireCap etc)
+		// the weights are not read at all, the column conductance only depends on the number of active rows
+		// (accumulated row by row as the per-cell sum did, so the result is bit-identical)
+		double totalWireResistance = (double) (resCellAccess + param->wireResistanceCol);
+		cellConductance->columnConductance.resize(weight.numRow+1);
+		cellConductance->columnConductance[0] = 0;
+		for (int n=1; n<=weight.numRow; n++) {
+			cellConductance->columnConductance[n] = cellConductance->columnConductance[n-1] + (double) 1.0/totalWireResistance;
+		}
+		return;
+	}
+	cellConductance->conductance.assign((size_t)weight.numRow*weight.numCol, 0);
+	if (cell.memCellType != Type::RRAM && cell.memCellType != Type::FeFET) {
+		return;
+	}
+	for (int i=0; i<weight.numRow; i++) {
+		const uint8_t *weightRow = weight.Row(i);
+		for (int j=0; j<weight.numCol; j++) {
+			// eNVM: cell + wire (+ 1T1R access) conductance, precomputed per level and position
+			cellConductance->conductance[(size_t)i*weight.numCol + j] = ctx.conductanceTable.WireConductance(weightRow[j], weight.numRow - i, j);
 		}
-		copy.push_back(copyRow);
-		copyRow.clear();
 	}
-	return copy;
-	copy.clear();
 }
 
 
-vector<double> GetInputVector(const vector<vector<double> > &input, int numInput, double *activityRowRead) {
-	vector<double> copy;
-	for (int i=0; i<input.size(); i++) {
-		double x = input[i][numInput];
-		copy.push_back(x);   
-	}  
-	double numofreadrow = 0;  // initialize readrowactivity parameters
-	for (int i=0; i<input.size(); i++) {
-		if (copy[i] != 0) {
-			numofreadrow += 1;
-		}else {
-			numofreadrow += 0;
-		}
-	}
-	double totalnumRow = input.size();
-	*(activityRowRead) = numofreadrow/totalnumRow;
-	return copy;
-	copy.clear();
-} 
+void GetColumnResistance(const SimContext &ctx, const uint64_t *input, const CellConductance &cellConductance, double *resistance) {
+	ctx.columnResistanceKernel(input, cellConductance, resistance);
+}
 
 
-vector<double> GetColumnResistance(const vector<double> &input, const vector<vector<double> > &weight, MemCell& cell, bool parallelRead, double resCellAccess) {
-	vector<double> resistance;
-	vector<double> conductance;
-	double columnG = 0; 
+// one instantiation per read path, so the loops over the columns carry no cell type / read mode test
+//   sram: closed form, every column sees the same conductance
+//   average: eNVM read row by row (not parallelRead), the column conductance is averaged over the activated rows
+template <bool sram, bool average>
+static void ColumnResistance(const uint64_t *input, const CellConductance &cellConductance, double *resistance) {
+	int numRow = cellConductance.numRow;
+	int numCol = cellConductance.numCol;
+	int numWord = (numRow+63)/64;
 	
-	for (int j=0; j<weight[0].size(); j++) {
-		int activatedRow = 0;
-		columnG = 0;
-		for (int i=0; i<weight.size(); i++) {
-			if (cell.memCellType == Type::RRAM) {	// eNVM
-				double totalWireResistance;
-				if (cell.accessType == CMOS_access) {
-					totalWireResistance = (double) 1.0/weight[i][j] + (j + 1) * param->wireResistanceRow + (weight.size() - i) * param->wireResistanceCol + cell.resistanceAccess;
-				} else {
-					totalWireResistance = (double) 1.0/weight[i][j] + (j + 1) * param->wireResistanceRow + (weight.size() - i) * param->wireResistanceCol;
-				}
-				if ((int) input[i] == 1) {
-					columnG += (double) 1.0/totalWireResistance;
-					activatedRow += 1 ;
-				} else {
-					columnG += 0;
-				}
-			} else if (cell.memCellType == Type::FeFET) {
-				double totalWireResistance;
-				totalWireResistance = (double) 1.0/weight[i][j] + (j + 1) * param->wireResistanceRow + (weight.size() - i) * param->wireResistanceCol;
-				if ((int) input[i] == 1) {
-					columnG += (double) 1.0/totalWireResistance;
-					activatedRow += 1 ;
-				} else {
-					columnG += 0;
-				}
-				
-			} else if (cell.memCellType == Type::SRAM) {	
-				// SRAM: weight value do not affect sense energy --> read energy calculated in subArray.cpp (based on wireRes wireCap etc)
-				double totalWireResistance = (double) (resCellAccess + param->wireResistanceCol);
-				if ((int) input[i] == 1) {
-					columnG += (double) 1.0/totalWireResistance;
-					activatedRow += 1 ;
-				} else {
-					columnG += 0;
-				}
-			}
+	int activatedRow = 0;
+	if (sram || average) {
+		for (int w=0; w<numWord; w++) {
+			activatedRow += __builtin_popcountll(input[w]);
 		}
-		
-		if (cell.memCellType == Type::RRAM || cell.memCellType == Type::FeFET) {
-			if (!parallelRead) {  
-				conductance.push_back((double) columnG/activatedRow);
-			} else {
-				conductance.push_back(columnG);
-			}
-		} else {
-			conductance.push_back(columnG);
+	}
+	
+	if (sram) {
+		double columnR = (double) 1.0/cellConductance.columnConductance[activatedRow];
+		for (int j=0; j<numCol; j++) {
+			resistance[j] = columnR;
+		}
+		return;
+	}
+	
+	// masked sum over the activated rows, several columns per instruction, then covert conductance to resistance in place
+	ColumnSum(cellConductance.conductance.data(), numRow, numCol, input, resistance);
+	if (average) {
+		for (int j=0; j<numCol; j++) {
+			resistance[j] = (double) 1.0/((double) resistance[j]/activatedRow);
+		}
+	} else {
+		for (int j=0; j<numCol; j++) {
+			resistance[j] = (double) 1.0/resistance[j];
 		}
 	}
-	// covert conductance to resistance
-	for (int i=0; i<weight[0].size(); i++) {
-		resistance.push_back((double) 1.0/conductance[i]);
+}
+
+
+static ColumnResistanceFunction SelectColumnResistance(MemCell& cell) {
+	if (cell.memCellType == Type::SRAM) {
+		return ColumnResistance<true, false>;
+	} else if ((cell.memCellType == Type::RRAM || cell.memCellType == Type::FeFET) && !param->parallelRead) {
+		return ColumnResistance<false, true>;
 	}
-		
-	return resistance;
-	resistance.clear();
-} 
+	return ColumnResistance<false, false>;
+}
 
 
 
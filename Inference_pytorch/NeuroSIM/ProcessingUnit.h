@@ -42,20 +42,29 @@
 #include "Technology.h"
 #include "MemCell.h"
 #include "SubArray.h"
+#include "InputStream.h"
+#include "SimContext.h"
  
+/*** Effective (cell + wire + access) conductance of every cell of one subArray, row-major ***/
+// SRAM cells all see the same access path, so only the column conductance per number of active rows is kept.
+struct CellConductance {
+	vector<double> conductance;		// eNVM: conductance[i*numCol + j], row i, column j
+	vector<double> columnConductance;	// SRAM: columnConductance[n], n = 0 ~ numRow active rows
+	int numRow, numCol;
+};
+
 /*** Functions ***/
-void ProcessingUnitInitialize(SubArray *& subArray, InputParameter& inputParameter, Technology& tech, MemCell& cell, int _numSubArrayRowNM, int _numSubArrayColNM, int _numSubArrayRowCM, int _numSubArrayColCM);
-vector<double> ProcessingUnitCalculateArea(SubArray *subArray, int numSubArrayRow, int numSubArrayCol, bool NMpe, double *height, double *width, double *bufferArea);
-double ProcessingUnitCalculatePerformance(SubArray *subArray, const vector<vector<double> > &newMemory, const vector<vector<double> > &oldMemory, const vector<vector<double> > &inputVector, 
+void ProcessingUnitInitialize(SimContext &ctx, int _numSubArrayRowNM, int _numSubArrayColNM, int _numSubArrayRowCM, int _numSubArrayColCM);
+vector<double> ProcessingUnitCalculateArea(SimContext &ctx, int numSubArrayRow, int numSubArrayCol, bool NMpe, double *height, double *width, double *bufferArea);
+void ProcessingUnitCalculatePerformance(SimContext &ctx, const MatrixView &newMemory, const MatrixView &oldMemory, const InputStream &inputStream, const MatrixView &inputRow, 
 										int arrayDupRow, int arrayDupCol, int numSubArrayRow, int numSubArrayCol, int weightMatrixRow, int weightMatrixCol, 
-										int numInVector, MemCell& cell, bool NMpe, double *readLatency, double *readDynamicEnergy, double *leakage, 
+										int numInVector, bool NMpe, double *readLatency, double *readDynamicEnergy, double *leakage, 
 										double *bufferLatency, double *bufferDynamicEnergy, double *icLatency, double *icDynamicEnergy,
-										double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, bool CalculateclkFreq, double*clkPeriod);
+										double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, double*clkPeriod);
 
-vector<vector<double> > CopySubArray(const vector<vector<double> > &orginal, int positionRow, int positionCol, int numRow, int numCol);
-vector<vector<double> > CopySubInput(const vector<vector<double> > &orginal, int positionRow, int numInputVector, int numRow);
-vector<double> GetInputVector(const vector<vector<double> > &input, int numInput, double *activityRowRead);
-vector<double> GetColumnResistance(const vector<double> &input, const vector<vector<double> > &weight, MemCell& cell, bool parallelRead, double resCellAccess);
+const uint64_t *GetInputVector(const BitMatrix &input, int numInput, double *activityRowRead);
+void GetCellConductance(const SimContext &ctx, const MatrixView &weight, double resCellAccess, CellConductance *cellConductance);
+void GetColumnResistance(const SimContext &ctx, const uint64_t *input, const CellConductance &cellConductance, double *resistance);		// kernel of the read path picked in ProcessingUnitInitialize
 
 
 #endif /* PROCESSINGUNIT_H_ */
\ No newline at end of file
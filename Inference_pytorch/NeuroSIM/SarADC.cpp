@@ -64,10 +64,45 @@ void SarADC::Initialize(int _numCol, int _levelOutput, double _clkFreq, int _num
 		widthNmos = MIN_NMOS_SIZE * tech.featureSize;
 		widthPmos = tech.pnSizeRatio * MIN_NMOS_SIZE * tech.featureSize;
 		
+		InitializeColumnModel();
+		if (param->columnTable) {
+			if (!powerTable.Initialize([this](double columnRes) { return GetColumnPower(columnRes); }, param->columnTableError)) {
+				cout << "[SarADC] Warning: column power table cannot meet columnTableError, using the analytic model" << endl;
+			}
+		}
+		
 		initialized = true;
 	}
 }
 
+void SarADC::InitializeColumnModel() {
+	// pick the Cadence fit of the technode once, GetColumnPower runs for every column of every input vector
+	double a, b;	// uW = a*log2(levelOutput)+b
+	if (param->deviceroadmap == 1) {  // HP
+		if (param->technode == 130)		{ a = 6.4806; b = 49.047; powerCoeff = 0.207452; powerExponent = -2.367; }
+		else if (param->technode == 90)	{ a = 4.3474; b = 31.782; powerCoeff = 0.164900; powerExponent = -2.345; }
+		else if (param->technode == 65)	{ a = 2.9503; b = 22.047; powerCoeff = 0.128483; powerExponent = -2.321; }
+		else if (param->technode == 45)	{ a = 2.1843; b = 11.931; powerCoeff = 0.097754; powerExponent = -2.296; }
+		else if (param->technode == 32)	{ a = 1.0157; b = 7.6286; powerCoeff = 0.083709; powerExponent = -2.313; }
+		else if (param->technode == 22)	{ a = 0.7213; b = 3.3041; powerCoeff = 0.084273; powerExponent = -2.311; }
+		else if (param->technode == 14)	{ a = 0.4710; b = 1.9529; powerCoeff = 0.060584; powerExponent = -2.311; }
+		else if (param->technode == 10)	{ a = 0.3076; b = 1.1543; powerCoeff = 0.049418; powerExponent = -2.311; }
+		else							{ a = 0.2008; b = 0.6823; powerCoeff = 0.040310; powerExponent = -2.311; }   // 7nm
+	} else {                         // LP
+		if (param->technode == 130)		{ a = 8.4483; b = 65.243; powerCoeff = 0.169380; powerExponent = -2.303; }
+		else if (param->technode == 90)	{ a = 5.9869; b = 37.462; powerCoeff = 0.144323; powerExponent = -2.303; }
+		else if (param->technode == 65)	{ a = 3.7506; b = 25.844; powerCoeff = 0.121272; powerExponent = -2.303; }
+		else if (param->technode == 45)	{ a = 2.1691; b = 16.693; powerCoeff = 0.100225; powerExponent = -2.303; }
+		else if (param->technode == 32)	{ a = 1.1294; b = 8.8998; powerCoeff = 0.079449; powerExponent = -2.297; }
+		else if (param->technode == 22)	{ a = 0.538; b = 4.3753; powerCoeff = 0.072341; powerExponent = -2.303; }
+		else if (param->technode == 14)	{ a = 0.3132; b = 2.5681; powerCoeff = 0.061085; powerExponent = -2.303; }
+		else if (param->technode == 10)	{ a = 0.1823; b = 1.5073; powerCoeff = 0.051580; powerExponent = -2.303; }
+		else							{ a = 0.1061; b = 0.8847; powerCoeff = 0.043555; powerExponent = -2.303; }   // 7nm
+	}
+	powerLevel = (a*log2(levelOutput)+b)*1e-6;
+	numCycle = log2(levelOutput)+1;
+}
+
 
 void SarADC::CalculateUnitArea() {
 	if (!initialized) {
@@ -141,7 +176,9 @@ void SarADC::CalculatePower(const vector<double> &columnResistance, double numRe
 		readDynamicEnergy = 0;
 		for (double i=0; i<columnResistance.size(); i++) {
 			double E_Col = 0;
-			E_Col = GetColumnPower(columnResistance[i]);
+			if (!powerTable.Lookup(columnResistance[i], &E_Col)) {
+				E_Col = GetColumnPower(columnResistance[i]);
+			}
 			readDynamicEnergy += E_Col;
 		}
 		readDynamicEnergy *= numRead;
@@ -165,67 +202,10 @@ double SarADC::GetColumnPower(double columnRes) {
 	} else if (columnRes == 0) {
 		Column_Power = 0;
 	} else {
-		if (param->deviceroadmap == 1) {  // HP
-			if (param->technode == 130) {
-				Column_Power = (6.4806*log2(levelOutput)+49.047)*1e-6;
-				Column_Power += 0.207452*exp(-2.367*log10(columnRes));
-			} else if (param->technode == 90) {
-				Column_Power = (4.3474*log2(levelOutput)+31.782)*1e-6;
-				Column_Power += 0.164900*exp(-2.345*log10(columnRes));
-			} else if (param->technode == 65) {
-				Column_Power = (2.9503*log2(levelOutput)+22.047)*1e-6;
-				Column_Power += 0.128483*exp(-2.321*log10(columnRes));
-			} else if (param->technode == 45) {
-				Column_Power = (2.1843*log2(levelOutput)+11.931)*1e-6;
-				Column_Power += 0.097754*exp(-2.296*log10(columnRes));
-			} else if (param->technode == 32){  
-				Column_Power = (1.0157*log2(levelOutput)+7.6286)*1e-6;
-				Column_Power += 0.083709*exp(-2.313*log10(columnRes));
-			} else if (param->technode == 22){   
-				Column_Power = (0.7213*log2(levelOutput)+3.3041)*1e-6;
-				Column_Power += 0.084273*exp(-2.311*log10(columnRes));
-			} else if (param->technode == 14){   
-				Column_Power = (0.4710*log2(levelOutput)+1.9529)*1e-6;
-				Column_Power += 0.060584*exp(-2.311*log10(columnRes));
-			} else if (param->technode == 10){   
-				Column_Power = (0.3076*log2(levelOutput)+1.1543)*1e-6;
-				Column_Power += 0.049418*exp(-2.311*log10(columnRes));
-			} else {   // 7nm
-				Column_Power = (0.2008*log2(levelOutput)+0.6823)*1e-6;
-				Column_Power += 0.040310*exp(-2.311*log10(columnRes));
-			}
-		} else {                         // LP
-			if (param->technode == 130) {
-				Column_Power = (8.4483*log2(levelOutput)+65.243)*1e-6;
-				Column_Power += 0.169380*exp(-2.303*log10(columnRes));
-			} else if (param->technode == 90) {
-				Column_Power = (5.9869*log2(levelOutput)+37.462)*1e-6;
-				Column_Power += 0.144323*exp(-2.303*log10(columnRes));
-			} else if (param->technode == 65) {
-				Column_Power = (3.7506*log2(levelOutput)+25.844)*1e-6;
-				Column_Power += 0.121272*exp(-2.303*log10(columnRes));
-			} else if (param->technode == 45) {
-				Column_Power = (2.1691*log2(levelOutput)+16.693)*1e-6;
-				Column_Power += 0.100225*exp(-2.303*log10(columnRes));
-			} else if (param->technode == 32){  
-				Column_Power = (1.1294*log2(levelOutput)+8.8998)*1e-6;
-				Column_Power += 0.079449*exp(-2.297*log10(columnRes));
-			} else if (param->technode == 22){   
-				Column_Power = (0.538*log2(levelOutput)+4.3753)*1e-6;
-				Column_Power += 0.072341*exp(-2.303*log10(columnRes));
-			} else if (param->technode == 14){   
-				Column_Power = (0.3132*log2(levelOutput)+2.5681)*1e-6;
-				Column_Power += 0.061085*exp(-2.303*log10(columnRes));
-			} else if (param->technode == 10){   
-				Column_Power = (0.1823*log2(levelOutput)+1.5073)*1e-6;
-				Column_Power += 0.051580*exp(-2.303*log10(columnRes));
-			} else {   // 7nm
-				Column_Power = (0.1061*log2(levelOutput)+0.8847)*1e-6;
-				Column_Power += 0.043555*exp(-2.303*log10(columnRes));
-			}
-		}
+		Column_Power = powerLevel;
+		Column_Power += powerCoeff*exp(powerExponent*log10(columnRes));
 	}
 	Column_Power *= (1+1.3e-3*(param->temp-300));
-	Column_Energy = Column_Power * (log2(levelOutput)+1)*1e-9;
+	Column_Energy = Column_Power * numCycle*1e-9;
 	return Column_Energy;
 }
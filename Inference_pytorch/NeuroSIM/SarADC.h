@@ -45,6 +45,7 @@
 #include "Technology.h"
 #include "MemCell.h"
 #include "FunctionUnit.h"
+#include "ColumnTable.h"
 
 using namespace std;
 
@@ -64,6 +65,7 @@ public:
 	void CalculateLatency(double numRead);
 	void CalculatePower(const vector<double> &columnResistance, double numRead);
 	double GetColumnPower(double columnRes);
+	void InitializeColumnModel();
 
 	/* Properties */
 	bool initialized;		/* Initialization flag */
@@ -76,6 +78,11 @@ public:
 	double clkFreq, areaUnit;
 	int numReadCellPerOperationNeuro;
 	vector<double> Rref;
+	
+	/* Column model of the technode, resolved at initialization */
+	double powerLevel, powerCoeff, powerExponent;	/* P = powerLevel + powerCoeff*exp(powerExponent*log10(R)) */
+	double numCycle;				/* log2(levelOutput)+1 conversion cycles */
+	ColumnTable powerTable;			/* GetColumnPower tabulated when param->columnTable */
 
 };
 
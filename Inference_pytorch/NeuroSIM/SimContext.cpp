@@ -0,0 +1,178 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include "SubArray.h"
+#include "Buffer.h"
+#include "HTree.h"
+#include "AdderTree.h"
+#include "Sigmoid.h"
+#include "BitShifter.h"
+#include "MaxPooling.h"
+#include "Bus.h"
+#include "DFF.h"
+#include "SimContext.h"
+
+// the modules only keep references to inputParameter/tech/cell, they are sized by the *Initialize functions
+SimContext::SimContext(InputParameter& _inputParameter, Technology& _tech, MemCell& _cell):
+inputParameter(_inputParameter), tech(_tech), cell(_cell), gen(0) {
+	globalBuffer = new Buffer(inputParameter, tech, cell);
+	GhTree = new HTree(inputParameter, tech, cell);
+	Gaccumulation = new AdderTree(inputParameter, tech, cell);
+	Gsigmoid = new Sigmoid(inputParameter, tech, cell);
+	GreLu = new BitShifter(inputParameter, tech, cell);
+	maxPool = new MaxPooling(inputParameter, tech, cell);
+	globalBusWidth = 0;
+	numBufferCore = 0;
+	
+	subArrayInPE = new SubArray(inputParameter, tech, cell);
+	inputBufferCM = new Buffer(inputParameter, tech, cell);
+	outputBufferCM = new Buffer(inputParameter, tech, cell);
+	hTreeCM = new HTree(inputParameter, tech, cell);
+	accumulationCM = new AdderTree(inputParameter, tech, cell);
+	sigmoidCM = new Sigmoid(inputParameter, tech, cell);
+	reLuCM = new BitShifter(inputParameter, tech, cell);
+	inputBufferNM = new Buffer(inputParameter, tech, cell);
+	outputBufferNM = new Buffer(inputParameter, tech, cell);
+	hTreeNM = new HTree(inputParameter, tech, cell);
+	accumulationNM = new AdderTree(inputParameter, tech, cell);
+	sigmoidNM = new Sigmoid(inputParameter, tech, cell);
+	reLuNM = new BitShifter(inputParameter, tech, cell);
+	numInBufferCore = 0;
+	numOutBufferCore = 0;
+	
+	adderTreeNM = new AdderTree(inputParameter, tech, cell);
+	busInputNM = new Bus(inputParameter, tech, cell);
+	busOutputNM = new Bus(inputParameter, tech, cell);
+	bufferInputNM = new DFF(inputParameter, tech, cell);
+	bufferOutputNM = new DFF(inputParameter, tech, cell);
+	adderTreeCM = new AdderTree(inputParameter, tech, cell);
+	busInputCM = new Bus(inputParameter, tech, cell);
+	busOutputCM = new Bus(inputParameter, tech, cell);
+	bufferInputCM = new DFF(inputParameter, tech, cell);
+	bufferOutputCM = new DFF(inputParameter, tech, cell);
+	columnResistanceKernel = NULL;
+}
+
+// scratch context: the modules are copied with their initialized state
+SimContext::SimContext(const SimContext &other):
+inputParameter(other.inputParameter), tech(other.tech), cell(other.cell), gen(other.gen),
+conductanceTable(other.conductanceTable), columnResistanceKernel(other.columnResistanceKernel) {
+	globalBuffer = new Buffer(*other.globalBuffer);
+	GhTree = new HTree(*other.GhTree);
+	Gaccumulation = new AdderTree(*other.Gaccumulation);
+	Gsigmoid = new Sigmoid(*other.Gsigmoid);
+	GreLu = new BitShifter(*other.GreLu);
+	maxPool = new MaxPooling(*other.maxPool);
+	globalBusWidth = other.globalBusWidth;
+	numBufferCore = other.numBufferCore;
+	
+	CopyTileModules(other);
+}
+
+SimContext::~SimContext() {
+	delete globalBuffer;
+	delete GhTree;
+	delete Gaccumulation;
+	delete Gsigmoid;
+	delete GreLu;
+	delete maxPool;
+	
+	DeleteTileModules();
+}
+
+// back to the tile and PE modules of initial, so a tile does not start from the state left by the previous one
+void SimContext::ResetTileModules(const SimContext &initial) {
+	DeleteTileModules();
+	CopyTileModules(initial);
+}
+
+void SimContext::CopyTileModules(const SimContext &other) {
+	subArrayInPE = new SubArray(*other.subArrayInPE);
+	inputBufferCM = new Buffer(*other.inputBufferCM);
+	outputBufferCM = new Buffer(*other.outputBufferCM);
+	hTreeCM = new HTree(*other.hTreeCM);
+	accumulationCM = new AdderTree(*other.accumulationCM);
+	sigmoidCM = new Sigmoid(*other.sigmoidCM);
+	reLuCM = new BitShifter(*other.reLuCM);
+	inputBufferNM = new Buffer(*other.inputBufferNM);
+	outputBufferNM = new Buffer(*other.outputBufferNM);
+	hTreeNM = new HTree(*other.hTreeNM);
+	accumulationNM = new AdderTree(*other.accumulationNM);
+	sigmoidNM = new Sigmoid(*other.sigmoidNM);
+	reLuNM = new BitShifter(*other.reLuNM);
+	numInBufferCore = other.numInBufferCore;
+	numOutBufferCore = other.numOutBufferCore;
+	
+	adderTreeNM = new AdderTree(*other.adderTreeNM);
+	busInputNM = new Bus(*other.busInputNM);
+	busOutputNM = new Bus(*other.busOutputNM);
+	bufferInputNM = new DFF(*other.bufferInputNM);
+	bufferOutputNM = new DFF(*other.bufferOutputNM);
+	adderTreeCM = new AdderTree(*other.adderTreeCM);
+	busInputCM = new Bus(*other.busInputCM);
+	busOutputCM = new Bus(*other.busOutputCM);
+	bufferInputCM = new DFF(*other.bufferInputCM);
+	bufferOutputCM = new DFF(*other.bufferOutputCM);
+}
+
+void SimContext::DeleteTileModules() {
+	delete subArrayInPE;
+	delete inputBufferCM;
+	delete outputBufferCM;
+	delete hTreeCM;
+	delete accumulationCM;
+	delete sigmoidCM;
+	delete reLuCM;
+	delete inputBufferNM;
+	delete outputBufferNM;
+	delete hTreeNM;
+	delete accumulationNM;
+	delete sigmoidNM;
+	delete reLuNM;
+	
+	delete adderTreeNM;
+	delete busInputNM;
+	delete busOutputNM;
+	delete bufferInputNM;
+	delete bufferOutputNM;
+	delete adderTreeCM;
+	delete busInputCM;
+	delete busOutputCM;
+	delete bufferInputCM;
+	delete bufferOutputCM;
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef SIMCONTEXT_H_
+#define SIMCONTEXT_H_
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include "InputParameter.h"
+#include "Technology.h"
+#include "MemCell.h"
+#include "ConductanceTable.h"
+#include "InputStream.h"
+
+using namespace std;
+
+class SubArray;
+class Buffer;
+class HTree;
+class AdderTree;
+class Sigmoid;
+class BitShifter;
+class MaxPooling;
+class Bus;
+class DFF;
+struct CellConductance;
+
+typedef void (*ColumnResistanceFunction)(const uint64_t *, const CellConductance &, double *);
+
+/*** Simulation context: the circuit modules of the chip/tile/PE levels and the state of one run ***/
+// Every Calculate* call overwrites the result fields of the modules (readLatency, readDynamicEnergy, ...), so two evaluations
+// must not share a context. The copy constructor gives a scratch context for another thread: its own copy of every module,
+// the same inputParameter/tech/cell (read-only once ProcessingUnitInitialize is done).
+class SimContext {
+public:
+	SimContext(InputParameter& _inputParameter, Technology& _tech, MemCell& _cell);
+	SimContext(const SimContext &other);
+	virtual ~SimContext();
+	SimContext &operator=(const SimContext &) = delete;
+	void ResetTileModules(const SimContext &initial);
+	
+	InputParameter& inputParameter;
+	Technology& tech;
+	MemCell& cell;
+	
+	mt19937 gen;			// random number generator engine, seeded 0
+	
+	/*** Chip ***/
+	Buffer *globalBuffer;
+	HTree *GhTree;
+	AdderTree *Gaccumulation;
+	Sigmoid *Gsigmoid;
+	BitShifter *GreLu;
+	MaxPooling *maxPool;
+	double globalBusWidth;
+	int numBufferCore;
+	
+	/*** Tile ***/
+	SubArray *subArrayInPE;
+	Buffer *inputBufferCM;
+	Buffer *outputBufferCM;
+	HTree *hTreeCM;
+	AdderTree *accumulationCM;
+	Sigmoid *sigmoidCM;
+	BitShifter *reLuCM;
+	Buffer *inputBufferNM;
+	Buffer *outputBufferNM;
+	HTree *hTreeNM;
+	AdderTree *accumulationNM;
+	Sigmoid *sigmoidNM;
+	BitShifter *reLuNM;
+	int numInBufferCore;
+	int numOutBufferCore;
+	
+	/*** ProcessingUnit ***/
+	AdderTree *adderTreeNM;
+	Bus *busInputNM;
+	Bus *busOutputNM;
+	DFF *bufferInputNM;
+	DFF *bufferOutputNM;
+	AdderTree *adderTreeCM;
+	Bus *busInputCM;
+	Bus *busOutputCM;
+	DFF *bufferInputCM;
+	DFF *bufferOutputCM;
+	
+	ConductanceTable conductanceTable;
+	ColumnResistanceFunction columnResistanceKernel;		// read path of the run, picked in ProcessingUnitInitialize
+
+private:
+	void CopyTileModules(const SimContext &other);
+	void DeleteTileModules();
+};
+
+#endif /* SIMCONTEXT_H_ */
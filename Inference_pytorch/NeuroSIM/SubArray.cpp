@@ -77,6 +77,7 @@ SubArray::SubArray(InputParameter& _inputParameter, Technology& _tech, MemCell&
 						multilevelSAEncoder(_inputParameter, _tech, _cell),
 						sarADC(_inputParameter, _tech, _cell){
 	initialized = false;
+	prepared = false;
 	readDynamicEnergyArray = writeDynamicEnergyArray = 0;
 } 
 
@@ -554,391 +555,482 @@ void SubArray::CalculateArea() {  //calculate layout area for total design
 	}
 }
 
-void SubArray::CalculateLatency(double columnRes, const vector<double> &columnResistance, bool CalculateclkFreq) {   //calculate latency for different mode 
+void SubArray::Prepare() {   //input-invariant part of latency and power, once per layer before the Evaluate() of each input vector
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
 	} else {
-		
-		readLatency = 0;
-		readLatencyADC = 0;
-		readLatencyAccum = 0;
-		readLatencyOther = 0;
-		writeLatency = 0;
-
+		PrepareLatency();
+		PreparePower();
+		if (conventionalSequential) {
+			readMode = SEQUENTIAL_READ;
+		} else if (conventionalParallel) {
+			readMode = PARALLEL_READ;
+		} else if (BNNsequentialMode || XNORsequentialMode) {
+			readMode = BNN_SEQUENTIAL_READ;
+		} else {
+			readMode = BNN_PARALLEL_READ;
+		}
 		if (cell.memCellType == Type::SRAM) {
-			if (conventionalSequential) {
-				int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				if (CalculateclkFreq || !param->synchronous) {
-					wlDecoder.CalculateLatency(1e20, capRow1, NULL, 1, numRow*activityRowWrite);				
-					precharger.CalculateLatency(1e20, capCol, 1, numWriteOperationPerRow*numRow*activityRowWrite);					
-					senseAmp.CalculateLatency(1);
+			PickReadMode<true>();
+		} else {
+			PickReadMode<false>();
+		}
+		prepared = true;
+	}
+}
 
-					// Read
-					double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
-					double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
-					tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));   
-					double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
-					double beta = 1 / (resPullDown * gm);
-					double colRamp = 0;
-					colDelay = horowitz(tau, beta, wlDecoder.rampOutput, &colRamp);
-					
-					if (CalculateclkFreq) {
-						readLatency += wlDecoder.readLatency;
-						readLatency += precharger.readLatency;
-						readLatency += colDelay;
-						readLatency += senseAmp.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				} 
-				if (!CalculateclkFreq) {
-					adder.CalculateLatency(1e20, dff.capTgDrain, numReadOperationPerRow*numRow*activityRowRead);
-					dff.CalculateLatency(1e20, numReadOperationPerRow*numRow*activityRowRead);
-					if (numReadPulse > 1) {
-						shiftAdd.CalculateLatency(1);	
-					}
-					
-					if (param->synchronous) {
-						readLatencyADC = numReadOperationPerRow*numRow*activityRowRead;
-						readLatencyAccum = adder.readLatency + shiftAdd.readLatency;
-					} else {
-						readLatencyADC = (precharger.readLatency + colDelay + senseAmp.readLatency) * numReadOperationPerRow*numRow*activityRowRead * (validated==true? param->beta : 1);;
-						readLatencyAccum = adder.readLatency + dff.readLatency + shiftAdd.readLatency;
-						readLatencyOther = wlDecoder.readLatency * numRow*activityRowRead * (validated==true? param->beta : 1);;
-					}
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}	
-					// // Write (assume the average delay of pullup and pulldown inverter in SRAM cell)
-					// double resPull;
-					// resPull = (CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech) + CalculateOnResistance(cell.widthSRAMCellPMOS * tech.featureSize, PMOS, inputParameter.temperature, tech)) / 2;    // take average
-					// tau = resPull * cell.capSRAMCell;
-					// gm = (CalculateTransconductance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, tech) + CalculateTransconductance(cell.widthSRAMCellPMOS * tech.featureSize, PMOS, tech)) / 2;   // take average
-					// beta = 1 / (resPull * gm);
-					// sramWriteDriver.CalculateLatency(1e20, capCol, resCol, numWriteOperationPerRow*numRow*activityRowWrite);
-					// // writeLatency += horowitz(tau, beta, 1e20, NULL) * numWriteOperationPerRow * numRow * activityRowWrite;
-					// // writeLatency += wlDecoder.writeLatency;
-					// // writeLatency += precharger.writeLatency;
-					// // writeLatency += sramWriteDriver.writeLatency;
-			} else if (conventionalParallel) {
-				int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				if (CalculateclkFreq || !param->synchronous) {
-					wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					precharger.CalculateLatency(1e20, capCol, 1, numWriteOperationPerRow*numRow*activityRowWrite);
-					if (SARADC) {
-						sarADC.CalculateLatency(1);
-					} else {
-						multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
-						multilevelSAEncoder.CalculateLatency(1e20, 1);
-					}					
-					if (numColMuxed > 1) {
-						mux.CalculateLatency(0, 0, 1);
-						muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
-					}					
+void SubArray::PrepareLatency() {   //peripheries that do not see the input vector, the rest is left to CalculateLatency
+	if (cell.memCellType == Type::SRAM) {
+		if (conventionalSequential) {
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			wlDecoder.CalculateLatency(1e20, capRow1, NULL, 1, numRow*activityRowWrite);
+			precharger.CalculateLatency(1e20, capCol, 1, numWriteOperationPerRow*numRow*activityRowWrite);
+			senseAmp.CalculateLatency(1);
 
-					// Read
-					double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
-					double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
-					tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));   
-					double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
-					double beta = 1 / (resPullDown * gm);
-					double colRamp = 0;
-					colDelay = horowitz(tau, beta, wlSwitchMatrix.rampOutput, &colRamp);
+			// Read
+			double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
+			double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
+			tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));
+			double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
+			double beta = 1 / (resPullDown * gm);
+			double colRamp = 0;
+			colDelay = horowitz(tau, beta, wlDecoder.rampOutput, &colRamp);
+			if (numReadPulse > 1) {
+				shiftAdd.CalculateLatency(1);
+			}
+		} else if (conventionalParallel) {
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			precharger.CalculateLatency(1e20, capCol, 1, numWriteOperationPerRow*numRow*activityRowWrite);
+			if (SARADC) {
+				sarADC.CalculateLatency(1);
+			} else {
+				multilevelSAEncoder.CalculateLatency(1e20, 1);
+			}
+			if (numColMuxed > 1) {
+				mux.CalculateLatency(0, 0, 1);
+				muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
+			}
 
-					if (CalculateclkFreq) {
-						readLatency += MAX(wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0) );
-						readLatency += precharger.readLatency;
-						readLatency += colDelay;
-						readLatency += multilevelSenseAmp.readLatency;
-						readLatency += multilevelSAEncoder.readLatency;
-						readLatency += sarADC.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				}
-				if (!CalculateclkFreq) {
-					if (numReadPulse > 1) {
-						shiftAdd.CalculateLatency(numColMuxed);	
-					}
-					if (param->synchronous) {
-						readLatencyADC = numColMuxed;
-					} else {
-						readLatencyADC = (precharger.readLatency + colDelay + multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency) * numColMuxed * (validated==true? param->beta : 1);;
-						readLatencyOther = MAX(wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0) ) * numColMuxed * (validated==true? param->beta : 1);;
-					}
-					readLatencyAccum = shiftAdd.readLatency;
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}
-			} else if (BNNsequentialMode || XNORsequentialMode) {
-				int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				if (CalculateclkFreq || !param->synchronous) {
-					wlDecoder.CalculateLatency(1e20, capRow1, NULL, 1, numRow*activityRowWrite);
-					precharger.CalculateLatency(1e20, capCol,1, numWriteOperationPerRow*numRow*activityRowWrite);				
-					senseAmp.CalculateLatency(1);				
-					
-					// Read
-					double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
-					double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
-					tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));   
-					double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
-					double beta = 1 / (resPullDown * gm);
-					double colRamp = 0;
-					colDelay = horowitz(tau, beta, wlDecoder.rampOutput, &colRamp);
+			// Read
+			double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
+			double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
+			tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));
+			double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
+			double beta = 1 / (resPullDown * gm);
+			double colRamp = 0;
+			colDelay = horowitz(tau, beta, wlSwitchMatrix.rampOutput, &colRamp);
+			if (numReadPulse > 1) {
+				shiftAdd.CalculateLatency(numColMuxed);
+			}
+		} else if (BNNsequentialMode || XNORsequentialMode) {
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			wlDecoder.CalculateLatency(1e20, capRow1, NULL, 1, numRow*activityRowWrite);
+			precharger.CalculateLatency(1e20, capCol,1, numWriteOperationPerRow*numRow*activityRowWrite);
+			senseAmp.CalculateLatency(1);
 
-					if (CalculateclkFreq) {
-						readLatency += wlDecoder.readLatency;
-						readLatency += precharger.readLatency;
-						readLatency += colDelay;
-						readLatency += senseAmp.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				}
-				if (!CalculateclkFreq) {
-					adder.CalculateLatency(1e20, dff.capTgDrain, numReadOperationPerRow*numRow*activityRowRead);
-					dff.CalculateLatency(1e20, numReadOperationPerRow*numRow*activityRowRead);
-					if (param->synchronous) {
-						readLatencyADC = numReadOperationPerRow*numRow*activityRowRead;
-						readLatencyAccum = adder.readLatency;
-					} else {
-						readLatencyADC = (precharger.readLatency + colDelay + senseAmp.readLatency) * numReadOperationPerRow*numRow*activityRowRead * (validated==true? param->beta : 1);;
-						readLatencyAccum = adder.readLatency + dff.readLatency;
-						readLatencyOther = wlDecoder.readLatency * numRow*activityRowRead * (validated==true? param->beta : 1);;
-					}				
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}				
-			} else if (BNNparallelMode || XNORparallelMode) {
-				int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				if (CalculateclkFreq || !param->synchronous) {
-					wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					precharger.CalculateLatency(1e20, capCol, 1, numWriteOperationPerRow*numRow*activityRowWrite);					
-					if (SARADC) {
-						sarADC.CalculateLatency(1);
-					} else {
-						multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
-						multilevelSAEncoder.CalculateLatency(1e20, 1);
-					}
-					if (numColMuxed > 1) {
-						mux.CalculateLatency(0, 0, 1);
-						muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
-					}				
-					
-					// Read
-					double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
-					double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
-					tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));   
-					double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
-					double beta = 1 / (resPullDown * gm);
-					double colRamp = 0;
-					colDelay = horowitz(tau, beta, wlSwitchMatrix.rampOutput, &colRamp);
-					
-					if (CalculateclkFreq) {
-						readLatency += wlSwitchMatrix.readLatency;
-						readLatency += precharger.readLatency;
-						readLatency += colDelay;
-						readLatency += multilevelSenseAmp.readLatency;
-						readLatency += multilevelSAEncoder.readLatency;
-						readLatency += sarADC.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				}
-				if (!CalculateclkFreq) {
-					if (param->synchronous) {
-						readLatencyADC = numColMuxed;
-					} else {
-						readLatencyADC = (precharger.readLatency + colDelay + multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency) * numColMuxed * (validated==true? param->beta : 1);;
-						readLatencyOther = MAX(wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0) ) * numColMuxed * (validated==true? param->beta : 1);;
-					}
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}			
+			// Read
+			double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
+			double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
+			tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));
+			double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
+			double beta = 1 / (resPullDown * gm);
+			double colRamp = 0;
+			colDelay = horowitz(tau, beta, wlDecoder.rampOutput, &colRamp);
+		} else if (BNNparallelMode || XNORparallelMode) {
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			precharger.CalculateLatency(1e20, capCol, 1, numWriteOperationPerRow*numRow*activityRowWrite);
+			if (SARADC) {
+				sarADC.CalculateLatency(1);
+			} else {
+				multilevelSAEncoder.CalculateLatency(1e20, 1);
 			}
-	    } else if (cell.memCellType == Type::RRAM || cell.memCellType == Type::FeFET) {
-			if (conventionalSequential) {
-				double capBL = lengthCol * 0.2e-15/1e-6;
-				double colRamp = 0;
-				double tau = (capCol)*(cell.resMemCellAvg);
-				colDelay = horowitz(tau, 0, 1e20, &colRamp);	// Just to generate colRamp
-				colDelay = tau * 0.2;  // assume the 15~20% voltage drop is enough for sensing
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				if (CalculateclkFreq || !param->synchronous) {		
-					wlDecoder.CalculateLatency(1e20, capRow2, NULL, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					if (cell.accessType == CMOS_access) {
-						wlNewDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);	
-					} else {
-						wlDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow1, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);										
-					}					
-					if (numColMuxed > 1) {
-						mux.CalculateLatency(colRamp, 0, 1);
-						muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
-					}
-					if (SARADC) {
-						sarADC.CalculateLatency(1);
-					} else {
-						multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
-						if (avgWeightBit > 1) {
-							multilevelSAEncoder.CalculateLatency(1e20, 1);
-						}
-					}					
-					if (CalculateclkFreq) {
-						readLatency += MAX(wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
-						readLatency += colDelay;
-						readLatency += multilevelSenseAmp.readLatency;
-						readLatency += multilevelSAEncoder.readLatency;
-						readLatency += sarADC.readLatency;
-						readLatency *= (validated==true? param->beta : 1);		// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				}
-				if (!CalculateclkFreq) {
-					adder.CalculateLatency(1e20, dff.capTgDrain, numColMuxed*numRow*activityRowRead);
-					dff.CalculateLatency(1e20, numColMuxed*numRow*activityRowRead);
-					if (numReadPulse > 1) {
-						shiftAdd.CalculateLatency(numColMuxed);	// There are numReadPulse times of shift-and-add
-					}
-					if (param->synchronous) {
-						readLatencyADC = numRow*activityRowRead*numColMuxed;
-						readLatencyAccum = adder.readLatency + shiftAdd.readLatency;
-					} else {
-						readLatencyADC = (multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency + colDelay) * (numRow*activityRowRead*numColMuxed) * (validated==true? param->beta : 1);
-						readLatencyAccum = adder.readLatency + dff.readLatency + shiftAdd.readLatency;	
-						readLatencyOther = MAX((wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency)*numRow*activityRowRead, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
-					}
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}
-					// // Write
-					// wllevelshifter.CalculateLatency(1e20, 2*wlNewDecoderDriver.capTgDrain, wlNewDecoderDriver.resTg, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					// bllevelshifter.CalculateLatency(1e20, 2*wlNewDecoderDriver.capTgDrain, wlNewDecoderDriver.resTg, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					// sllevelshifter.CalculateLatency(1e20, 2*slSwitchMatrix.capTgDrain, slSwitchMatrix.resTg, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					// slSwitchMatrix.CalculateLatency(1e20, capCol, resCol, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite); 
-					// writeLatencyArray = numWritePulse * param->writePulseWidthLTP + (-numErasePulse) * param->writePulseWidthLTD;
-					// writeLatency += MAX(wlDecoder.writeLatency + wlNewDecoderDriver.writeLatency + wlDecoderDriver.writeLatency, sllevelshifter.writeLatency + slSwitchMatrix.writeLatency + bllevelshifter.writeLatency);
-					// writeLatency += writeLatencyArray;
-					
-			} else if (conventionalParallel) {
-				double capBL = lengthCol * 0.2e-15/1e-6;
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				double colRamp = 0;
-				double tau = (capCol)*(cell.resMemCellAvg/(numRow/2));
-				colDelay = horowitz(tau, 0, 1e20, &colRamp);
-				colDelay = tau * 0.2;  // assume the 15~20% voltage drop is enough for sensing
-				if (CalculateclkFreq || !param->synchronous) {				
-					if (cell.accessType == CMOS_access) {
-						wlNewSwitchMatrix.CalculateLatency(1e20, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					} else {
-						wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					}
-					if (numColMuxed>1) {
-						mux.CalculateLatency(colRamp, 0, 1);
-						muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
-					}
-					if (SARADC) {
-						sarADC.CalculateLatency(1);
-					} else {
-						multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
-						multilevelSAEncoder.CalculateLatency(1e20, 1);
-					}				
-					if (CalculateclkFreq) {
-						readLatency += MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
-						readLatency += colDelay;
-						readLatency += multilevelSenseAmp.readLatency;
-						readLatency += multilevelSAEncoder.readLatency;
-						readLatency += sarADC.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default									
-					}
-				}
-				if (!CalculateclkFreq) {
-					if (numReadPulse > 1) {
-						shiftAdd.CalculateLatency(numColMuxed);	
-					}
-					if (param->synchronous) {
-						readLatencyADC = numColMuxed;
-					} else {
-						readLatencyADC = (multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency + colDelay) * numColMuxed * (validated==true? param->beta : 1);
-						readLatencyOther = MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
-					}
-					readLatencyAccum = shiftAdd.readLatency;
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}
-			} else if (BNNsequentialMode || XNORsequentialMode) {
-				double capBL = lengthCol * 0.2e-15/1e-6;
-				double colRamp = 0;
-				double tau = (capCol)*(cell.resMemCellAvg);
-				colDelay = horowitz(tau, 0, 1e20, &colRamp);
-				colDelay = tau * 0.2 ;  // assume the 15~20% voltage drop is enough for sensing
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				if (CalculateclkFreq || !param->synchronous) {
-					wlDecoder.CalculateLatency(1e20, capRow2, NULL, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					if (cell.accessType == CMOS_access) {
-						wlNewDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);	
-					} else {
-						wlDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow1, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					}
-					if (numColMuxed > 1) {
-						mux.CalculateLatency(colRamp, 0, 1);
-						muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
-					}
-					rowCurrentSenseAmp.CalculateLatency(columnResistance, 1, 1);
-					if (CalculateclkFreq) {
-						readLatency += MAX(wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
-						readLatency += colDelay;
-						readLatency += rowCurrentSenseAmp.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				}
-				if (!CalculateclkFreq) {
-					adder.CalculateLatency(1e20, dff.capTgDrain, numColMuxed*numRow*activityRowRead);
-					dff.CalculateLatency(1e20, numColMuxed*numRow*activityRowRead);
-					if (param->synchronous) {
-						readLatencyADC = numRow*activityRowRead*numColMuxed;
-						readLatencyAccum = adder.readLatency;
-					} else { 
-						readLatencyADC = (rowCurrentSenseAmp.readLatency + colDelay) * numRow*activityRowRead*numColMuxed * (validated==true? param->beta : 1);
-						readLatencyAccum = adder.readLatency + dff.readLatency;
-						readLatencyOther = MAX((wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency)*numRow*activityRowRead, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
-					}					
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}
-			} else if (BNNparallelMode || XNORparallelMode) {
-				double capBL = lengthCol * 0.2e-15/1e-6;
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				double colRamp = 0;
-				double tau = (capCol)*(cell.resMemCellAvg/(numRow/2));
-				colDelay = horowitz(tau, 0, 1e20, &colRamp);
-				colDelay = tau * 0.2;  // assume the 15~20% voltage drop is enough for sensing
-				if (CalculateclkFreq || !param->synchronous) {
-					if (cell.accessType == CMOS_access) {
-						wlNewSwitchMatrix.CalculateLatency(1e20, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					} else {
-						wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-					}
-					if (numColMuxed > 1) {
-						mux.CalculateLatency(colRamp, 0, 1);
-						muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
-					}
-					if (SARADC) {
-						sarADC.CalculateLatency(1);
-					} else {
-						multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
-						multilevelSAEncoder.CalculateLatency(1e20, 1);
-					}
-					if (CalculateclkFreq) {
-						readLatency += MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
-						readLatency += colDelay;
-						readLatency += multilevelSenseAmp.readLatency;
-						readLatency += multilevelSAEncoder.readLatency;
-						readLatency += sarADC.readLatency;
-						readLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
-					}
-				}
-				if (!CalculateclkFreq) {					
-					if (param->synchronous) {
-						readLatencyADC = numColMuxed;
-					} else { 
-						readLatencyADC = (multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency + colDelay) * numColMuxed * (validated==true? param->beta : 1);
-						readLatencyOther = MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
-					}					
-					readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
-				}
+			if (numColMuxed > 1) {
+				mux.CalculateLatency(0, 0, 1);
+				muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
+			}
+
+			// Read
+			double resPullDown = CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech);
+			double tau = (resCellAccess + resPullDown) * (capCellAccess + capCol) + resCol * capCol / 2;
+			tau *= log(tech.vdd / (tech.vdd - cell.minSenseVoltage / 2));
+			double gm = CalculateTransconductance(cell.widthAccessCMOS * tech.featureSize, NMOS, tech);
+			double beta = 1 / (resPullDown * gm);
+			double colRamp = 0;
+			colDelay = horowitz(tau, beta, wlSwitchMatrix.rampOutput, &colRamp);
+		}
+	} else if (cell.memCellType == Type::RRAM || cell.memCellType == Type::FeFET) {
+		if (conventionalSequential) {
+			double colRamp = 0;
+			double tau = (capCol)*(cell.resMemCellAvg);
+			colDelay = horowitz(tau, 0, 1e20, &colRamp);	// Just to generate colRamp
+			colDelay = tau * 0.2;  // assume the 15~20% voltage drop is enough for sensing
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			wlDecoder.CalculateLatency(1e20, capRow2, NULL, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			if (cell.accessType == CMOS_access) {
+				wlNewDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			} else {
+				wlDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow1, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			}
+			if (numColMuxed > 1) {
+				mux.CalculateLatency(colRamp, 0, 1);
+				muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
+			}
+			if (SARADC) {
+				sarADC.CalculateLatency(1);
+			} else if (avgWeightBit > 1) {
+				multilevelSAEncoder.CalculateLatency(1e20, 1);
+			}
+			if (numReadPulse > 1) {
+				shiftAdd.CalculateLatency(numColMuxed);	// There are numReadPulse times of shift-and-add
+			}
+		} else if (conventionalParallel) {
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			double colRamp = 0;
+			double tau = (capCol)*(cell.resMemCellAvg/(numRow/2));
+			colDelay = horowitz(tau, 0, 1e20, &colRamp);
+			colDelay = tau * 0.2;  // assume the 15~20% voltage drop is enough for sensing
+			if (cell.accessType == CMOS_access) {
+				wlNewSwitchMatrix.CalculateLatency(1e20, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			} else {
+				wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			}
+			if (numColMuxed>1) {
+				mux.CalculateLatency(colRamp, 0, 1);
+				muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
+			}
+			if (SARADC) {
+				sarADC.CalculateLatency(1);
+			} else {
+				multilevelSAEncoder.CalculateLatency(1e20, 1);
+			}
+			if (numReadPulse > 1) {
+				shiftAdd.CalculateLatency(numColMuxed);
+			}
+		} else if (BNNsequentialMode || XNORsequentialMode) {
+			double colRamp = 0;
+			double tau = (capCol)*(cell.resMemCellAvg);
+			colDelay = horowitz(tau, 0, 1e20, &colRamp);
+			colDelay = tau * 0.2 ;  // assume the 15~20% voltage drop is enough for sensing
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			wlDecoder.CalculateLatency(1e20, capRow2, NULL, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			if (cell.accessType == CMOS_access) {
+				wlNewDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			} else {
+				wlDecoderDriver.CalculateLatency(wlDecoder.rampOutput, capRow1, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			}
+			if (numColMuxed > 1) {
+				mux.CalculateLatency(colRamp, 0, 1);
+				muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
+			}
+		} else if (BNNparallelMode || XNORparallelMode) {
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			double colRamp = 0;
+			double tau = (capCol)*(cell.resMemCellAvg/(numRow/2));
+			colDelay = horowitz(tau, 0, 1e20, &colRamp);
+			colDelay = tau * 0.2;  // assume the 15~20% voltage drop is enough for sensing
+			if (cell.accessType == CMOS_access) {
+				wlNewSwitchMatrix.CalculateLatency(1e20, capRow2, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			} else {
+				wlSwitchMatrix.CalculateLatency(1e20, capRow1, resRow, 1, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			}
+			if (numColMuxed > 1) {
+				mux.CalculateLatency(colRamp, 0, 1);
+				muxDecoder.CalculateLatency(1e20, mux.capTgGateN*ceil(numCol/numColMuxed), mux.capTgGateP*ceil(numCol/numColMuxed), 1, 0);
+			}
+			if (SARADC) {
+				sarADC.CalculateLatency(1);
+			} else {
+				multilevelSAEncoder.CalculateLatency(1e20, 1);
+			}
+		}
+	}
+}
+
+void SubArray::PreparePower() {   //energy and leakage that do not depend on the read activity, the rest is left to CalculatePower
+	double numWriteOperationPerRow;   // average value (can be non-integer for energy calculation)
+	if (numCol * activityColWrite > numWriteCellPerOperationNeuro)
+		numWriteOperationPerRow = numCol * activityColWrite / numWriteCellPerOperationNeuro;
+	else
+		numWriteOperationPerRow = 1;
+
+	if (cell.memCellType == Type::SRAM) {
+
+		// Array leakage (assume 2 INV)
+		leakageArray = 0;
+		leakageArray += CalculateGateLeakage(INV, 1, cell.widthSRAMCellNMOS * tech.featureSize,
+				cell.widthSRAMCellPMOS * tech.featureSize, inputParameter.temperature, tech) * tech.vdd * 2;
+		leakageArray *= numRow * numCol;
+
+		if (conventionalSequential) {
+			sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
+		} else if (conventionalParallel) {
+			precharger.CalculatePower(numColMuxed, numWriteOperationPerRow*numRow*activityRowWrite);
+			sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
+			if (numColMuxed > 1) {
+				mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
+				muxDecoder.CalculatePower(numColMuxed, 1);
+			}
+			if (!SARADC) {
+				multilevelSAEncoder.CalculatePower(numColMuxed);
+			}
+			if (numReadPulse > 1) {
+				shiftAdd.CalculatePower(numColMuxed);
+			}
+		} else if (BNNsequentialMode || XNORsequentialMode) {
+			sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
+		} else if (BNNparallelMode || XNORparallelMode) {
+			precharger.CalculatePower(numColMuxed, numWriteOperationPerRow*numRow*activityRowWrite);
+			sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
+			if (!SARADC) {
+				multilevelSAEncoder.CalculatePower(numColMuxed);
+			}
+		}
+	} else if (cell.memCellType == Type::RRAM || cell.memCellType == Type::FeFET) {
+		if (conventionalSequential) {
+			if (numColMuxed > 1) {
+				mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
+				muxDecoder.CalculatePower(numColMuxed, 1);
+			}
+			if (numReadPulse > 1) {
+				shiftAdd.CalculatePower(numColMuxed);	// There are numReadPulse times of shift-and-add
+			}
+		} else if (conventionalParallel) {
+			if (numColMuxed > 1) {
+				mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
+				muxDecoder.CalculatePower(numColMuxed, 1);
+			}
+			if (!SARADC) {
+				multilevelSAEncoder.CalculatePower(numColMuxed);
+			}
+			if (numReadPulse > 1) {
+				shiftAdd.CalculatePower(numColMuxed);
+			}
+		} else if (BNNsequentialMode || XNORsequentialMode) {
+			if (numColMuxed > 1) {
+				mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
+				muxDecoder.CalculatePower(numColMuxed, 1);
+			}
+		} else if (BNNparallelMode || XNORparallelMode) {
+			if (numColMuxed > 1) {
+				mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
+				muxDecoder.CalculatePower(numColMuxed, 1);
+			}
+			if (!SARADC) {
+				multilevelSAEncoder.CalculatePower(numColMuxed);
+			}
+		}
+	}
+}
+
+void SubArray::CalculateLatency(double columnRes, const vector<double> &columnResistance) {   //calculate latency for different mode, the sensing cycle goes to sensingLatency in synchronous mode
+	if (!initialized) {
+		cout << "[Subarray] Error: Require initialization first!" << endl;
+	} else if (!prepared) {
+		cout << "[Subarray] Error: Require Prepare() first!" << endl;
+	} else {
+		(this->*readLatencyPath)(columnResistance);
+	}
+}
+
+template <bool sram, ReadMode mode, bool sar>
+void SubArray::ReadLatency(const vector<double> &columnResistance) {   //CalculateLatency for one cell type, read mode and ADC, the others are compiled out
+	readLatency = 0;
+	readLatencyADC = 0;
+	readLatencyAccum = 0;
+	readLatencyOther = 0;
+	writeLatency = 0;
+	sensingLatency = 0;
+
+	if constexpr (sram) {
+		if constexpr (mode == SEQUENTIAL_READ) {
+			int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
+			if (param->synchronous) {
+				sensingLatency += wlDecoder.readLatency;
+				sensingLatency += precharger.readLatency;
+				sensingLatency += colDelay;
+				sensingLatency += senseAmp.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
+			} 
+			adder.CalculateLatency(1e20, dff.capTgDrain, numReadOperationPerRow*numRow*activityRowRead);
+			dff.CalculateLatency(1e20, numReadOperationPerRow*numRow*activityRowRead);
+			
+			if (param->synchronous) {
+				readLatencyADC = numReadOperationPerRow*numRow*activityRowRead;
+				readLatencyAccum = adder.readLatency + shiftAdd.readLatency;
+			} else {
+				readLatencyADC = (precharger.readLatency + colDelay + senseAmp.readLatency) * numReadOperationPerRow*numRow*activityRowRead * (validated==true? param->beta : 1);;
+				readLatencyAccum = adder.readLatency + dff.readLatency + shiftAdd.readLatency;
+				readLatencyOther = wlDecoder.readLatency * numRow*activityRowRead * (validated==true? param->beta : 1);;
+			}
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+				// // Write (assume the average delay of pullup and pulldown inverter in SRAM cell)
+				// double resPull;
+				// resPull = (CalculateOnResistance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, inputParameter.temperature, tech) + CalculateOnResistance(cell.widthSRAMCellPMOS * tech.featureSize, PMOS, inputParameter.temperature, tech)) / 2;    // take average
+				// tau = resPull * cell.capSRAMCell;
+				// gm = (CalculateTransconductance(cell.widthSRAMCellNMOS * tech.featureSize, NMOS, tech) + CalculateTransconductance(cell.widthSRAMCellPMOS * tech.featureSize, PMOS, tech)) / 2;   // take average
+				// beta = 1 / (resPull * gm);
+				// sramWriteDriver.CalculateLatency(1e20, capCol, resCol, numWriteOperationPerRow*numRow*activityRowWrite);
+				// // writeLatency += horowitz(tau, beta, 1e20, NULL) * numWriteOperationPerRow * numRow * activityRowWrite;
+				// // writeLatency += wlDecoder.writeLatency;
+				// // writeLatency += precharger.writeLatency;
+				// // writeLatency += sramWriteDriver.writeLatency;
+		} else if constexpr (mode == PARALLEL_READ) {
+			int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
+			if constexpr (!sar) {
+				multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
+			}
+			if (param->synchronous) {
+				sensingLatency += MAX(wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0) );
+				sensingLatency += precharger.readLatency;
+				sensingLatency += colDelay;
+				sensingLatency += multilevelSenseAmp.readLatency;
+				sensingLatency += multilevelSAEncoder.readLatency;
+				sensingLatency += sarADC.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
+			}
+			if (param->synchronous) {
+				readLatencyADC = numColMuxed;
+			} else {
+				readLatencyADC = (precharger.readLatency + colDelay + multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency) * numColMuxed * (validated==true? param->beta : 1);;
+				readLatencyOther = MAX(wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0) ) * numColMuxed * (validated==true? param->beta : 1);;
+			}
+			readLatencyAccum = shiftAdd.readLatency;
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+		} else if constexpr (mode == BNN_SEQUENTIAL_READ) {
+			int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
+			if (param->synchronous) {
+				sensingLatency += wlDecoder.readLatency;
+				sensingLatency += precharger.readLatency;
+				sensingLatency += colDelay;
+				sensingLatency += senseAmp.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
+			}
+			adder.CalculateLatency(1e20, dff.capTgDrain, numReadOperationPerRow*numRow*activityRowRead);
+			dff.CalculateLatency(1e20, numReadOperationPerRow*numRow*activityRowRead);
+			if (param->synchronous) {
+				readLatencyADC = numReadOperationPerRow*numRow*activityRowRead;
+				readLatencyAccum = adder.readLatency;
+			} else {
+				readLatencyADC = (precharger.readLatency + colDelay + senseAmp.readLatency) * numReadOperationPerRow*numRow*activityRowRead * (validated==true? param->beta : 1);;
+				readLatencyAccum = adder.readLatency + dff.readLatency;
+				readLatencyOther = wlDecoder.readLatency * numRow*activityRowRead * (validated==true? param->beta : 1);;
+			}				
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+		} else if constexpr (mode == BNN_PARALLEL_READ) {
+			int numReadOperationPerRow = (int)ceil((double)numCol/numReadCellPerOperationNeuro);
+			if constexpr (!sar) {
+				multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
+			}
+			if (param->synchronous) {
+				sensingLatency += wlSwitchMatrix.readLatency;
+				sensingLatency += precharger.readLatency;
+				sensingLatency += colDelay;
+				sensingLatency += multilevelSenseAmp.readLatency;
+				sensingLatency += multilevelSAEncoder.readLatency;
+				sensingLatency += sarADC.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
+			}
+			if (param->synchronous) {
+				readLatencyADC = numColMuxed;
+			} else {
+				readLatencyADC = (precharger.readLatency + colDelay + multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency) * numColMuxed * (validated==true? param->beta : 1);;
+				readLatencyOther = MAX(wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0) ) * numColMuxed * (validated==true? param->beta : 1);;
 			}
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+		}
+    } else {
+		if constexpr (mode == SEQUENTIAL_READ) {
+			if constexpr (!sar) {
+				multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
+			}					
+			if (param->synchronous) {
+				sensingLatency += MAX(wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
+				sensingLatency += colDelay;
+				sensingLatency += multilevelSenseAmp.readLatency;
+				sensingLatency += multilevelSAEncoder.readLatency;
+				sensingLatency += sarADC.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);		// latency factor of sensing cycle, beta = 1.4 by default
+			}
+			adder.CalculateLatency(1e20, dff.capTgDrain, numColMuxed*numRow*activityRowRead);
+			dff.CalculateLatency(1e20, numColMuxed*numRow*activityRowRead);
+			if (param->synchronous) {
+				readLatencyADC = numRow*activityRowRead*numColMuxed;
+				readLatencyAccum = adder.readLatency + shiftAdd.readLatency;
+			} else {
+				readLatencyADC = (multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency + colDelay) * (numRow*activityRowRead*numColMuxed) * (validated==true? param->beta : 1);
+				readLatencyAccum = adder.readLatency + dff.readLatency + shiftAdd.readLatency;	
+				readLatencyOther = MAX((wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency)*numRow*activityRowRead, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
+			}
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+				// // Write
+				// wllevelshifter.CalculateLatency(1e20, 2*wlNewDecoderDriver.capTgDrain, wlNewDecoderDriver.resTg, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+				// bllevelshifter.CalculateLatency(1e20, 2*wlNewDecoderDriver.capTgDrain, wlNewDecoderDriver.resTg, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+				// sllevelshifter.CalculateLatency(1e20, 2*slSwitchMatrix.capTgDrain, slSwitchMatrix.resTg, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+				// slSwitchMatrix.CalculateLatency(1e20, capCol, resCol, 0, 2*numWriteOperationPerRow*numRow*activityRowWrite); 
+				// writeLatencyArray = numWritePulse * param->writePulseWidthLTP + (-numErasePulse) * param->writePulseWidthLTD;
+				// writeLatency += MAX(wlDecoder.writeLatency + wlNewDecoderDriver.writeLatency + wlDecoderDriver.writeLatency, sllevelshifter.writeLatency + slSwitchMatrix.writeLatency + bllevelshifter.writeLatency);
+				// writeLatency += writeLatencyArray;
+				
+		} else if constexpr (mode == PARALLEL_READ) {
+			if constexpr (!sar) {
+				multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
+			}				
+			if (param->synchronous) {
+				sensingLatency += MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
+				sensingLatency += colDelay;
+				sensingLatency += multilevelSenseAmp.readLatency;
+				sensingLatency += multilevelSAEncoder.readLatency;
+				sensingLatency += sarADC.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default									
+			}
+			if (param->synchronous) {
+				readLatencyADC = numColMuxed;
+			} else {
+				readLatencyADC = (multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency + colDelay) * numColMuxed * (validated==true? param->beta : 1);
+				readLatencyOther = MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
+			}
+			readLatencyAccum = shiftAdd.readLatency;
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+		} else if constexpr (mode == BNN_SEQUENTIAL_READ) {
+			rowCurrentSenseAmp.CalculateLatency(columnResistance, 1, 1);
+			if (param->synchronous) {
+				sensingLatency += MAX(wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
+				sensingLatency += colDelay;
+				sensingLatency += rowCurrentSenseAmp.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
+			}
+			adder.CalculateLatency(1e20, dff.capTgDrain, numColMuxed*numRow*activityRowRead);
+			dff.CalculateLatency(1e20, numColMuxed*numRow*activityRowRead);
+			if (param->synchronous) {
+				readLatencyADC = numRow*activityRowRead*numColMuxed;
+				readLatencyAccum = adder.readLatency;
+			} else { 
+				readLatencyADC = (rowCurrentSenseAmp.readLatency + colDelay) * numRow*activityRowRead*numColMuxed * (validated==true? param->beta : 1);
+				readLatencyAccum = adder.readLatency + dff.readLatency;
+				readLatencyOther = MAX((wlDecoder.readLatency + wlNewDecoderDriver.readLatency + wlDecoderDriver.readLatency)*numRow*activityRowRead, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
+			}					
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
+		} else if constexpr (mode == BNN_PARALLEL_READ) {
+			if constexpr (!sar) {
+				multilevelSenseAmp.CalculateLatency(columnResistance, 1, 1);
+			}
+			if (param->synchronous) {
+				sensingLatency += MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0));
+				sensingLatency += colDelay;
+				sensingLatency += multilevelSenseAmp.readLatency;
+				sensingLatency += multilevelSAEncoder.readLatency;
+				sensingLatency += sarADC.readLatency;
+				sensingLatency *= (validated==true? param->beta : 1);	// latency factor of sensing cycle, beta = 1.4 by default
+			}
+			if (param->synchronous) {
+				readLatencyADC = numColMuxed;
+			} else { 
+				readLatencyADC = (multilevelSenseAmp.readLatency + multilevelSAEncoder.readLatency + sarADC.readLatency + colDelay) * numColMuxed * (validated==true? param->beta : 1);
+				readLatencyOther = MAX(wlNewSwitchMatrix.readLatency + wlSwitchMatrix.readLatency, ((numColMuxed > 1)==true? (mux.readLatency+muxDecoder.readLatency):0)) * numColMuxed * (validated==true? param->beta : 1);
+			}					
+			readLatency = readLatencyADC + readLatencyAccum + readLatencyOther;
 		}
 	}
 }
@@ -946,471 +1038,467 @@ void SubArray::CalculateLatency(double columnRes, const vector<double> &columnRe
 void SubArray::CalculatePower(const vector<double> &columnResistance) {
 	if (!initialized) {
 		cout << "[Subarray] Error: Require initialization first!" << endl;
+	} else if (!prepared) {
+		cout << "[Subarray] Error: Require Prepare() first!" << endl;
 	} else {
-		readDynamicEnergy = 0;
-		writeDynamicEnergy = 0;
-		readDynamicEnergyArray = 0;
+		(this->*readPowerPath)(columnResistance);
+	}
+}
+
+template <bool sram, ReadMode mode, bool sar>
+void SubArray::ReadPower(const vector<double> &columnResistance) {   //CalculatePower for one cell type, read mode and ADC, the others are compiled out
+	readDynamicEnergy = 0;
+	writeDynamicEnergy = 0;
+	readDynamicEnergyArray = 0;
+	
+	double numReadOperationPerRow;   // average value (can be non-integer for energy calculation)
+	if (numCol > numReadCellPerOperationNeuro)
+		numReadOperationPerRow = numCol / numReadCellPerOperationNeuro;
+	else
+		numReadOperationPerRow = 1;
+
+	double numWriteOperationPerRow;   // average value (can be non-integer for energy calculation)
+	if (numCol * activityColWrite > numWriteCellPerOperationNeuro)
+		numWriteOperationPerRow = numCol * activityColWrite / numWriteCellPerOperationNeuro;
+	else
+		numWriteOperationPerRow = 1;
+
+	if constexpr (sram) {
 		
-		double numReadOperationPerRow;   // average value (can be non-integer for energy calculation)
-		if (numCol > numReadCellPerOperationNeuro)
-			numReadOperationPerRow = numCol / numReadCellPerOperationNeuro;
-		else
-			numReadOperationPerRow = 1;
+		// Array leakage (assume 2 INV)
+		leakage = leakageArray;
 
-		double numWriteOperationPerRow;   // average value (can be non-integer for energy calculation)
-		if (numCol * activityColWrite > numWriteCellPerOperationNeuro)
-			numWriteOperationPerRow = numCol * activityColWrite / numWriteCellPerOperationNeuro;
-		else
-			numWriteOperationPerRow = 1;
+		if constexpr (mode == SEQUENTIAL_READ) {
+			wlDecoder.CalculatePower(numRow*activityRowRead, numRow*activityRowWrite);
+			precharger.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numWriteOperationPerRow*numRow*activityRowWrite);
+			adder.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse);				
+			dff.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse*(adder.numBit+1), param->validated);
+			senseAmp.CalculatePower(numReadOperationPerRow*numRow*activityRowRead);
+			if (numReadPulse > 1) {
+				shiftAdd.CalculatePower(numReadOperationPerRow*numRow*activityRowRead);
+			}
+			// Array
+			readDynamicEnergyArray = 0; // Just BL discharging
+			writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
 
-		if (cell.memCellType == Type::SRAM) {
+			// Read
+			readDynamicEnergy += wlDecoder.readDynamicEnergy;
+			readDynamicEnergy += precharger.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += adder.readDynamicEnergy;
+			readDynamicEnergy += dff.readDynamicEnergy;
+			readDynamicEnergy += senseAmp.readDynamicEnergy;
+			readDynamicEnergy += shiftAdd.readDynamicEnergy;
 			
-			// Array leakage (assume 2 INV)
-			leakage = 0;
-			leakage += CalculateGateLeakage(INV, 1, cell.widthSRAMCellNMOS * tech.featureSize,
-					cell.widthSRAMCellPMOS * tech.featureSize, inputParameter.temperature, tech) * tech.vdd * 2;
-			leakage *= numRow * numCol;
+			readDynamicEnergyADC = precharger.readDynamicEnergy + readDynamicEnergyArray + senseAmp.readDynamicEnergy;
+			readDynamicEnergyAccum = adder.readDynamicEnergy + dff.readDynamicEnergy + shiftAdd.readDynamicEnergy;
+			readDynamicEnergyOther = wlDecoder.readDynamicEnergy;
 
-			if (conventionalSequential) {
-				wlDecoder.CalculatePower(numRow*activityRowRead, numRow*activityRowWrite);
-				precharger.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numWriteOperationPerRow*numRow*activityRowWrite);
-				sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
-				adder.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse);				
-				dff.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse*(adder.numBit+1), param->validated);
-				senseAmp.CalculatePower(numReadOperationPerRow*numRow*activityRowRead);
-				if (numReadPulse > 1) {
-					shiftAdd.CalculatePower(numReadOperationPerRow*numRow*activityRowRead);
-				}
-				// Array
-				readDynamicEnergyArray = 0; // Just BL discharging
-				writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
+			// Write
+			// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
+			// writeDynamicEnergy += precharger.writeDynamicEnergy;
+			// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;
+			
+			// Leakage
+			leakage += wlDecoder.leakage;
+			leakage += precharger.leakage;
+			leakage += sramWriteDriver.leakage;
+			leakage += senseAmp.leakage;
+			leakage += dff.leakage;
+			leakage += adder.leakage;
+			leakage += shiftAdd.leakage;
 
-				// Read
-				readDynamicEnergy += wlDecoder.readDynamicEnergy;
-				readDynamicEnergy += precharger.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += adder.readDynamicEnergy;
-				readDynamicEnergy += dff.readDynamicEnergy;
-				readDynamicEnergy += senseAmp.readDynamicEnergy;
-				readDynamicEnergy += shiftAdd.readDynamicEnergy;
-				
-				readDynamicEnergyADC = precharger.readDynamicEnergy + readDynamicEnergyArray + senseAmp.readDynamicEnergy;
-				readDynamicEnergyAccum = adder.readDynamicEnergy + dff.readDynamicEnergy + shiftAdd.readDynamicEnergy;
-				readDynamicEnergyOther = wlDecoder.readDynamicEnergy;
+		} else if constexpr (mode == PARALLEL_READ) {
+			wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			if constexpr (sar) {
+				sarADC.CalculatePower(columnResistance, 1);
+			} else {
+				multilevelSenseAmp.CalculatePower(columnResistance, 1);
+			}
+			// Array
+			readDynamicEnergyArray = 0; // Just BL discharging
+			writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
+			// Read
+			readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
+			readDynamicEnergy += precharger.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
+			readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
+			readDynamicEnergy += ((numColMuxed > 1)==true? (mux.readDynamicEnergy/numReadPulse):0);
+			readDynamicEnergy += ((numColMuxed > 1)==true? (muxDecoder.readDynamicEnergy/numReadPulse):0);
+			readDynamicEnergy += shiftAdd.readDynamicEnergy;
+			readDynamicEnergy += sarADC.readDynamicEnergy;
 
-				// Write
-				// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
-				// writeDynamicEnergy += precharger.writeDynamicEnergy;
-				// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;
-				
-				// Leakage
-				leakage += wlDecoder.leakage;
-				leakage += precharger.leakage;
-				leakage += sramWriteDriver.leakage;
-				leakage += senseAmp.leakage;
-				leakage += dff.leakage;
-				leakage += adder.leakage;
-				leakage += shiftAdd.leakage;
+			readDynamicEnergyADC = precharger.readDynamicEnergy + readDynamicEnergyArray + multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy + sarADC.readDynamicEnergy;				
+			readDynamicEnergyAccum = shiftAdd.readDynamicEnergy;
+			readDynamicEnergyOther = wlSwitchMatrix.readDynamicEnergy + ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			
+			// Write
+			// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += precharger.writeDynamicEnergy;
+			// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;				
+			
+			// Leakage
+			leakage += wlSwitchMatrix.leakage;
+			leakage += precharger.leakage;
+			leakage += sramWriteDriver.leakage;
+			leakage += multilevelSenseAmp.leakage;
+			leakage += multilevelSAEncoder.leakage;
+			leakage += shiftAdd.leakage;
+		
+		} else if constexpr (mode == BNN_SEQUENTIAL_READ) {
+			wlDecoder.CalculatePower(numRow*activityRowRead, numRow*activityRowWrite);
+			precharger.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numWriteOperationPerRow*numRow*activityRowWrite);
+			adder.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse);				
+			dff.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse*(adder.numBit+1), param->validated);
+			senseAmp.CalculatePower(numReadOperationPerRow*numRow*activityRowRead);
+			
+			// Array
+			readDynamicEnergyArray = 0; // Just BL discharging
+			writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
 
-			} else if (conventionalParallel) {
-				wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				precharger.CalculatePower(numColMuxed, numWriteOperationPerRow*numRow*activityRowWrite);
-				sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
-				if (numColMuxed > 1) {
-					mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
-					muxDecoder.CalculatePower(numColMuxed, 1);
-				}
-				if (SARADC) {
-					sarADC.CalculatePower(columnResistance, 1);
-				} else {
-					multilevelSenseAmp.CalculatePower(columnResistance, 1);
-					multilevelSAEncoder.CalculatePower(numColMuxed);
-				}
-				if (numReadPulse > 1) {
-					shiftAdd.CalculatePower(numColMuxed);
+			// Read
+			readDynamicEnergy += wlDecoder.readDynamicEnergy;
+			readDynamicEnergy += precharger.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += adder.readDynamicEnergy;
+			readDynamicEnergy += dff.readDynamicEnergy;
+			readDynamicEnergy += senseAmp.readDynamicEnergy;
+			
+			// Write				
+			// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
+			// writeDynamicEnergy += precharger.writeDynamicEnergy;
+			// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;				
+			
+			// Leakage
+			leakage += wlDecoder.leakage;
+			leakage += precharger.leakage;
+			leakage += sramWriteDriver.leakage;
+			leakage += senseAmp.leakage;
+			leakage += dff.leakage;
+			leakage += adder.leakage;
+			
+		} else if constexpr (mode == BNN_PARALLEL_READ) {
+			wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			if constexpr (sar) {
+				sarADC.CalculatePower(columnResistance, 1);
+			} else {
+				multilevelSenseAmp.CalculatePower(columnResistance, 1);
+			}
+			
+			// Array
+			readDynamicEnergyArray = 0; // Just BL discharging
+			writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
+			// Read
+			readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
+			readDynamicEnergy += precharger.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
+			readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
+			readDynamicEnergy += sarADC.readDynamicEnergy;
+			
+			// Write				
+			// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += precharger.writeDynamicEnergy;
+			// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;				
+			
+			// Leakage
+			leakage += wlSwitchMatrix.leakage;
+			leakage += precharger.leakage;
+			leakage += sramWriteDriver.leakage;
+			leakage += multilevelSenseAmp.leakage;
+			leakage += multilevelSAEncoder.leakage;
+			
+		}		
+    } else {
+		if constexpr (mode == SEQUENTIAL_READ) {
+			double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
+			double numWriteCells = (int)ceil((double)numCol/*numWriteColMuxed*/); 
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			double capBL = lengthCol * 0.2e-15/1e-6;
+
+			wlDecoder.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			if (cell.accessType == CMOS_access) {
+				wlNewDecoderDriver.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			} else {
+				wlDecoderDriver.CalculatePower(numReadCells, numWriteCells, numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			}
+			slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			if constexpr (sar) {
+				sarADC.CalculatePower(columnResistance, numRow*activityRowRead);
+			} else {
+				multilevelSenseAmp.CalculatePower(columnResistance, numRow*activityRowRead);
+				if (avgWeightBit > 1) {
+					multilevelSAEncoder.CalculatePower(numRow*activityRowRead*numColMuxed);
 				}
-				// Array
-				readDynamicEnergyArray = 0; // Just BL discharging
-				writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
-				// Read
-				readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
-				readDynamicEnergy += precharger.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
-				readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
-				readDynamicEnergy += ((numColMuxed > 1)==true? (mux.readDynamicEnergy/numReadPulse):0);
-				readDynamicEnergy += ((numColMuxed > 1)==true? (muxDecoder.readDynamicEnergy/numReadPulse):0);
-				readDynamicEnergy += shiftAdd.readDynamicEnergy;
-				readDynamicEnergy += sarADC.readDynamicEnergy;
+			}
+			adder.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells);
+			dff.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells*(adder.numBit+1), param->validated); 
+			// Read
+			readDynamicEnergyArray = 0;
+			readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
+			readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd; // Selected WL
+			readDynamicEnergyArray *= numRow * activityRowRead * numColMuxed;
 
-				readDynamicEnergyADC = precharger.readDynamicEnergy + readDynamicEnergyArray + multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy + sarADC.readDynamicEnergy;				
-				readDynamicEnergyAccum = shiftAdd.readDynamicEnergy;
-				readDynamicEnergyOther = wlSwitchMatrix.readDynamicEnergy + ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
-				
-				// Write
-				// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += precharger.writeDynamicEnergy;
-				// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;				
-				
-				// Leakage
-				leakage += wlSwitchMatrix.leakage;
-				leakage += precharger.leakage;
-				leakage += sramWriteDriver.leakage;
-				leakage += multilevelSenseAmp.leakage;
-				leakage += multilevelSAEncoder.leakage;
-				leakage += shiftAdd.leakage;
+			readDynamicEnergy = 0;
+			readDynamicEnergy += wlDecoder.readDynamicEnergy;
+			readDynamicEnergy += wlNewDecoderDriver.readDynamicEnergy;
+			readDynamicEnergy += wlDecoderDriver.readDynamicEnergy;
+			readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			readDynamicEnergy += adder.readDynamicEnergy;
+			readDynamicEnergy += dff.readDynamicEnergy;
+			readDynamicEnergy += shiftAdd.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy;
+			readDynamicEnergy += sarADC.readDynamicEnergy;
 			
-			} else if (BNNsequentialMode || XNORsequentialMode) {
-				wlDecoder.CalculatePower(numRow*activityRowRead, numRow*activityRowWrite);
-				precharger.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numWriteOperationPerRow*numRow*activityRowWrite);
-				sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
-				adder.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse);				
-				dff.CalculatePower(numReadOperationPerRow*numRow*activityRowRead, numReadCellPerOperationNeuro/numCellPerSynapse*(adder.numBit+1), param->validated);
-				senseAmp.CalculatePower(numReadOperationPerRow*numRow*activityRowRead);
-				
-				// Array
-				readDynamicEnergyArray = 0; // Just BL discharging
-				writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
+			readDynamicEnergyADC = readDynamicEnergyArray + multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy + sarADC.readDynamicEnergy;
+			readDynamicEnergyAccum = adder.readDynamicEnergy + dff.readDynamicEnergy + shiftAdd.readDynamicEnergy;
+			readDynamicEnergyOther = wlDecoder.readDynamicEnergy + wlNewDecoderDriver.readDynamicEnergy + wlDecoderDriver.readDynamicEnergy + ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
 
-				// Read
-				readDynamicEnergy += wlDecoder.readDynamicEnergy;
-				readDynamicEnergy += precharger.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += adder.readDynamicEnergy;
-				readDynamicEnergy += dff.readDynamicEnergy;
-				readDynamicEnergy += senseAmp.readDynamicEnergy;
-				
-				// Write				
-				// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
-				// writeDynamicEnergy += precharger.writeDynamicEnergy;
-				// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;				
-				
-				// Leakage
-				leakage += wlDecoder.leakage;
-				leakage += precharger.leakage;
-				leakage += sramWriteDriver.leakage;
-				leakage += senseAmp.leakage;
-				leakage += dff.leakage;
-				leakage += adder.leakage;
+			// Write					
+			// writeDynamicEnergyArray = writeDynamicEnergyArray;
+			// writeDynamicEnergy = 0;
+			// if (cell.writeVoltage > 1.5) {
+				// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);	
+				// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy; 
+			// }
+			// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
+			// writeDynamicEnergy += wlNewDecoderDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += wlDecoderDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;
+			
+			// Leakage
+			leakage = 0;
+			leakage += wlDecoder.leakage;
+			leakage += wlDecoderDriver.leakage;
+			leakage += wlNewDecoderDriver.leakage;
+			leakage += slSwitchMatrix.leakage;
+			leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
+			leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
+			leakage += multilevelSenseAmp.leakage;
+			leakage += multilevelSAEncoder.leakage;
+			leakage += dff.leakage;
+			leakage += adder.leakage;
+			leakage += shiftAdd.leakage;
 				
-			} else if (BNNparallelMode || XNORparallelMode) {
+		} else if constexpr (mode == PARALLEL_READ) {
+			double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			double capBL = lengthCol * 0.2e-15/1e-6;
+		
+			if (cell.accessType == CMOS_access) {
+				wlNewSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+			} else {
 				wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				precharger.CalculatePower(numColMuxed, numWriteOperationPerRow*numRow*activityRowWrite);
-				sramWriteDriver.CalculatePower(numWriteOperationPerRow*numRow*activityRowWrite);
-				if (SARADC) {
-					sarADC.CalculatePower(columnResistance, 1);
-				} else {
-					multilevelSenseAmp.CalculatePower(columnResistance, 1);
-					multilevelSAEncoder.CalculatePower(numColMuxed);
-				}
-				
-				// Array
-				readDynamicEnergyArray = 0; // Just BL discharging
-				writeDynamicEnergyArray = cell.capSRAMCell * tech.vdd * tech.vdd * 2 * numCol * activityColWrite * numRow * activityRowWrite;    // flip Q and Q_bar
-				// Read
-				readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
-				readDynamicEnergy += precharger.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
-				readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
-				readDynamicEnergy += sarADC.readDynamicEnergy;
-				
-				// Write				
-				// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += precharger.writeDynamicEnergy;
-				// writeDynamicEnergy += sramWriteDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;				
-				
-				// Leakage
-				leakage += wlSwitchMatrix.leakage;
-				leakage += precharger.leakage;
-				leakage += sramWriteDriver.leakage;
-				leakage += multilevelSenseAmp.leakage;
-				leakage += multilevelSAEncoder.leakage;
-				
-			}		
-	    } else if (cell.memCellType == Type::RRAM || cell.memCellType == Type::FeFET) {
-			if (conventionalSequential) {
-				double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
-				double numWriteCells = (int)ceil((double)numCol/*numWriteColMuxed*/); 
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				double capBL = lengthCol * 0.2e-15/1e-6;
-
-				wlDecoder.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-				if (cell.accessType == CMOS_access) {
-					wlNewDecoderDriver.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-				} else {
-					wlDecoderDriver.CalculatePower(numReadCells, numWriteCells, numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-				}
-				slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				if (numColMuxed > 1) {
-					mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
-					muxDecoder.CalculatePower(numColMuxed, 1);
-				}
-				if (SARADC) {
-					sarADC.CalculatePower(columnResistance, numRow*activityRowRead);
-				} else {
-					multilevelSenseAmp.CalculatePower(columnResistance, numRow*activityRowRead);
-					if (avgWeightBit > 1) {
-						multilevelSAEncoder.CalculatePower(numRow*activityRowRead*numColMuxed);
-					}
-				}
-				adder.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells);
-				dff.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells*(adder.numBit+1), param->validated); 
-				if (numReadPulse > 1) {
-					shiftAdd.CalculatePower(numColMuxed);	// There are numReadPulse times of shift-and-add
-				}
-				// Read
-				readDynamicEnergyArray = 0;
-				readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
-				readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd; // Selected WL
-				readDynamicEnergyArray *= numRow * activityRowRead * numColMuxed;
+			}
+			slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			if constexpr (sar) {
+				sarADC.CalculatePower(columnResistance, 1);
+			} else {
+				multilevelSenseAmp.CalculatePower(columnResistance, 1);
+			}
+			// Read
+			readDynamicEnergyArray = 0;
+			readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
+			readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd * numRow * activityRowRead; // Selected WL
+			readDynamicEnergyArray *= numColMuxed;
+			
+			readDynamicEnergy = 0;
+			readDynamicEnergy += wlNewSwitchMatrix.readDynamicEnergy;
+			readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
+			readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
+			readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
+			readDynamicEnergy += shiftAdd.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += sarADC.readDynamicEnergy;
+			
+			readDynamicEnergyADC = readDynamicEnergyArray + multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy + sarADC.readDynamicEnergy;
+			readDynamicEnergyAccum = shiftAdd.readDynamicEnergy;
+			readDynamicEnergyOther = wlNewSwitchMatrix.readDynamicEnergy + wlSwitchMatrix.readDynamicEnergy + ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			
+			// Write				
+			// writeDynamicEnergyArray = writeDynamicEnergyArray;
+			// writeDynamicEnergy = 0;
+			// if (cell.writeVoltage > 1.5) {
+				// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy;
+			// }
+			// writeDynamicEnergy += wlNewSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;				
+			
+			// Leakage
+			leakage = 0;
+			leakage += wlSwitchMatrix.leakage;
+			leakage += wlNewSwitchMatrix.leakage;
+			leakage += slSwitchMatrix.leakage;
+			leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
+			leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
+			leakage += multilevelSenseAmp.leakage;
+			leakage += multilevelSAEncoder.leakage;
+			leakage += shiftAdd.leakage;
+			
+		} else if constexpr (mode == BNN_SEQUENTIAL_READ) {
+			double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
+			double numWriteCells = (int)ceil((double)numCol/*numWriteColMuxed*/); 
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			double capBL = lengthCol * 0.2e-15/1e-6;
+		
+			wlDecoder.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			if (cell.accessType == CMOS_access) {
+				wlNewDecoderDriver.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			} else {
+				wlDecoderDriver.CalculatePower(numReadCells, numWriteCells, numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
+			}
+			slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			rowCurrentSenseAmp.CalculatePower(columnResistance, numRow*activityRowRead);
+			adder.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells);
+			dff.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells*(adder.numBit+1), param->validated); 
+			
+			// Read
+			readDynamicEnergyArray = 0;
+			readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
+			readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd; // Selected WL
+			readDynamicEnergyArray *= numRow * activityRowRead * numColMuxed;
 
-				readDynamicEnergy = 0;
-				readDynamicEnergy += wlDecoder.readDynamicEnergy;
-				readDynamicEnergy += wlNewDecoderDriver.readDynamicEnergy;
-				readDynamicEnergy += wlDecoderDriver.readDynamicEnergy;
-				readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
-				readDynamicEnergy += adder.readDynamicEnergy;
-				readDynamicEnergy += dff.readDynamicEnergy;
-				readDynamicEnergy += shiftAdd.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy;
-				readDynamicEnergy += sarADC.readDynamicEnergy;
-				
-				readDynamicEnergyADC = readDynamicEnergyArray + multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy + sarADC.readDynamicEnergy;
-				readDynamicEnergyAccum = adder.readDynamicEnergy + dff.readDynamicEnergy + shiftAdd.readDynamicEnergy;
-				readDynamicEnergyOther = wlDecoder.readDynamicEnergy + wlNewDecoderDriver.readDynamicEnergy + wlDecoderDriver.readDynamicEnergy + ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			readDynamicEnergy = 0;
+			readDynamicEnergy += wlDecoder.readDynamicEnergy;
+			readDynamicEnergy += wlNewDecoderDriver.readDynamicEnergy;
+			readDynamicEnergy += wlDecoderDriver.readDynamicEnergy;
+			readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			readDynamicEnergy += rowCurrentSenseAmp.readDynamicEnergy;
+			readDynamicEnergy += adder.readDynamicEnergy;
+			readDynamicEnergy += dff.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
 
-				// Write					
-				// writeDynamicEnergyArray = writeDynamicEnergyArray;
-				// writeDynamicEnergy = 0;
-				// if (cell.writeVoltage > 1.5) {
-					// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);	
-					// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy; 
-				// }
-				// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
-				// writeDynamicEnergy += wlNewDecoderDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += wlDecoderDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;
-				
-				// Leakage
-				leakage = 0;
-				leakage += wlDecoder.leakage;
-				leakage += wlDecoderDriver.leakage;
-				leakage += wlNewDecoderDriver.leakage;
-				leakage += slSwitchMatrix.leakage;
-				leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
-				leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
-				leakage += multilevelSenseAmp.leakage;
-				leakage += multilevelSAEncoder.leakage;
-				leakage += dff.leakage;
-				leakage += adder.leakage;
-				leakage += shiftAdd.leakage;
-					
-			} else if (conventionalParallel) {
-				double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				double capBL = lengthCol * 0.2e-15/1e-6;
+			// Write				
+			// writeDynamicEnergyArray = writeDynamicEnergyArray;
+			// writeDynamicEnergy = 0;
+			// if (cell.writeVoltage > 1.5) {
+				// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy;
+			// }
+			// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
+			// writeDynamicEnergy += wlNewDecoderDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += wlDecoderDriver.writeDynamicEnergy;
+			// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;				
 			
-				if (cell.accessType == CMOS_access) {
-					wlNewSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-				} else {
-					wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				}
-				slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				if (numColMuxed > 1) {
-					mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
-					muxDecoder.CalculatePower(numColMuxed, 1);
-				}
-				if (SARADC) {
-					sarADC.CalculatePower(columnResistance, 1);
-				} else {
-					multilevelSenseAmp.CalculatePower(columnResistance, 1);
-					multilevelSAEncoder.CalculatePower(numColMuxed);
-				}
-				if (numReadPulse > 1) {
-					shiftAdd.CalculatePower(numColMuxed);
-				}
-				// Read
-				readDynamicEnergyArray = 0;
-				readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
-				readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd * numRow * activityRowRead; // Selected WL
-				readDynamicEnergyArray *= numColMuxed;
-				
-				readDynamicEnergy = 0;
-				readDynamicEnergy += wlNewSwitchMatrix.readDynamicEnergy;
-				readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
-				readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
-				readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
-				readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
-				readDynamicEnergy += shiftAdd.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += sarADC.readDynamicEnergy;
-				
-				readDynamicEnergyADC = readDynamicEnergyArray + multilevelSenseAmp.readDynamicEnergy + multilevelSAEncoder.readDynamicEnergy + sarADC.readDynamicEnergy;
-				readDynamicEnergyAccum = shiftAdd.readDynamicEnergy;
-				readDynamicEnergyOther = wlNewSwitchMatrix.readDynamicEnergy + wlSwitchMatrix.readDynamicEnergy + ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
-				
-				// Write				
-				// writeDynamicEnergyArray = writeDynamicEnergyArray;
-				// writeDynamicEnergy = 0;
-				// if (cell.writeVoltage > 1.5) {
-					// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy;
-				// }
-				// writeDynamicEnergy += wlNewSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;				
-				
-				// Leakage
-				leakage = 0;
-				leakage += wlSwitchMatrix.leakage;
-				leakage += wlNewSwitchMatrix.leakage;
-				leakage += slSwitchMatrix.leakage;
-				leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
-				leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
-				leakage += multilevelSenseAmp.leakage;
-				leakage += multilevelSAEncoder.leakage;
-				leakage += shiftAdd.leakage;
-				
-			} else if (BNNsequentialMode || XNORsequentialMode) {
-				double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
-				double numWriteCells = (int)ceil((double)numCol/*numWriteColMuxed*/); 
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				double capBL = lengthCol * 0.2e-15/1e-6;
+			// Leakage
+			leakage = 0;
+			leakage += wlDecoder.leakage;
+			leakage += wlDecoderDriver.leakage;
+			leakage += wlNewDecoderDriver.leakage;
+			leakage += slSwitchMatrix.leakage;
+			leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
+			leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
+			leakage += rowCurrentSenseAmp.leakage;
+			leakage += dff.leakage;
+			leakage += adder.leakage;
 			
-				wlDecoder.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-				if (cell.accessType == CMOS_access) {
-					wlNewDecoderDriver.CalculatePower(numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-				} else {
-					wlDecoderDriver.CalculatePower(numReadCells, numWriteCells, numRow*activityRowRead*numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite);
-				}
-				slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				if (numColMuxed > 1) {
-					mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
-					muxDecoder.CalculatePower(numColMuxed, 1);
-				}
-				rowCurrentSenseAmp.CalculatePower(columnResistance, numRow*activityRowRead);
-				adder.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells);
-				dff.CalculatePower(numColMuxed*numRow*activityRowRead, numReadCells*(adder.numBit+1), param->validated); 
-				
-				// Read
-				readDynamicEnergyArray = 0;
-				readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
-				readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd; // Selected WL
-				readDynamicEnergyArray *= numRow * activityRowRead * numColMuxed;
+		} else if constexpr (mode == BNN_PARALLEL_READ) {
+			double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
+			int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
+			double capBL = lengthCol * 0.2e-15/1e-6;
 
-				readDynamicEnergy = 0;
-				readDynamicEnergy += wlDecoder.readDynamicEnergy;
-				readDynamicEnergy += wlNewDecoderDriver.readDynamicEnergy;
-				readDynamicEnergy += wlDecoderDriver.readDynamicEnergy;
-				readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
-				readDynamicEnergy += rowCurrentSenseAmp.readDynamicEnergy;
-				readDynamicEnergy += adder.readDynamicEnergy;
-				readDynamicEnergy += dff.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
+			if (cell.accessType == CMOS_access) {
+				wlNewSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+			} else {
+				wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			}
+			slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
+			if constexpr (sar) {
+				sarADC.CalculatePower(columnResistance, 1);
+			} else {
+				multilevelSenseAmp.CalculatePower(columnResistance, 1);
+			}
+			
+			// Read
+			readDynamicEnergyArray = 0;
+			readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
+			readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd * numRow * activityRowRead; // Selected WL
+			readDynamicEnergyArray *= numColMuxed;
 
-				// Write				
-				// writeDynamicEnergyArray = writeDynamicEnergyArray;
-				// writeDynamicEnergy = 0;
-				// if (cell.writeVoltage > 1.5) {
-					// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy;
-				// }
-				// writeDynamicEnergy += wlDecoder.writeDynamicEnergy;
-				// writeDynamicEnergy += wlNewDecoderDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += wlDecoderDriver.writeDynamicEnergy;
-				// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;				
-				
-				// Leakage
-				leakage = 0;
-				leakage += wlDecoder.leakage;
-				leakage += wlDecoderDriver.leakage;
-				leakage += wlNewDecoderDriver.leakage;
-				leakage += slSwitchMatrix.leakage;
-				leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
-				leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
-				leakage += rowCurrentSenseAmp.leakage;
-				leakage += dff.leakage;
-				leakage += adder.leakage;
-				
-			} else if (BNNparallelMode || XNORparallelMode) {
-				double numReadCells = (int)ceil((double)numCol/numColMuxed);    // similar parameter as numReadCellPerOperationNeuro, which is for SRAM
-				int numWriteOperationPerRow = (int)ceil((double)numCol*activityColWrite/numWriteCellPerOperationNeuro);
-				double capBL = lengthCol * 0.2e-15/1e-6;
+			readDynamicEnergy = 0;
+			readDynamicEnergy += wlNewSwitchMatrix.readDynamicEnergy;
+			readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
+			readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
+			readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
+			readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
+			readDynamicEnergy += readDynamicEnergyArray;
+			readDynamicEnergy += sarADC.readDynamicEnergy;
 
-				if (cell.accessType == CMOS_access) {
-					wlNewSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-				} else {
-					wlSwitchMatrix.CalculatePower(numColMuxed, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				}
-				slSwitchMatrix.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead, activityColWrite);
-				if (numColMuxed > 1) {
-					mux.CalculatePower(numColMuxed);	// Mux still consumes energy during row-by-row read
-					muxDecoder.CalculatePower(numColMuxed, 1);
-				}
-				if (SARADC) {
-					sarADC.CalculatePower(columnResistance, 1);
-				} else {
-					multilevelSenseAmp.CalculatePower(columnResistance, 1);
-					multilevelSAEncoder.CalculatePower(numColMuxed);
-				}
-				
-				// Read
-				readDynamicEnergyArray = 0;
-				readDynamicEnergyArray += capBL * cell.readVoltage * cell.readVoltage * numReadCells; // Selected BLs activityColWrite
-				readDynamicEnergyArray += capRow2 * tech.vdd * tech.vdd * numRow * activityRowRead; // Selected WL
-				readDynamicEnergyArray *= numColMuxed;
+			// Write				
+			// writeDynamicEnergyArray = writeDynamicEnergyArray;
+			// writeDynamicEnergy = 0;
+			// if (cell.writeVoltage > 1.5) {
+				// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
+				// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy;
+			// }
+			// writeDynamicEnergy += wlNewSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
+			// writeDynamicEnergy += writeDynamicEnergyArray;				
+			
+			// Leakage
+			leakage = 0;
+			leakage += wlSwitchMatrix.leakage;
+			leakage += wlNewSwitchMatrix.leakage;
+			leakage += slSwitchMatrix.leakage;
+			leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
+			leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
+			leakage += multilevelSenseAmp.leakage;
+			leakage += multilevelSAEncoder.leakage;
+
+		}
+	} 
+}
 
-				readDynamicEnergy = 0;
-				readDynamicEnergy += wlNewSwitchMatrix.readDynamicEnergy;
-				readDynamicEnergy += wlSwitchMatrix.readDynamicEnergy;
-				readDynamicEnergy += ( ((numColMuxed > 1)==true? (mux.readDynamicEnergy + muxDecoder.readDynamicEnergy):0) )/numReadPulse;
-				readDynamicEnergy += multilevelSenseAmp.readDynamicEnergy;
-				readDynamicEnergy += multilevelSAEncoder.readDynamicEnergy;
-				readDynamicEnergy += readDynamicEnergyArray;
-				readDynamicEnergy += sarADC.readDynamicEnergy;
+template <bool sram>
+void SubArray::PickReadMode() {
+	switch (readMode) {
+		case SEQUENTIAL_READ:     PickReadPath<sram, SEQUENTIAL_READ>();     break;
+		case PARALLEL_READ:       PickReadPath<sram, PARALLEL_READ>();       break;
+		case BNN_SEQUENTIAL_READ: PickReadPath<sram, BNN_SEQUENTIAL_READ>(); break;
+		case BNN_PARALLEL_READ:   PickReadPath<sram, BNN_PARALLEL_READ>();   break;
+	}
+}
 
-				// Write				
-				// writeDynamicEnergyArray = writeDynamicEnergyArray;
-				// writeDynamicEnergy = 0;
-				// if (cell.writeVoltage > 1.5) {
-					// wllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// bllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// sllevelshifter.CalculatePower(0, 2*numWriteOperationPerRow*numRow*activityRowWrite, activityRowRead);
-					// writeDynamicEnergy += wllevelshifter.writeDynamicEnergy + bllevelshifter.writeDynamicEnergy + sllevelshifter.writeDynamicEnergy;
-				// }
-				// writeDynamicEnergy += wlNewSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += wlSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += slSwitchMatrix.writeDynamicEnergy;
-				// writeDynamicEnergy += writeDynamicEnergyArray;				
-				
-				// Leakage
-				leakage = 0;
-				leakage += wlSwitchMatrix.leakage;
-				leakage += wlNewSwitchMatrix.leakage;
-				leakage += slSwitchMatrix.leakage;
-				leakage += ((numColMuxed > 1)==true? (mux.leakage):0);
-				leakage += ((numColMuxed > 1)==true? (muxDecoder.leakage):0);
-				leakage += multilevelSenseAmp.leakage;
-				leakage += multilevelSAEncoder.leakage;
+template <bool sram, ReadMode mode>
+void SubArray::PickReadPath() {
+	if (SARADC) {
+		readLatencyPath = &SubArray::ReadLatency<sram, mode, true>;
+		readPowerPath = &SubArray::ReadPower<sram, mode, true>;
+	} else {
+		readLatencyPath = &SubArray::ReadLatency<sram, mode, false>;
+		readPowerPath = &SubArray::ReadPower<sram, mode, false>;
+	}
+}
 
-			}
-		} 
+void SubArray::Evaluate(const vector<double> &columnResistance, double _activityRowRead) {   //per input vector part, requires Prepare() for the current layer
+	if (!prepared) {
+		cout << "[Subarray] Error: Require Prepare() first!" << endl;
+		exit(-1);
 	}
+	activityRowRead = _activityRowRead;
+	CalculateLatency(1e20, columnResistance);		// the sensing cycle is taken in the same walk as the cycle counts
+	CalculatePower(columnResistance);
 }
 
 void SubArray::PrintProperty() {
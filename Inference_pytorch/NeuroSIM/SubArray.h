@@ -81,11 +81,23 @@ public:
 	void PrintProperty();
 	void Initialize(int _numRow, int _numCol, double _unitWireRes);
 	void CalculateArea();
-	void CalculateLatency(double _rampInput, const vector<double> &columnResistance, bool CalculateclkFreq);
+	void Prepare();
+	void PrepareLatency();
+	void PreparePower();
+	void Evaluate(const vector<double> &columnResistance, double _activityRowRead);
+	void CalculateLatency(double _rampInput, const vector<double> &columnResistance);
 	void CalculatePower(const vector<double> &columnResistance);
+	template <bool sram, ReadMode mode, bool sar> void ReadLatency(const vector<double> &columnResistance);
+	template <bool sram, ReadMode mode, bool sar> void ReadPower(const vector<double> &columnResistance);
+	template <bool sram> void PickReadMode();
+	template <bool sram, ReadMode mode> void PickReadPath();
 
 	/* Properties */	
 	bool initialized;	   // Initialization flag
+	bool prepared;		   // Prepare() flag, the input-invariant peripheries are up to date
+	ReadMode readMode;	   // operation mode of the per-vector read path, picked in Prepare()
+	void (SubArray::*readLatencyPath)(const vector<double> &columnResistance);	// ReadLatency/ReadPower instance of the cell type, read mode and ADC, picked in Prepare()
+	void (SubArray::*readPowerPath)(const vector<double> &columnResistance);
 	int numRow;			   // Number of rows
 	int numCol;			   // Number of columns
 	
@@ -97,6 +109,7 @@ public:
 	double widthArray;
 	double areaArray;
 	double readDynamicEnergyArray, writeDynamicEnergyArray;
+	double leakageArray;	// Cell leakage of the SRAM array, Unit: W
 	double writeLatencyArray;
 	
 	double lengthRow;	// Length of rows, Unit: m
@@ -159,6 +172,7 @@ public:
 	bool relaxArrayCellWidth;	// true: relax the memory cell width to match the width of periperal circuit unit that connects to the column (ex: pass gate width in the column mux) if the latter is larger
 
 	double areaADC, areaAccum, areaOther, readLatencyADC, readLatencyAccum, readLatencyOther, readDynamicEnergyADC, readDynamicEnergyAccum, readDynamicEnergyOther;
+	double sensingLatency;		// sensing cycle of the last Evaluate(), sets the clock period in synchronous mode
 	
 	bool trainingEstimation, parallelTrans;
 	int levelOutputTrans, numRowMuxedTrans, numReadPulseTrans;
@@ -0,0 +1,105 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include "SubArrayCache.h"
+
+using namespace std;
+
+double SubArrayCache::lookups = 0;
+double SubArrayCache::hits = 0;
+
+SubArrayCache::SubArrayCache(int numRow, int _capacity) {
+	numWord = (numRow+63)/64;
+	key.resize(numWord);
+	capacity = _capacity;
+	cache.reserve(capacity);
+}
+
+size_t SubArrayCache::KeyHash::operator()(const vector<uint64_t> &key) const {
+	uint64_t h = 0x9e3779b97f4a7c15ull;
+	for (size_t w=0; w<key.size(); w++) {
+		h ^= key[w] + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+	}
+	return h;
+}
+
+const SubArrayCache::Entry *SubArrayCache::Find(const uint64_t *input) {
+	key.assign(input, input+numWord);
+	#pragma omp atomic
+	lookups++;
+	unordered_map<vector<uint64_t>, Entries::iterator, KeyHash>::const_iterator it = cache.find(key);
+	if (it == cache.end()) {
+		return NULL;
+	}
+	#pragma omp atomic
+	hits++;
+	entries.splice(entries.begin(), entries, it->second);
+	return &it->second->second;
+}
+
+void SubArrayCache::Insert(const uint64_t *input, int pending) {
+	if (capacity <= 0) {
+		return;
+	}
+	key.assign(input, input+numWord);
+	if (cache.count(key)) {
+		return;
+	}
+	if ((int)entries.size() >= capacity) {
+		cache.erase(entries.back().first);
+		entries.pop_back();
+	}
+	Entry entry;
+	entry.pending = pending;
+	entries.push_front(make_pair(key, entry));
+	cache[key] = entries.begin();
+}
+
+void SubArrayCache::Store(const uint64_t *input, const SubArrayResult &result) {
+	key.assign(input, input+numWord);
+	unordered_map<vector<uint64_t>, Entries::iterator, KeyHash>::iterator it = cache.find(key);
+	if (it != cache.end()) {
+		it->second->second.pending = -1;
+		it->second->second.result = result;
+	}
+}
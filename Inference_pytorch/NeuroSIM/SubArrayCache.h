@@ -0,0 +1,92 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef SUBARRAYCACHE_H_
+#define SUBARRAYCACHE_H_
+
+#include <stdint.h>
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+using namespace std;
+
+/*** Results of one input vector on one subArray (as read back from SubArray after CalculateLatency/CalculatePower) ***/
+struct SubArrayResult {
+	double readLatency, readLatencyADC, readLatencyAccum, readLatencyOther;
+	double readDynamicEnergy, readDynamicEnergyADC, readDynamicEnergyAccum, readDynamicEnergyOther;
+	double leakage;
+	double sensingLatency;
+};
+
+/*** Exact memo of subArray results, keyed on the packed input bits of the vector ***/
+// Valid for one subArray with fixed weights and pass: the column resistances and the read activity only
+// depend on which rows are active, so a repeated vector (e.g. an all-zero bit-plane) gives the same results.
+// An entry is inserted when its vector is first seen and holds the results once that vector is evaluated, so the
+// results outlive the batch of input vectors they were evaluated in.
+// At most capacity vectors are held, the least recently used one is dropped to make room for a new one.
+class SubArrayCache {
+public:
+	SubArrayCache(int numRow, int capacity);
+	virtual ~SubArrayCache() {}
+	
+	struct Entry {
+		int pending;				// index of the vector being evaluated in the current batch, -1 once result is set
+		SubArrayResult result;
+	};
+	
+	const Entry *Find(const uint64_t *input);		// NULL if the vector was not seen, valid until the next Insert
+	void Insert(const uint64_t *input, int pending);
+	void Store(const uint64_t *input, const SubArrayResult &result);		// results of a pending vector, if still held
+	
+	static double lookups, hits;		// over the whole run (all threads)
+	
+private:
+	struct KeyHash {
+		size_t operator()(const vector<uint64_t> &key) const;
+	};
+	
+	typedef list<pair<vector<uint64_t>, Entry> > Entries;		// most recently used first
+	Entries entries;
+	unordered_map<vector<uint64_t>, Entries::iterator, KeyHash> cache;
+	vector<uint64_t> key;
+	int numWord;
+	int capacity;
+};
+
+#endif /* SUBARRAYCACHE_H_ */
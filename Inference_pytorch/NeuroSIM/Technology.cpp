@@ -40,15 +40,220 @@
 
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
+#include <algorithm>
 #include "Technology.h"
 
 using namespace std;
 
+/*** Device table: one record per transistor type x node x roadmap ***/
+// The drain currents are sampled from 300K to 400K every 10K; CurrentOnNmos() and friends interpolate in between.
+// The FinFET pitch fields are 0 for the planar and 2D/TFET devices, which do not use them.
+struct DeviceRecord {
+	TransistorType transistorType;
+	int featureSizeInNano;
+	DeviceRoadmap deviceRoadmap;
+	double vdd, vth;
+	double heightFin, widthFin, PitchFin;
+	double phyGateLength, capIdealGate, capFringe;
+	double effectiveResistanceMultiplier;	/* from CACTI */
+	double current_gmNmos, current_gmPmos;
+	double currentOnNmos[11], currentOnPmos[11], currentOffNmos[11], currentOffPmos[11];
+	double pnSizeRatio;
+};
+
+static constexpr DeviceRecord deviceTable[] = {
+	/* PTM model: 130nm_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 130, HP, 1.3, 128.4855e-3, 0, 0, 0, 7.5e-8, 6.058401e-10, 6.119807e-10, 1.54, 3.94E+02, 2.61E+02,
+		{ 0.93e3, 0.91e3, 0.89e3, 0.87e3, 0.85e3, 0.83e3, 0.81e3, 0.79e3, 0.77e3, 0.75e3, 0.74e3 },
+		{ 0.43e3, 0.41e3, 0.38e3, 0.36e3, 0.34e3, 0.32e3, 0.30e3, 0.28e3, 0.26e3, 0.25e3, 0.24e3 },
+		{ 100.00e-3, 119.90e-3, 142.20e-3, 167.00e-3, 194.30e-3, 224.30e-3, 256.80e-3, 292.00e-3, 329.90e-3, 370.50e-3, 413.80e-3 },
+		{ 100.20e-3, 113.60e-3, 127.90e-3, 143.10e-3, 159.10e-3, 175.80e-3, 193.40e-3, 211.70e-3, 230.80e-3, 250.70e-3, 271.20e-3 },
+		0.93e3/0.43e3 },
+	/* PTM model: 130nm_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 130, LSTP, 1.3, 466.0949e-3, 0, 0, 0, 7.5e-8, 1.8574e-9, 9.530642e-10, 1.54, 3.87E+01, 5.67E+01,
+		{ 300.70, 273.40, 249.40, 228.40, 209.90, 193.50, 179.00, 166.00, 154.40, 144.00, 134.60 },
+		{ 150.70, 136.20, 123.60, 112.70, 103.20, 94.88, 87.54, 81.04, 75.25, 70.08, 65.44 },
+		{ 100.20e-6, 135.90e-6, 181.20e-6, 237.80e-6, 307.30e-6, 391.90e-6, 493.30e-6, 613.70e-6, 755.30e-6, 920.20e-6, 1111.0e-6 },
+		{ 100.20e-6, 132.80e-6, 173.00e-6, 221.90e-6, 280.70e-6, 350.40e-6, 432.20e-6, 527.20e-6, 636.80e-6, 761.90e-6, 903.80e-6 },
+		300.70/150.70 },
+	/* PTM model: 90nm_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 90, HP, 1.2, 146.0217e-3, 0, 0, 0, 5.5e-8, 5.694423e-10, 5.652302e-10, 1.54, 4.95E+02, 3.16E+02,
+		{ 1.07e3, 1.05e3, 1.03e3, 1.01e3, 0.99e3, 0.97e3, 0.95e3, 0.93e3, 0.90e3, 0.88e3, 0.86e3 },
+		{ 0.54e3, 0.50e3, 0.47e3, 0.44e3, 0.41e3, 0.39e3, 0.37e3, 0.34e3, 0.32e3, 0.31e3, 0.29e3 },
+		{ 100.8e-3, 120.8e-3, 143.4e-3, 168.6e-3, 196.6e-3, 227.4e-3, 261.1e-3, 297.7e-3, 337.3e-3, 379.8e-3, 425.4e-3 },
+		{ 100.00e-3, 114.00e-3, 128.90e-3, 144.80e-3, 161.60e-3, 179.30e-3, 197.90e-3, 217.40e-3, 237.90e-3, 259.10e-3, 281.30e-3 },
+		1.07e3/0.54e3 },
+	/* PTM model: 90nm_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 90, LSTP, 1.2, 501.3229e-3, 0, 0, 0, 5.5e-8, 1.5413e-10, 9.601334e-10, 1.77, 4.38E+01, 5.99E+01,
+		{ 346.30, 314.50, 286.80, 262.50, 241.20, 222.30, 205.60, 190.80, 177.50, 165.60, 155.00 },
+		{ 200.30, 179.50, 161.90, 146.90, 133.90, 122.60, 112.80, 104.10, 96.47, 89.68, 83.62 },
+		{ 100.00e-6, 135.70e-6, 181.10e-6, 238.00e-6, 308.50e-6, 394.60e-6, 498.50e-6, 622.60e-6, 769.30e-6, 941.20e-6, 1141.0e-6 },
+		{ 100.30e-6, 133.20e-6, 174.20e-6, 224.40e-6, 285.10e-6, 357.60e-6, 443.40e-6, 543.70e-6, 660.00e-6, 793.80e-6, 946.40e-6 },
+		346.30/200.30 },
+	/* PTM model: 65nm_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 65, HP, 1.1, 166.3941e-3, 0, 0, 0, 3.5e-8, 4.868295e-10, 5.270361e-10, 1.54, 5.72E+02, 3.99E+02,
+		{ 1.12e3, 1.10e3, 1.08e3, 1.06e3, 1.04e3, 1.02e3, 1.00e3, 0.98e3, 0.95e3, 0.93e3, 0.91e3 },
+		{ 0.70e3, 0.66e3, 0.62e3, 0.58e3, 0.55e3, 0.52e3, 0.49e3, 0.46e3, 0.44e3, 0.41e3, 0.39e3 },
+		{ 100.00e-3, 119.70e-3, 141.90e-3, 166.80e-3, 194.40e-3, 224.80e-3, 258.10e-3, 294.40e-3, 333.60e-3, 375.90e-3, 421.20e-3 },
+		{ 100.10e-3, 115.20e-3, 131.50e-3, 149.00e-3, 167.60e-3, 187.40e-3, 208.40e-3, 230.50e-3, 253.70e-3, 278.10e-3, 303.60e-3 },
+		1.12e3/0.70e3 },
+	/* PTM model: 65nm_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 65, LSTP, 1.1, 501.6636e-3, 0, 0, 0, 3.5e-8, 1.1926e-9, 9.62148e-10, 1.77, 5.90E+01, 6.75E+01,
+		{ 400.00, 363.90, 332.30, 304.70, 280.40, 258.90, 239.90, 223.00, 207.90, 194.30, 182.10 },
+		{ 238.70, 216.10, 196.60, 179.70, 164.90, 152.00, 140.50, 130.40, 121.40, 113.30, 106.10 },
+		{ 100.20e-6, 137.50e-6, 185.80e-6, 247.20e-6, 324.20e-6, 419.30e-6, 535.40e-6, 675.70e-6, 843.100e-6, 1041.00e-6, 1273.00e-6 },
+		{ 100.20e-6, 135.40e-6, 179.70e-6, 234.90e-6, 302.50e-6, 384.30e-6, 482.20e-6, 598.00e-6, 733.90e-6, 891.60e-6, 1073.00e-6 },
+		400.00/238.70 },
+	/* PTM model: 45nm_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 45, HP, 1.0, 171.0969e-3, 0, 0, 0, 3.0e-8, 4.091305e-10, 4.957928e-10, 1.54, 7.37E+02, 6.30E+02,
+		{ 1.27e3, 1.24e3, 1.22e3, 1.19e3, 1.16e3, 1.13e3, 1.11e3, 1.08e3, 1.05e3, 1.02e3, 1.00e3 },
+		{ 1.08e3, 1.04e3, 1.00e3, 0.96e3, 0.92e3, 0.88e3, 0.85e3, 0.81e3, 0.78e3, 0.75e3, 0.72e3 },
+		{ 100.00e-3, 120.70e-3, 144.10e-3, 170.50e-3, 199.80e-3, 232.30e-3, 268.00e-3, 307.10e-3, 349.50e-3, 395.40e-3, 444.80e-3 },
+		{ 100.20e-3, 118.70e-3, 139.30e-3, 162.00e-3, 186.80e-3, 213.90e-3, 243.30e-3, 274.90e-3, 308.90e-3, 345.20e-3, 383.80e-3 },
+		1.27e3/1.08e3 },
+	/* PTM model: 45nm_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 45, LSTP, 1, 464.3718e-3, 0, 0, 0, 3.0e-8, 8.930709e-10, 8.849901e-10, 1.77, 1.32E+02, 8.65E+01,
+		{ 500.20, 462.00, 427.80, 397.10, 369.40, 344.50, 322.10, 301.80, 283.40, 266.70, 251.50 },
+		{ 300.00, 275.70, 254.20, 235.10, 218.10, 202.80, 189.20, 176.90, 165.80, 155.80, 146.70 },
+		{ 100.00e-6, 140.50e-6, 193.90e-6, 263.10e-6, 351.40e-6, 462.50e-6, 600.30e-6, 769.20e-6, 973.900e-6, 1219.00e-6, 1511.00e-6 },
+		{ 100.20e-6, 138.40e-6, 187.60e-6, 250.10e-6, 328.10e-6, 424.10e-6, 540.90e-6, 681.30e-6, 848.30e-6, 1045.00e-6, 1275.00e-6 },
+		500.20/300.00 },
+	/* PTM model: 32nm_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 32, HP, 0.9, 194.4951e-3, 0, 0, 0, 2.8e-8, 3.767721e-10, 4.713762e-10, 1.54, 9.29E+02, 6.73E+02,
+		{ 1.41e3, 1.38e3, 1.35e3, 1.31e3, 1.28e3, 1.25e3, 1.21e3, 1.18e3, 1.15e3, 1.12e3, 1.08e3 },
+		{ 1.22e3, 1.17e3, 1.12e3, 1.07e3, 1.02e3, 0.98e3, 0.94e3, 0.89e3, 0.86e3, 0.82e3, 0.78e3 },
+		{ 100.30e-3, 120.40e-3, 143.10e-3, 168.60e-3, 197.00e-3, 228.40e-3, 262.90e-3, 300.60e-3, 341.70e-3, 386.10e-3, 433.90e-3 },
+		{ 100.10e-3, 119.00e-3, 140.00e-3, 163.30e-3, 188.80e-3, 216.70e-3, 247.00e-3, 279.70e-3, 314.90e-3, 352.60e-3, 392.80e-3 },
+		1.41e3/1.22e3 },
+	/* PTM model: 32nm_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 32, LSTP, 0.9, 442.034e-3, 0, 0, 0, 2.8e-8, 8.375279e-10, 6.856677e-10, 1.77, 2.56E+02, 1.19E+02,
+		{ 600.20, 562.80, 528.20, 496.20, 466.80, 439.70, 414.80, 391.90, 370.70, 351.30, 333.30 },
+		{ 400.00, 368.40, 340.30, 315.30, 292.90, 272.80, 254.80, 238.50, 223.80, 210.50, 198.40 },
+		{ 100.10e-6, 143.60e-6, 202.10e-6, 279.30e-6, 379.50e-6, 507.50e-6, 668.80e-6, 869.20e-6, 1115.00e-6, 1415.00e-6, 1774.00e-6 },
+		{ 100.10e-6, 140.70e-6, 194.00e-6, 262.50e-6, 349.30e-6, 457.70e-6, 591.20e-6, 753.70e-6, 949.30e-6, 1182.00e-6, 1457.00e-6 },
+		600.20/400.00 },
+	/* PTM model: 22nm.pm, from http://ptm.asu.edu/ */
+	{ conventional, 22, HP, 0.85, 208.9006e-3, 0, 0, 0, 2.6e-8, 3.287e-10, 4.532e-10, 1.54, 1.08E+03, 6.98E+02,
+		{ 1.50e3, 1.47e3, 1.43e3, 1.39e3, 1.35e3, 1.31e3, 1.28e3, 1.24e3, 1.20e3, 1.17e3, 1.13e3 },
+		{ 1.32e3, 1.25e3, 1.19e3, 1.13e3, 1.07e3, 1.02e3, 0.97e3, 0.92e3, 0.88e3, 0.84e3, 0.80e3 },
+		{ 100.20e-3, 120.40e-3, 143.50e-3, 169.50e-3, 198.70e-3, 231.20e-3, 267.00e-3, 306.30e-3, 349.30e-3, 396.00e-3, 446.60e-3 },
+		{ 100.20e-3, 119.40e-3, 140.80e-3, 164.60e-3, 190.90e-3, 219.50e-3, 250.70e-3, 284.50e-3, 320.90e-3, 359.80e-3, 401.50e-3 },
+		1.50e3/1.32e3 },
+	/* PTM model: 22nm_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 22, LSTP, 0.85, 419.915e-3, 0, 0, 0, 2.6e-8, 5.245e-10, 8.004e-10, 1.77, 4.56E+02, 1.85E+02,
+		{ 791.90, 756.40, 722.20, 689.40, 658.10, 628.30, 600.00, 573.30, 548.00, 524.20, 501.70 },
+		{ 600.20, 561.30, 525.50, 492.50, 462.20, 434.30, 408.70, 385.10, 363.40, 343.30, 324.80 },
+		{ 100.00e-6, 147.30e-6, 212.10e-6, 299.60e-6, 415.30e-6, 565.80e-6, 758.90e-6, 1003.00e-6, 1307.00e-6, 1682.00e-6, 2139.00e-6 },
+		{ 100.00e-6, 147.30e-6, 212.10e-6, 299.60e-6, 415.30e-6, 565.80e-6, 758.90e-6, 1003.00e-6, 1307.00e-6, 1682.00e-6, 2139.00e-6 },
+		791.90/600.20 },
+	/* PTM model: 14nfet_HP.pm,14pfet_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 14, HP, 0.8, 172.9868e-3, 3.7e-8, 8e-9, 4.8e-8, 2.2e-8, 1.2573e-9, 0, 1.51, 1.33E+03, 7.83E+02,
+		{ 1.686e3, 1.652e3, 1.607e3, 1.562e3, 1.517e3, 1.472e3, 1.439e3, 1.394e3, 1.349e3, 1.315e3, 1.270e3 },
+		{ 1.550e3, 1.468e3, 1.397e3, 1.327e3, 1.256e3, 1.198e3, 1.139e3, 1.080e3, 1.0336e3, 0.986e3, 0.939e3 },
+		{ 100.9152e-3, 150.0786e-3, 218.1063e-3, 310.359e-3, 433.1757e-3, 593.9313e-3, 801.0747e-3, 1.0641, 1.3938, 1.8016, 2.30031 },
+		{ 98.6503e-3, 157.5545e-3, 245.1751e-3, 372.5374e-3, 553.7661e-3, 806.5971e-3, 1.1529, 1.6190, 2.2361, 3.0405, 4.0733 },
+		(int)(1.686e3/1.550e3) },
+	/* PTM model: 14nfet_LP.pm,14pfet_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 14, LSTP, 0.8, 382.1222e-3, 3.7e-8, 8e-9, 4.8e-8, 2.2e-8, 1.0572e-9, 0, 1.76, 6.02E+02, 2.36E+02,
+		{ 893, 853, 814, 777, 742, 708, 677, 646, 618, 591, 565 },
+		{ 820, 767, 718, 672, 631, 593, 558, 526, 496, 469, 443 },
+		{ 99.7866e-6, 184.4553e-6, 328.7707e-6, 566.8658e-6, 948.1816e-6, 1.5425e-3, 2.4460e-3, 3.7885e-3, 5.7416e-3, 8.5281e-3, 1.24327e-2 },
+		{ 102.3333e-6, 203.4774e-6, 389.0187e-6, 717.5912e-6, 1.2810e-3, 2.2192e-3, 3.7395e-3, 6.1428e-3, 9.8554e-3, 1.54702e-2, 2.37959e-2 },
+		(int)(893/820) },
+	/* PTM model: 10nfet_HP.pm,10pfet_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 10, HP, 0.75, 182.8605e-3, 4.2e-8, 6e-9, 3.6e-8, 2.0e-8, 1.1418e-9, 0, 1.49, 1.56E+03, 8.02E+02,
+		{ 1.769e3, 1.734e3, 1.686e3, 1.639e3, 1.592e3, 1.545e3, 1.510e3, 1.462e3, 1.415e3, 1.380e3, 1.333e3 },
+		{ 1.626e3, 1.540e3, 1.466e3, 1.392e3, 1.318e3, 1.256e3, 1.195e3, 1.133e3, 1.084e3, 1.035e3, 0.985e3 },
+		{ 100.1203e-3, 148.6272e-3, 215.6467e-3, 306.4157e-3, 427.1264e-3, 584.9857e-3, 788.2578e-3, 1.0463, 1.3695, 1.7694, 2.2584 },
+		{ 1.6268e-3, 157.8505e-3, 245.2725e-3, 372.2051e-3, 552.6667e-3, 804.2786e-3, 1.1488, 1.6125, 2.2268, 3.0281, 4.0584 },
+		(int)(1.769e3/1.626e3) },
+	/* PTM model: 10nfet_LP.pm,10pfet_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 10, LSTP, 0.75, 390.5541e-3, 4.2e-8, 6e-9, 3.6e-8, 2e-8, 9.418984e-10, 0, 1.73, 8.22E+02, 1.90E+02,
+		{ 862, 824, 787, 751, 717, 684, 654, 624, 597, 571, 546 },
+		{ 775, 725, 678, 636, 597, 561, 527, 497, 469, 443, 419 },
+		{ 99.6973e-6, 184.4892e-6, 329.1615e-6, 568.0731e-6, 951.0401e-6, 1.5484e-3, 2.4574e-3, 3.8090e-3, 5.7767e-3, 8.5862e-3, 1.2525e-2 },
+		{ 100.5839e-6, 200.2609e-6, 383.3239e-6, 707.8499e-6, 1.2649e-3, 2.1932e-3, 3.6987e-3, 6.0804e-3, 9.7622e-3, 1.53340e-2, 2.36007e-2 },
+		(int)(862/775) },
+	/* PTM model: 7nfet_HP.pm,7pfet_HP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 7, HP, 0.7, 192.2339e-3, 5.2e-8, 6e-9, 3.0e-8, 1.8e-8, 1.0487e-9, 0, 1.45, 1.91E+03, 8.02E+02,
+		{ 1912, 1874, 1823, 1772, 1721, 1670, 1632, 1581, 1530, 1491, 1440 },
+		{ 1685, 1596, 1519, 1442, 1366, 1302, 1238, 1174, 1123, 1072, 1021 },
+		{ 100.2258e-3, 149.0252e-3, 216.5654e-3, 308.1967e-3, 430.2635e-3, 590.1731e-3, 796.4489e-3, 1.0588, 1.3880, 1.7960, 2.2961 },
+		{ 97.9484e-3, 156.3424e-3, 243.1919e-3, 369.4499e-3, 549.1886e-3, 800.1479e-3, 1.1443, 1.6083, 2.2242, 3.0295, 4.0674 },
+		(int)(1912/1685) },
+	/* PTM model: 7nfet_LP.pm,7pfet_LP.pm, from http://ptm.asu.edu/ */
+	{ conventional, 7, LSTP, 0.7, 402.5252e-3, 5.2e-8, 6e-9, 3.0e-8, 1.8e-8, 8.49489e-10, 0, 1.73, 8.22E+02, 1.45E+02,
+		{ 822, 786, 750, 716, 684, 653, 624, 595, 569, 545, 521 },
+		{ 737, 689, 645, 605, 567, 533, 501, 473, 446, 421, 398 },
+		{ 1.00E-04, 1.85E-04, 3.32E-04, 5.74E-04, 9.62E-04, 1.5695e-3, 2.4953e-3, 3.8744e-3, 5.8858e-3, 8.7624e-3, 1.28025e-2 },
+		{ 100.9536e-6, 201.3937e-6, 386.2086e-6, 714.4288e-6, 1.2788e-3, 2.2207e-3, 3.7509e-3, 6.1750e-3, 9.9278e-3, 1.56146e-2, 2.40633e-2 },
+		(int)(822/737) },
+	/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
+	// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
+	{ FET_2D, 22, HP, 0.8, 0.2614, 0, 0, 0, 2.2e-8, 2.398e-9, 3e-11, 1.54, 9.887e+3, 9.887e+3,
+		{ 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433 },
+		{ 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433, 5433 },
+		{ 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1 },
+		{ 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1 },
+		1 },
+	/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
+	// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
+	{ FET_2D, 22, LSTP, 0.8, 0.4015, 0, 0, 0, 2.2e-8, 2.398e-9, 3e-11, 1.77, 9.374e+3, 9.374e+3,
+		{ 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026 },
+		{ 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026, 4026 },
+		{ 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4 },
+		{ 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4 },
+		1 },
+	/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
+	// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
+	{ FET_2D, 14, HP, 0.8, 0.2614, 0, 0, 0, 1.4e-8, 1.526e-9, 3e-11, 1.51, 1.005e+4, 1.005e+4,
+		{ 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514 },
+		{ 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514, 5514 },
+		{ 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1 },
+		{ 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1, 0.1 },
+		1 },
+	/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
+	// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
+	{ FET_2D, 14, LSTP, 0.8, 0.4015, 0, 0, 0, 1.4e-8, 1.526e-9, 3e-11, 1.76, 9.531e+3, 9.531e+3,
+		{ 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085 },
+		{ 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085, 4085 },
+		{ 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4 },
+		{ 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4, 1e-4 },
+		1 },
+	// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
+	// Same as LSTP
+	{ TFET, 22, HP, 0.5, 0.17, 0, 0, 0, 2e-8, 6.9e-10, 2e-10, 1.54, 4.37e+2, 4.37e+2,
+		{ 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51 },
+		{ 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51 },
+		{ 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023 },
+		{ 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023 },
+		1 },
+	// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
+	{ TFET, 22, LSTP, 0.5, 0.17, 0, 0, 0, 2e-8, 6.9e-10, 2e-10, 1.54, 4.37e+2, 4.37e+2,
+		{ 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51 },
+		{ 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51, 90.51 },
+		{ 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023 },
+		{ 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023, 0.0023 },
+		1 },
+};
+
+static constexpr int FindDevice(TransistorType transistorType, int featureSizeInNano, DeviceRoadmap deviceRoadmap) {	// index in deviceTable, -1 if missing
+	for (int i=0; i<(int)(sizeof(deviceTable)/sizeof(deviceTable[0])); i++) {
+		if (deviceTable[i].transistorType == transistorType && deviceTable[i].featureSizeInNano == featureSizeInNano && deviceTable[i].deviceRoadmap == deviceRoadmap) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+static_assert(FindDevice(conventional, 130, HP) >= 0 && FindDevice(conventional, 7, LSTP) >= 0 && FindDevice(TFET, 22, HP) >= 0, "device table is incomplete");
+
 Technology::Technology() {
 	initialized = false;
 }
 
-void Technology::Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap, TransistorType _transistorType) {
+bool Technology::Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap, TransistorType _transistorType) {	// false if the node is not in the device table
 	if (initialized)
 		cout << "Warning: Already initialized!" << endl;
 
@@ -56,1392 +261,38 @@ void Technology::Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap
 	featureSize = _featureSizeInNano * 1e-9;
 	transistorType = _transistorType;
 	deviceRoadmap = _deviceRoadmap;
-	if (transistorType == conventional) {
-		if (featureSizeInNano == 130) {	
-			if (deviceRoadmap == HP) {
-				/* PTM model: 130nm_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.3;
-				vth = 128.4855e-3;
-				phyGateLength = 7.5e-8;
-				capIdealGate = 6.058401e-10;
-				capFringe = 6.119807e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=3.94E+02; 
-				current_gmPmos=2.61E+02;
-				currentOnNmos[0]   = 0.93e3; 
-				currentOnNmos[10]  = 0.91e3; 
-				currentOnNmos[20]  = 0.89e3; 
-				currentOnNmos[30]  = 0.87e3; 
-				currentOnNmos[40]  = 0.85e3; 
-				currentOnNmos[50]  = 0.83e3; 
-				currentOnNmos[60]  = 0.81e3; 
-				currentOnNmos[70]  = 0.79e3; 
-				currentOnNmos[80]  = 0.77e3; 
-				currentOnNmos[90]  = 0.75e3; 
-				currentOnNmos[100] = 0.74e3; 
-				currentOnPmos[0]   = 0.43e3; 
-				currentOnPmos[10]  = 0.41e3; 
-				currentOnPmos[20]  = 0.38e3; 
-				currentOnPmos[30]  = 0.36e3; 
-				currentOnPmos[40]  = 0.34e3; 
-				currentOnPmos[50]  = 0.32e3; 
-				currentOnPmos[60]  = 0.30e3; 
-				currentOnPmos[70]  = 0.28e3; 
-				currentOnPmos[80]  = 0.26e3; 
-				currentOnPmos[90]  = 0.25e3; 
-				currentOnPmos[100] = 0.24e3; 
-				currentOffNmos[0]  = 100.00e-3; 
-				currentOffNmos[10] = 119.90e-3; 
-				currentOffNmos[20] = 142.20e-3; 
-				currentOffNmos[30] = 167.00e-3; 
-				currentOffNmos[40] = 194.30e-3; 
-				currentOffNmos[50] = 224.30e-3; 
-				currentOffNmos[60] = 256.80e-3; 
-				currentOffNmos[70] = 292.00e-3; 
-				currentOffNmos[80] = 329.90e-3; 
-				currentOffNmos[90] = 370.50e-3; 
-				currentOffNmos[100]= 413.80e-3; 
-				currentOffPmos[0]  = 100.20e-3; 
-				currentOffPmos[10] = 113.60e-3; 
-				currentOffPmos[20] = 127.90e-3; 
-				currentOffPmos[30] = 143.10e-3; 
-				currentOffPmos[40] = 159.10e-3; 
-				currentOffPmos[50] = 175.80e-3; 
-				currentOffPmos[60] = 193.40e-3; 
-				currentOffPmos[70] = 211.70e-3; 
-				currentOffPmos[80] = 230.80e-3; 
-				currentOffPmos[90] = 250.70e-3; 
-				currentOffPmos[100]= 271.20e-3;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} else  {   //(deviceRoadmap == LSTP)
-				/* PTM model: 130nm_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.3;
-				vth = 466.0949e-3;
-				phyGateLength = 7.5e-8;
-				capIdealGate = 1.8574e-9;
-				capFringe = 9.530642e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=3.87E+01;
-				current_gmPmos=5.67E+01;			
-				currentOnNmos[0]   = 300.70; 
-				currentOnNmos[10]  = 273.40; 
-				currentOnNmos[20]  = 249.40; 
-				currentOnNmos[30]  = 228.40; 
-				currentOnNmos[40]  = 209.90; 
-				currentOnNmos[50]  = 193.50; 
-				currentOnNmos[60]  = 179.00; 
-				currentOnNmos[70]  = 166.00; 
-				currentOnNmos[80]  = 154.40; 
-				currentOnNmos[90]  = 144.00; 
-				currentOnNmos[100] = 134.60; 
-				currentOnPmos[0]   = 150.70;
-				currentOnPmos[10]  = 136.20;
-				currentOnPmos[20]  = 123.60;
-				currentOnPmos[30]  = 112.70;
-				currentOnPmos[40]  = 103.20;
-				currentOnPmos[50]  = 94.88 ;
-				currentOnPmos[60]  = 87.54 ;
-				currentOnPmos[70]  = 81.04 ;
-				currentOnPmos[80]  = 75.25 ;
-				currentOnPmos[90]  = 70.08 ;
-				currentOnPmos[100] = 65.44 ;
-				currentOffNmos[0]  = 100.20e-6;
-				currentOffNmos[10] = 135.90e-6;
-				currentOffNmos[20] = 181.20e-6;
-				currentOffNmos[30] = 237.80e-6;
-				currentOffNmos[40] = 307.30e-6;
-				currentOffNmos[50] = 391.90e-6;
-				currentOffNmos[60] = 493.30e-6;
-				currentOffNmos[70] = 613.70e-6;
-				currentOffNmos[80] = 755.30e-6;
-				currentOffNmos[90] = 920.20e-6;
-				currentOffNmos[100]= 1111.0e-6;
-				currentOffPmos[0]  = 100.20e-6; 
-				currentOffPmos[10] = 132.80e-6; 
-				currentOffPmos[20] = 173.00e-6; 
-				currentOffPmos[30] = 221.90e-6; 
-				currentOffPmos[40] = 280.70e-6; 
-				currentOffPmos[50] = 350.40e-6; 
-				currentOffPmos[60] = 432.20e-6; 
-				currentOffPmos[70] = 527.20e-6; 
-				currentOffPmos[80] = 636.80e-6; 
-				currentOffPmos[90] = 761.90e-6; 
-				currentOffPmos[100]= 903.80e-6;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} 
-		} else if (featureSizeInNano == 90) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 90nm_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.2;
-				vth = 146.0217e-3;
-				phyGateLength = 5.5e-8;
-				capIdealGate = 5.694423e-10;
-				capFringe = 5.652302e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=4.95E+02;
-				current_gmPmos=3.16E+02;			
-				currentOnNmos[0]   = 1.07e3;
-				currentOnNmos[10]  = 1.05e3;
-				currentOnNmos[20]  = 1.03e3;
-				currentOnNmos[30]  = 1.01e3;
-				currentOnNmos[40]  = 0.99e3;
-				currentOnNmos[50]  = 0.97e3;
-				currentOnNmos[60]  = 0.95e3;
-				currentOnNmos[70]  = 0.93e3;
-				currentOnNmos[80]  = 0.90e3;
-				currentOnNmos[90]  = 0.88e3;
-				currentOnNmos[100] = 0.86e3;
-				currentOnPmos[0]   = 0.54e3; 
-				currentOnPmos[10]  = 0.50e3; 
-				currentOnPmos[20]  = 0.47e3; 
-				currentOnPmos[30]  = 0.44e3; 
-				currentOnPmos[40]  = 0.41e3; 
-				currentOnPmos[50]  = 0.39e3; 
-				currentOnPmos[60]  = 0.37e3; 
-				currentOnPmos[70]  = 0.34e3; 
-				currentOnPmos[80]  = 0.32e3; 
-				currentOnPmos[90]  = 0.31e3; 
-				currentOnPmos[100] = 0.29e3; 
-				currentOffNmos[0]  = 100.8e-3;	
-				currentOffNmos[10] = 120.8e-3;	
-				currentOffNmos[20] = 143.4e-3;	
-				currentOffNmos[30] = 168.6e-3;	
-				currentOffNmos[40] = 196.6e-3;	
-				currentOffNmos[50] = 227.4e-3;	
-				currentOffNmos[60] = 261.1e-3;	
-				currentOffNmos[70] = 297.7e-3;	
-				currentOffNmos[80] = 337.3e-3;	
-				currentOffNmos[90] = 379.8e-3;	
-				currentOffNmos[100]= 425.4e-3;	
-				currentOffPmos[0]  = 100.00e-3;
-				currentOffPmos[10] = 114.00e-3;
-				currentOffPmos[20] = 128.90e-3;
-				currentOffPmos[30] = 144.80e-3;
-				currentOffPmos[40] = 161.60e-3;
-				currentOffPmos[50] = 179.30e-3;
-				currentOffPmos[60] = 197.90e-3;
-				currentOffPmos[70] = 217.40e-3;
-				currentOffPmos[80] = 237.90e-3;
-				currentOffPmos[90] = 259.10e-3;
-				currentOffPmos[100]= 281.30e-3;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} else {
-				/* PTM model: 90nm_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.2;
-				vth = 501.3229e-3;
-				phyGateLength = 5.5e-8;
-				capIdealGate = 1.5413e-10;
-				capFringe = 9.601334e-10;
-				effectiveResistanceMultiplier = 1.77;	/* from CACTI */
-				current_gmNmos=4.38E+01;
-				current_gmPmos=5.99E+01;			
-				currentOnNmos[0]   = 346.30 ;
-				currentOnNmos[10]  = 314.50 ;
-				currentOnNmos[20]  = 286.80 ;
-				currentOnNmos[30]  = 262.50 ;
-				currentOnNmos[40]  = 241.20 ;
-				currentOnNmos[50]  = 222.30 ;
-				currentOnNmos[60]  = 205.60 ;
-				currentOnNmos[70]  = 190.80 ;
-				currentOnNmos[80]  = 177.50 ;
-				currentOnNmos[90]  = 165.60 ;
-				currentOnNmos[100] = 155.00 ;
-				currentOnPmos[0]   = 200.30 ;
-				currentOnPmos[10]  = 179.50 ;
-				currentOnPmos[20]  = 161.90 ;
-				currentOnPmos[30]  = 146.90 ;
-				currentOnPmos[40]  = 133.90 ;
-				currentOnPmos[50]  = 122.60 ;
-				currentOnPmos[60]  = 112.80 ;
-				currentOnPmos[70]  = 104.10 ;
-				currentOnPmos[80]  = 96.47  ;
-				currentOnPmos[90]  = 89.68  ;
-				currentOnPmos[100] = 83.62  ;
-				currentOffNmos[0]  = 100.00e-6;
-				currentOffNmos[10] = 135.70e-6;
-				currentOffNmos[20] = 181.10e-6;
-				currentOffNmos[30] = 238.00e-6;
-				currentOffNmos[40] = 308.50e-6;
-				currentOffNmos[50] = 394.60e-6;
-				currentOffNmos[60] = 498.50e-6;
-				currentOffNmos[70] = 622.60e-6;
-				currentOffNmos[80] = 769.30e-6;
-				currentOffNmos[90] = 941.20e-6;
-				currentOffNmos[100]= 1141.0e-6;
-				currentOffPmos[0]  = 100.30e-6;
-				currentOffPmos[10] = 133.20e-6;
-				currentOffPmos[20] = 174.20e-6;
-				currentOffPmos[30] = 224.40e-6;
-				currentOffPmos[40] = 285.10e-6;
-				currentOffPmos[50] = 357.60e-6;
-				currentOffPmos[60] = 443.40e-6;
-				currentOffPmos[70] = 543.70e-6;
-				currentOffPmos[80] = 660.00e-6;
-				currentOffPmos[90] = 793.80e-6;
-				currentOffPmos[100]= 946.40e-6;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			}
-		} else if (featureSizeInNano == 65) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 65nm_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.1;
-				vth = 166.3941e-3;
-				phyGateLength = 3.5e-8;
-				capIdealGate = 4.868295e-10;
-				capFringe = 5.270361e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=5.72E+02;
-				current_gmPmos=3.99E+02;			
-				currentOnNmos[0]   = 1.12e3;
-				currentOnNmos[10]  = 1.10e3;
-				currentOnNmos[20]  = 1.08e3;
-				currentOnNmos[30]  = 1.06e3;
-				currentOnNmos[40]  = 1.04e3;
-				currentOnNmos[50]  = 1.02e3;
-				currentOnNmos[60]  = 1.00e3;
-				currentOnNmos[70]  = 0.98e3;
-				currentOnNmos[80]  = 0.95e3;
-				currentOnNmos[90]  = 0.93e3;
-				currentOnNmos[100] = 0.91e3;
-				currentOnPmos[0]   = 0.70e3; 
-				currentOnPmos[10]  = 0.66e3; 
-				currentOnPmos[20]  = 0.62e3; 
-				currentOnPmos[30]  = 0.58e3; 
-				currentOnPmos[40]  = 0.55e3; 
-				currentOnPmos[50]  = 0.52e3; 
-				currentOnPmos[60]  = 0.49e3; 
-				currentOnPmos[70]  = 0.46e3; 
-				currentOnPmos[80]  = 0.44e3; 
-				currentOnPmos[90]  = 0.41e3; 
-				currentOnPmos[100] = 0.39e3; 
-				currentOffNmos[0]  = 100.00e-3;	
-				currentOffNmos[10] = 119.70e-3;	
-				currentOffNmos[20] = 141.90e-3;	
-				currentOffNmos[30] = 166.80e-3;	
-				currentOffNmos[40] = 194.40e-3;	
-				currentOffNmos[50] = 224.80e-3;	
-				currentOffNmos[60] = 258.10e-3;	
-				currentOffNmos[70] = 294.40e-3;	
-				currentOffNmos[80] = 333.60e-3;	
-				currentOffNmos[90] = 375.90e-3;	
-				currentOffNmos[100]= 421.20e-3;	
-				currentOffPmos[0]  = 100.10e-3;
-				currentOffPmos[10] = 115.20e-3;
-				currentOffPmos[20] = 131.50e-3;
-				currentOffPmos[30] = 149.00e-3;
-				currentOffPmos[40] = 167.60e-3;
-				currentOffPmos[50] = 187.40e-3;
-				currentOffPmos[60] = 208.40e-3;
-				currentOffPmos[70] = 230.50e-3;
-				currentOffPmos[80] = 253.70e-3;
-				currentOffPmos[90] = 278.10e-3;
-				currentOffPmos[100]= 303.60e-3;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} else {
-				/* PTM model: 65nm_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.1;
-				vth = 501.6636e-3;
-				phyGateLength = 3.5e-8;
-				capIdealGate = 1.1926e-9;
-				capFringe = 9.62148e-10;
-				effectiveResistanceMultiplier = 1.77;	/* from CACTI */
-				current_gmNmos=5.90E+01;
-				current_gmPmos=6.75E+01;			
-				currentOnNmos[0]   = 400.00 ;
-				currentOnNmos[10]  = 363.90 ;
-				currentOnNmos[20]  = 332.30 ;
-				currentOnNmos[30]  = 304.70 ;
-				currentOnNmos[40]  = 280.40 ;
-				currentOnNmos[50]  = 258.90 ;
-				currentOnNmos[60]  = 239.90 ;
-				currentOnNmos[70]  = 223.00 ;
-				currentOnNmos[80]  = 207.90 ;
-				currentOnNmos[90]  = 194.30 ;
-				currentOnNmos[100] = 182.10 ;
-				currentOnPmos[0]   = 238.70 ;
-				currentOnPmos[10]  = 216.10 ;
-				currentOnPmos[20]  = 196.60 ;
-				currentOnPmos[30]  = 179.70 ;
-				currentOnPmos[40]  = 164.90 ;
-				currentOnPmos[50]  = 152.00 ;
-				currentOnPmos[60]  = 140.50 ;
-				currentOnPmos[70]  = 130.40 ;
-				currentOnPmos[80]  = 121.40 ;
-				currentOnPmos[90]  = 113.30 ;
-				currentOnPmos[100] = 106.10 ;
-				currentOffNmos[0]  = 100.20e-6;
-				currentOffNmos[10] = 137.50e-6;
-				currentOffNmos[20] = 185.80e-6;
-				currentOffNmos[30] = 247.20e-6;
-				currentOffNmos[40] = 324.20e-6;
-				currentOffNmos[50] = 419.30e-6;
-				currentOffNmos[60] = 535.40e-6;
-				currentOffNmos[70] = 675.70e-6;
-				currentOffNmos[80] = 843.100e-6;
-				currentOffNmos[90] = 1041.00e-6;
-				currentOffNmos[100]= 1273.00e-6;
-				currentOffPmos[0]  = 100.20e-6;
-				currentOffPmos[10] = 135.40e-6;
-				currentOffPmos[20] = 179.70e-6;
-				currentOffPmos[30] = 234.90e-6;
-				currentOffPmos[40] = 302.50e-6;
-				currentOffPmos[50] = 384.30e-6;
-				currentOffPmos[60] = 482.20e-6;
-				currentOffPmos[70] = 598.00e-6;
-				currentOffPmos[80] = 733.90e-6;
-				currentOffPmos[90] = 891.60e-6;
-				currentOffPmos[100]= 1073.00e-6;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			}
-		} else if (featureSizeInNano == 45) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 45nm_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 1.0;
-				vth = 171.0969e-3;
-				phyGateLength = 3.0e-8;
-				capIdealGate = 4.091305e-10;
-				capFringe = 4.957928e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=7.37E+02;
-				current_gmPmos=6.30E+02;			
-				currentOnNmos[0]   = 1.27e3;
-				currentOnNmos[10]  = 1.24e3;
-				currentOnNmos[20]  = 1.22e3;
-				currentOnNmos[30]  = 1.19e3;
-				currentOnNmos[40]  = 1.16e3;
-				currentOnNmos[50]  = 1.13e3;
-				currentOnNmos[60]  = 1.11e3;
-				currentOnNmos[70]  = 1.08e3;
-				currentOnNmos[80]  = 1.05e3;
-				currentOnNmos[90]  = 1.02e3;
-				currentOnNmos[100] = 1.00e3;
-				currentOnPmos[0]   = 1.08e3; 
-				currentOnPmos[10]  = 1.04e3; 
-				currentOnPmos[20]  = 1.00e3; 
-				currentOnPmos[30]  = 0.96e3; 
-				currentOnPmos[40]  = 0.92e3; 
-				currentOnPmos[50]  = 0.88e3; 
-				currentOnPmos[60]  = 0.85e3; 
-				currentOnPmos[70]  = 0.81e3; 
-				currentOnPmos[80]  = 0.78e3; 
-				currentOnPmos[90]  = 0.75e3; 
-				currentOnPmos[100] = 0.72e3; 
-				currentOffNmos[0]  = 100.00e-3;	
-				currentOffNmos[10] = 120.70e-3;	
-				currentOffNmos[20] = 144.10e-3;	
-				currentOffNmos[30] = 170.50e-3;	
-				currentOffNmos[40] = 199.80e-3;	
-				currentOffNmos[50] = 232.30e-3;	
-				currentOffNmos[60] = 268.00e-3;	
-				currentOffNmos[70] = 307.10e-3;	
-				currentOffNmos[80] = 349.50e-3;	
-				currentOffNmos[90] = 395.40e-3;	
-				currentOffNmos[100]= 444.80e-3;	
-				currentOffPmos[0]  = 100.20e-3;
-				currentOffPmos[10] = 118.70e-3;
-				currentOffPmos[20] = 139.30e-3;
-				currentOffPmos[30] = 162.00e-3;
-				currentOffPmos[40] = 186.80e-3;
-				currentOffPmos[50] = 213.90e-3;
-				currentOffPmos[60] = 243.30e-3;
-				currentOffPmos[70] = 274.90e-3;
-				currentOffPmos[80] = 308.90e-3;
-				currentOffPmos[90] = 345.20e-3;
-				currentOffPmos[100]= 383.80e-3;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} else {
-				/* PTM model: 45nm_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 1;
-				vth = 464.3718e-3;
-				phyGateLength = 3.0e-8;
-				capIdealGate = 8.930709e-10;
-				capFringe = 8.849901e-10;
-				effectiveResistanceMultiplier = 1.77;	/* from CACTI */
-				current_gmNmos=1.32E+02;
-				current_gmPmos=8.65E+01;			
-				currentOnNmos[0]   = 500.20 ;
-				currentOnNmos[10]  = 462.00 ;
-				currentOnNmos[20]  = 427.80 ;
-				currentOnNmos[30]  = 397.10 ;
-				currentOnNmos[40]  = 369.40 ;
-				currentOnNmos[50]  = 344.50 ;
-				currentOnNmos[60]  = 322.10 ;
-				currentOnNmos[70]  = 301.80 ;
-				currentOnNmos[80]  = 283.40 ;
-				currentOnNmos[90]  = 266.70 ;
-				currentOnNmos[100] = 251.50 ;
-				currentOnPmos[0]   = 300.00 ;
-				currentOnPmos[10]  = 275.70 ;
-				currentOnPmos[20]  = 254.20 ;
-				currentOnPmos[30]  = 235.10 ;
-				currentOnPmos[40]  = 218.10 ;
-				currentOnPmos[50]  = 202.80 ;
-				currentOnPmos[60]  = 189.20 ;
-				currentOnPmos[70]  = 176.90 ;
-				currentOnPmos[80]  = 165.80 ;
-				currentOnPmos[90]  = 155.80 ;
-				currentOnPmos[100] = 146.70 ;
-				currentOffNmos[0]  = 100.00e-6;
-				currentOffNmos[10] = 140.50e-6;
-				currentOffNmos[20] = 193.90e-6;
-				currentOffNmos[30] = 263.10e-6;
-				currentOffNmos[40] = 351.40e-6;
-				currentOffNmos[50] = 462.50e-6;
-				currentOffNmos[60] = 600.30e-6;
-				currentOffNmos[70] = 769.20e-6;
-				currentOffNmos[80] = 973.900e-6;
-				currentOffNmos[90] = 1219.00e-6;
-				currentOffNmos[100]= 1511.00e-6;
-				currentOffPmos[0]  = 100.20e-6;
-				currentOffPmos[10] = 138.40e-6;
-				currentOffPmos[20] = 187.60e-6;
-				currentOffPmos[30] = 250.10e-6;
-				currentOffPmos[40] = 328.10e-6;
-				currentOffPmos[50] = 424.10e-6;
-				currentOffPmos[60] = 540.90e-6;
-				currentOffPmos[70] = 681.30e-6;
-				currentOffPmos[80] = 848.30e-6;
-				currentOffPmos[90] = 1045.00e-6;
-				currentOffPmos[100]= 1275.00e-6;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			}
-		} else if (featureSizeInNano == 32) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 32nm_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.9;
-				vth = 194.4951e-3;
-				phyGateLength = 2.8e-8;
-				capIdealGate = 3.767721e-10;
-				capFringe = 4.713762e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=9.29E+02;
-				current_gmPmos=6.73E+02;			
-				currentOnNmos[0]   = 1.41e3;
-				currentOnNmos[10]  = 1.38e3;
-				currentOnNmos[20]  = 1.35e3;
-				currentOnNmos[30]  = 1.31e3;
-				currentOnNmos[40]  = 1.28e3;
-				currentOnNmos[50]  = 1.25e3;
-				currentOnNmos[60]  = 1.21e3;
-				currentOnNmos[70]  = 1.18e3;
-				currentOnNmos[80]  = 1.15e3;
-				currentOnNmos[90]  = 1.12e3;
-				currentOnNmos[100] = 1.08e3;
-				currentOnPmos[0]   = 1.22e3; 
-				currentOnPmos[10]  = 1.17e3; 
-				currentOnPmos[20]  = 1.12e3; 
-				currentOnPmos[30]  = 1.07e3; 
-				currentOnPmos[40]  = 1.02e3; 
-				currentOnPmos[50]  = 0.98e3; 
-				currentOnPmos[60]  = 0.94e3; 
-				currentOnPmos[70]  = 0.89e3; 
-				currentOnPmos[80]  = 0.86e3; 
-				currentOnPmos[90]  = 0.82e3; 
-				currentOnPmos[100] = 0.78e3; 
-				currentOffNmos[0]  = 100.30e-3;	
-				currentOffNmos[10] = 120.40e-3;	
-				currentOffNmos[20] = 143.10e-3;	
-				currentOffNmos[30] = 168.60e-3;	
-				currentOffNmos[40] = 197.00e-3;	
-				currentOffNmos[50] = 228.40e-3;	
-				currentOffNmos[60] = 262.90e-3;	
-				currentOffNmos[70] = 300.60e-3;	
-				currentOffNmos[80] = 341.70e-3;	
-				currentOffNmos[90] = 386.10e-3;	
-				currentOffNmos[100]= 433.90e-3;	
-				currentOffPmos[0]  = 100.10e-3;
-				currentOffPmos[10] = 119.00e-3;
-				currentOffPmos[20] = 140.00e-3;
-				currentOffPmos[30] = 163.30e-3;
-				currentOffPmos[40] = 188.80e-3;
-				currentOffPmos[50] = 216.70e-3;
-				currentOffPmos[60] = 247.00e-3;
-				currentOffPmos[70] = 279.70e-3;
-				currentOffPmos[80] = 314.90e-3;
-				currentOffPmos[90] = 352.60e-3;
-				currentOffPmos[100]= 392.80e-3;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} else {
-				/* PTM model: 32nm_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.9;
-				vth = 442.034e-3;
-				phyGateLength = 2.8e-8;
-				capIdealGate = 8.375279e-10;
-				capFringe = 6.856677e-10;
-				effectiveResistanceMultiplier = 1.77;	/* from CACTI */
-				current_gmNmos=2.56E+02;
-				current_gmPmos=1.19E+02;			
-				currentOnNmos[0]   =600.20;
-				currentOnNmos[10]  =562.80;
-				currentOnNmos[20]  =528.20;
-				currentOnNmos[30]  =496.20;
-				currentOnNmos[40]  =466.80;
-				currentOnNmos[50]  =439.70;
-				currentOnNmos[60]  =414.80;
-				currentOnNmos[70]  =391.90;
-				currentOnNmos[80]  =370.70;
-				currentOnNmos[90]  =351.30;
-				currentOnNmos[100] =333.30;
-				currentOnPmos[0]   = 400.00;
-				currentOnPmos[10]  = 368.40;
-				currentOnPmos[20]  = 340.30;
-				currentOnPmos[30]  = 315.30;
-				currentOnPmos[40]  = 292.90;
-				currentOnPmos[50]  = 272.80;
-				currentOnPmos[60]  = 254.80;
-				currentOnPmos[70]  = 238.50;
-				currentOnPmos[80]  = 223.80;
-				currentOnPmos[90]  = 210.50;
-				currentOnPmos[100] = 198.40;
-				currentOffNmos[0]  = 100.10e-6;
-				currentOffNmos[10] = 143.60e-6;
-				currentOffNmos[20] = 202.10e-6;
-				currentOffNmos[30] = 279.30e-6;
-				currentOffNmos[40] = 379.50e-6;
-				currentOffNmos[50] = 507.50e-6;
-				currentOffNmos[60] = 668.80e-6;
-				currentOffNmos[70] = 869.20e-6;
-				currentOffNmos[80] = 1115.00e-6;
-				currentOffNmos[90] = 1415.00e-6;
-				currentOffNmos[100]= 1774.00e-6;
-				currentOffPmos[0]  = 100.10e-6;
-				currentOffPmos[10] = 140.70e-6;
-				currentOffPmos[20] = 194.00e-6;
-				currentOffPmos[30] = 262.50e-6;
-				currentOffPmos[40] = 349.30e-6;
-				currentOffPmos[50] = 457.70e-6;
-				currentOffPmos[60] = 591.20e-6;
-				currentOffPmos[70] = 753.70e-6;
-				currentOffPmos[80] = 949.30e-6;
-				currentOffPmos[90] = 1182.00e-6;
-				currentOffPmos[100]= 1457.00e-6;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			}
-		} else if (featureSizeInNano == 22) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 22nm.pm, from http://ptm.asu.edu/ */
-				vdd = 0.85;
-				vth = 208.9006e-3;
-				phyGateLength = 2.6e-8;
-				capIdealGate = 3.287e-10;
-				capFringe = 4.532e-10;
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=1.08E+03;
-				current_gmPmos=6.98E+02;			
-				currentOnNmos[0]   = 1.50e3;
-				currentOnNmos[10]  = 1.47e3;
-				currentOnNmos[20]  = 1.43e3;
-				currentOnNmos[30]  = 1.39e3;
-				currentOnNmos[40]  = 1.35e3;
-				currentOnNmos[50]  = 1.31e3;
-				currentOnNmos[60]  = 1.28e3;
-				currentOnNmos[70]  = 1.24e3;
-				currentOnNmos[80]  = 1.20e3;
-				currentOnNmos[90]  = 1.17e3;
-				currentOnNmos[100] = 1.13e3;
-				currentOnPmos[0]   = 1.32e3;
-				currentOnPmos[10]  = 1.25e3;
-				currentOnPmos[20]  = 1.19e3;
-				currentOnPmos[30]  = 1.13e3;
-				currentOnPmos[40]  = 1.07e3;
-				currentOnPmos[50]  = 1.02e3;
-				currentOnPmos[60]  = 0.97e3;
-				currentOnPmos[70]  = 0.92e3;
-				currentOnPmos[80]  = 0.88e3;
-				currentOnPmos[90]  = 0.84e3;
-				currentOnPmos[100] = 0.80e3;
-				currentOffNmos[0]  = 100.20e-3;	
-				currentOffNmos[10] = 120.40e-3;	
-				currentOffNmos[20] = 143.50e-3;	
-				currentOffNmos[30] = 169.50e-3;	
-				currentOffNmos[40] = 198.70e-3;	
-				currentOffNmos[50] = 231.20e-3;	
-				currentOffNmos[60] = 267.00e-3;	
-				currentOffNmos[70] = 306.30e-3;	
-				currentOffNmos[80] = 349.30e-3;	
-				currentOffNmos[90] = 396.00e-3;	
-				currentOffNmos[100]= 446.60e-3;	
-				currentOffPmos[0]  = 100.20e-3;
-				currentOffPmos[10] = 119.40e-3;
-				currentOffPmos[20] = 140.80e-3;
-				currentOffPmos[30] = 164.60e-3;
-				currentOffPmos[40] = 190.90e-3;
-				currentOffPmos[50] = 219.50e-3;
-				currentOffPmos[60] = 250.70e-3;
-				currentOffPmos[70] = 284.50e-3;
-				currentOffPmos[80] = 320.90e-3;
-				currentOffPmos[90] = 359.80e-3;
-				currentOffPmos[100]= 401.50e-3;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			} else {
-				/* PTM model: 22nm_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.85;
-				vth = 419.915e-3;
-				phyGateLength = 2.6e-8; 	
-				capIdealGate = 5.245e-10;
-				capFringe = 8.004e-10;
-				effectiveResistanceMultiplier = 1.77;	/* from CACTI */
-				current_gmNmos=4.56E+02;
-				current_gmPmos=1.85E+02;			
-				currentOnNmos[0]   = 791.90;
-				currentOnNmos[10]  = 756.40;
-				currentOnNmos[20]  = 722.20;
-				currentOnNmos[30]  = 689.40;
-				currentOnNmos[40]  = 658.10;
-				currentOnNmos[50]  = 628.30;
-				currentOnNmos[60]  = 600.00;
-				currentOnNmos[70]  = 573.30;
-				currentOnNmos[80]  = 548.00;
-				currentOnNmos[90]  = 524.20;
-				currentOnNmos[100] = 501.70;
-				currentOnPmos[0]   = 600.20;
-				currentOnPmos[10]  = 561.30;
-				currentOnPmos[20]  = 525.50;
-				currentOnPmos[30]  = 492.50;
-				currentOnPmos[40]  = 462.20;
-				currentOnPmos[50]  = 434.30;
-				currentOnPmos[60]  = 408.70;
-				currentOnPmos[70]  = 385.10;
-				currentOnPmos[80]  = 363.40;
-				currentOnPmos[90]  = 343.30;
-				currentOnPmos[100] = 324.80;
-				currentOffNmos[0]  = 100.00e-6;
-				currentOffNmos[10] = 147.30e-6;
-				currentOffNmos[20] = 212.10e-6;
-				currentOffNmos[30] = 299.60e-6;
-				currentOffNmos[40] = 415.30e-6;
-				currentOffNmos[50] = 565.80e-6;
-				currentOffNmos[60] = 758.90e-6;
-				currentOffNmos[70] = 1003.00e-6;
-				currentOffNmos[80] = 1307.00e-6;
-				currentOffNmos[90] = 1682.00e-6;
-				currentOffNmos[100]= 2139.00e-6;
-				currentOffPmos[0]  = 100.00e-6;
-				currentOffPmos[10] = 147.30e-6;
-				currentOffPmos[20] = 212.10e-6;
-				currentOffPmos[30] = 299.60e-6;
-				currentOffPmos[40] = 415.30e-6;
-				currentOffPmos[50] = 565.80e-6;
-				currentOffPmos[60] = 758.90e-6;
-				currentOffPmos[70] = 1003.00e-6;
-				currentOffPmos[80] = 1307.00e-6;
-				currentOffPmos[90] = 1682.00e-6;
-				currentOffPmos[100]= 2139.00e-6;
-				pnSizeRatio = currentOnNmos[0]/currentOnPmos[0];
-			}
-		} else if (featureSizeInNano == 14) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 14nfet_HP.pm,14pfet_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.8;
-				vth = 172.9868e-3;
-				heightFin = 3.7e-8;				
-				widthFin = 8e-9;
-				PitchFin = 4.8e-8;			
-				phyGateLength = 2.2e-8;
-				capIdealGate = 1.2573e-9;
-				capFringe = 0;
-				effectiveResistanceMultiplier = 1.51;	/* from CACTI */
-				current_gmNmos=1.33E+03;
-				current_gmPmos=7.83E+02;			
-				currentOnNmos[0]  = 1.686e3;
-				currentOnNmos[10] = 1.652e3;
-				currentOnNmos[20] = 1.607e3;
-				currentOnNmos[30] = 1.562e3;
-				currentOnNmos[40] = 1.517e3;
-				currentOnNmos[50] = 1.472e3;
-				currentOnNmos[60] = 1.439e3;
-				currentOnNmos[70] = 1.394e3;
-				currentOnNmos[80] = 1.349e3;
-				currentOnNmos[90] = 1.315e3;
-				currentOnNmos[100] =1.270e3;
-				currentOnPmos[0]  = 1.550e3;
-				currentOnPmos[10] = 1.468e3;
-				currentOnPmos[20] = 1.397e3;
-				currentOnPmos[30] = 1.327e3;
-				currentOnPmos[40] = 1.256e3;
-				currentOnPmos[50] = 1.198e3;
-				currentOnPmos[60] = 1.139e3;
-				currentOnPmos[70] = 1.080e3;
-				currentOnPmos[80] = 1.0336e3;
-				currentOnPmos[90] = 0.986e3;
-				currentOnPmos[100] =0.939e3;
-				currentOffNmos[0]  = 100.9152e-3;
-				currentOffNmos[10] = 150.0786e-3;
-				currentOffNmos[20] = 218.1063e-3;
-				currentOffNmos[30] = 310.359e-3;
-				currentOffNmos[40] = 433.1757e-3;
-				currentOffNmos[50] = 593.9313e-3;
-				currentOffNmos[60] = 801.0747e-3;
-				currentOffNmos[70] = 1.0641;
-				currentOffNmos[80] = 1.3938;
-				currentOffNmos[90] = 1.8016;
-				currentOffNmos[100] =2.30031;
-				currentOffPmos[0]  = 98.6503e-3;
-				currentOffPmos[10] = 157.5545e-3;
-				currentOffPmos[20] = 245.1751e-3;
-				currentOffPmos[30] = 372.5374e-3;
-				currentOffPmos[40] = 553.7661e-3;
-				currentOffPmos[50] = 806.5971e-3;
-				currentOffPmos[60] = 1.1529;
-				currentOffPmos[70] = 1.6190;
-				currentOffPmos[80] = 2.2361;
-				currentOffPmos[90] = 3.0405;
-				currentOffPmos[100] =4.0733;
-				pnSizeRatio = (int)(currentOnNmos[0]/currentOnPmos[0]);
-			} else {
-				/* PTM model: 14nfet_LP.pm,14pfet_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.8;
-				vth = 382.1222e-3;
-				heightFin = 3.7e-8;
-				widthFin = 8e-9;
-				PitchFin = 4.8e-8;
-				phyGateLength = 2.2e-8;
-				capIdealGate = 1.0572e-9;
-				capFringe = 0;
-				effectiveResistanceMultiplier = 1.76;	/* from CACTI */
-				current_gmNmos=6.02E+02;
-				current_gmPmos=2.36E+02;			
-				currentOnNmos[0]  = 893;
-				currentOnNmos[10] = 853;
-				currentOnNmos[20] = 814;
-				currentOnNmos[30] = 777;
-				currentOnNmos[40] = 742;
-				currentOnNmos[50] = 708;
-				currentOnNmos[60] = 677;
-				currentOnNmos[70] = 646;
-				currentOnNmos[80] = 618;
-				currentOnNmos[90] = 591;
-				currentOnNmos[100] =565;
-				currentOnPmos[0]  = 820;
-				currentOnPmos[10] = 767;
-				currentOnPmos[20] = 718;
-				currentOnPmos[30] = 672;
-				currentOnPmos[40] = 631;
-				currentOnPmos[50] = 593;
-				currentOnPmos[60] = 558;
-				currentOnPmos[70] = 526;
-				currentOnPmos[80] = 496;
-				currentOnPmos[90] = 469;
-				currentOnPmos[100] =443;
-				currentOffNmos[0]  = 99.7866e-6;
-				currentOffNmos[10] = 184.4553e-6;
-				currentOffNmos[20] = 328.7707e-6;
-				currentOffNmos[30] = 566.8658e-6;
-				currentOffNmos[40] = 948.1816e-6;
-				currentOffNmos[50] = 1.5425e-3;
-				currentOffNmos[60] = 2.4460e-3;
-				currentOffNmos[70] = 3.7885e-3;
-				currentOffNmos[80] = 5.7416e-3;
-				currentOffNmos[90] = 8.5281e-3;
-				currentOffNmos[100] =1.24327e-2;;
-				currentOffPmos[0]  = 102.3333e-6;
-				currentOffPmos[10] = 203.4774e-6;
-				currentOffPmos[20] = 389.0187e-6;
-				currentOffPmos[30] = 717.5912e-6;
-				currentOffPmos[40] = 1.2810e-3;
-				currentOffPmos[50] = 2.2192e-3;
-				currentOffPmos[60] = 3.7395e-3;
-				currentOffPmos[70] = 6.1428e-3;
-				currentOffPmos[80] = 9.8554e-3;
-				currentOffPmos[90] = 1.54702e-2;
-				currentOffPmos[100] =2.37959e-2;
-				pnSizeRatio = (int)(currentOnNmos[0]/currentOnPmos[0]);
-			}
-		} else if (featureSizeInNano == 10) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 10nfet_HP.pm,10pfet_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.75;
-				vth = 182.8605e-3;
-				heightFin = 4.2e-8;
-				widthFin = 6e-9;
-				PitchFin = 3.6e-8;			
-				phyGateLength = 2.0e-8;
-				capIdealGate = 1.1418e-9;
-				capFringe = 0;
-				effectiveResistanceMultiplier = 1.49;	/* from CACTI */
-				current_gmNmos=1.56E+03;
-				current_gmPmos=8.02E+02;			
-				currentOnNmos[0]  = 1.769e3;
-				currentOnNmos[10] = 1.734e3;
-				currentOnNmos[20] = 1.686e3;
-				currentOnNmos[30] = 1.639e3;
-				currentOnNmos[40] = 1.592e3;
-				currentOnNmos[50] = 1.545e3;
-				currentOnNmos[60] = 1.510e3;
-				currentOnNmos[70] = 1.462e3;
-				currentOnNmos[80] = 1.415e3;
-				currentOnNmos[90] = 1.380e3;
-				currentOnNmos[100] =1.333e3;
-				currentOnPmos[0]  = 1.626e3;
-				currentOnPmos[10] = 1.540e3;
-				currentOnPmos[20] = 1.466e3;
-				currentOnPmos[30] = 1.392e3;
-				currentOnPmos[40] = 1.318e3;
-				currentOnPmos[50] = 1.256e3;
-				currentOnPmos[60] = 1.195e3;
-				currentOnPmos[70] = 1.133e3;
-				currentOnPmos[80] = 1.084e3;
-				currentOnPmos[90] = 1.035e3;
-				currentOnPmos[100] =0.985e3;
-				currentOffNmos[0]  = 100.1203e-3;
-				currentOffNmos[10] = 148.6272e-3;
-				currentOffNmos[20] = 215.6467e-3;
-				currentOffNmos[30] = 306.4157e-3;
-				currentOffNmos[40] = 427.1264e-3;
-				currentOffNmos[50] = 584.9857e-3;
-				currentOffNmos[60] = 788.2578e-3;
-				currentOffNmos[70] = 1.0463; 
-				currentOffNmos[80] = 1.3695; 
-				currentOffNmos[90] = 1.7694; 
-				currentOffNmos[100] =2.2584; 
-				currentOffPmos[0]  = 1.6268e-3;
-				currentOffPmos[10] = 157.8505e-3;
-				currentOffPmos[20] = 245.2725e-3;
-				currentOffPmos[30] = 372.2051e-3;
-				currentOffPmos[40] = 552.6667e-3;
-				currentOffPmos[50] = 804.2786e-3;
-				currentOffPmos[60] = 1.1488; 
-				currentOffPmos[70] = 1.6125; 
-				currentOffPmos[80] = 2.2268; 
-				currentOffPmos[90] = 3.0281; 
-				currentOffPmos[100] =4.0584;
-				pnSizeRatio = (int)(currentOnNmos[0]/currentOnPmos[0]);
-	  		} else {
-				/* PTM model: 10nfet_LP.pm,10pfet_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.75;
-				vth = 390.5541e-3;
-				heightFin = 4.2e-8;		
-				widthFin = 6e-9;		
-				PitchFin = 3.6e-8;				
-				phyGateLength = 2e-8;	
-				capIdealGate = 9.418984e-10;
-				capFringe = 0;
-				effectiveResistanceMultiplier = 1.73;	/* from CACTI */
-				current_gmNmos=8.22E+02;
-				current_gmPmos=1.90E+02;			
-				currentOnNmos[0]  = 862;
-				currentOnNmos[10] = 824;
-				currentOnNmos[20] = 787;
-				currentOnNmos[30] = 751;
-				currentOnNmos[40] = 717;
-				currentOnNmos[50] = 684;
-				currentOnNmos[60] = 654;
-				currentOnNmos[70] = 624;
-				currentOnNmos[80] = 597;
-				currentOnNmos[90] = 571;
-				currentOnNmos[100] =546;
-				currentOnPmos[0]  = 775;  
-				currentOnPmos[10] = 725;
-				currentOnPmos[20] = 678;
-				currentOnPmos[30] = 636;
-				currentOnPmos[40] = 597;
-				currentOnPmos[50] = 561;
-				currentOnPmos[60] = 527;
-				currentOnPmos[70] = 497;
-				currentOnPmos[80] = 469;
-				currentOnPmos[90] = 443;
-				currentOnPmos[100] =419;
-				currentOffNmos[0]  = 99.6973e-6;
-				currentOffNmos[10] = 184.4892e-6;
-				currentOffNmos[20] = 329.1615e-6;
-				currentOffNmos[30] = 568.0731e-6;
-				currentOffNmos[40] = 951.0401e-6;
-				currentOffNmos[50] = 1.5484e-3;
-				currentOffNmos[60] = 2.4574e-3;
-				currentOffNmos[70] = 3.8090e-3;
-				currentOffNmos[80] = 5.7767e-3;
-				currentOffNmos[90] = 8.5862e-3;
-				currentOffNmos[100] =1.2525e-2;
-				currentOffPmos[0]  = 100.5839e-6;
-				currentOffPmos[10] = 200.2609e-6;
-				currentOffPmos[20] = 383.3239e-6;
-				currentOffPmos[30] = 707.8499e-6;
-				currentOffPmos[40] = 1.2649e-3;
-				currentOffPmos[50] = 2.1932e-3;
-				currentOffPmos[60] = 3.6987e-3;
-				currentOffPmos[70] = 6.0804e-3;
-				currentOffPmos[80] = 9.7622e-3;
-				currentOffPmos[90] = 1.53340e-2;
-				currentOffPmos[100] =2.36007e-2;
-				pnSizeRatio = (int)(currentOnNmos[0]/currentOnPmos[0]);
-			}
-		} else if (featureSizeInNano == 7) {
-			if (deviceRoadmap == HP) {
-				/* PTM model: 7nfet_HP.pm,7pfet_HP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.7;
-				vth = 192.2339e-3;
-				heightFin = 5.2e-8;
-				widthFin = 6e-9;
-				PitchFin = 3.0e-8;			
-				phyGateLength = 1.8e-8;
-				capIdealGate = 1.0487e-9;
-				capFringe = 0;
-				effectiveResistanceMultiplier = 1.45;	/* from CACTI */
-				current_gmNmos=1.91E+03;
-				current_gmPmos=8.02E+02;			
-				currentOnNmos[0]   = 1912 ;
-				currentOnNmos[10]  = 1874;
-				currentOnNmos[20]  = 1823;
-				currentOnNmos[30]  = 1772;
-				currentOnNmos[40]  = 1721;
-				currentOnNmos[50]  = 1670;
-				currentOnNmos[60]  = 1632;
-				currentOnNmos[70]  = 1581;
-				currentOnNmos[80]  = 1530;
-				currentOnNmos[90]  = 1491;
-				currentOnNmos[100] = 1440;
-				currentOnPmos[0]   = 1685; 
-				currentOnPmos[10]  = 1596; 
-				currentOnPmos[20]  = 1519; 
-				currentOnPmos[30]  = 1442; 
-				currentOnPmos[40]  = 1366; 
-				currentOnPmos[50]  = 1302; 
-				currentOnPmos[60]  = 1238; 
-				currentOnPmos[70]  = 1174; 
-				currentOnPmos[80]  = 1123; 
-				currentOnPmos[90]  = 1072; 
-				currentOnPmos[100] = 1021;
-				currentOffNmos[0]  = 100.2258e-3;
-				currentOffNmos[10] = 149.0252e-3;
-				currentOffNmos[20] = 216.5654e-3;
-				currentOffNmos[30] = 308.1967e-3;
-				currentOffNmos[40] = 430.2635e-3;
-				currentOffNmos[50] = 590.1731e-3;
-				currentOffNmos[60] = 796.4489e-3;
-				currentOffNmos[70] = 1.0588;
-				currentOffNmos[80] = 1.3880;
-				currentOffNmos[90] = 1.7960;
-				currentOffNmos[100]= 2.2961;
-				currentOffPmos[0]  = 97.9484e-3  ;
-				currentOffPmos[10] = 156.3424e-3 ;
-				currentOffPmos[20] = 243.1919e-3;
-				currentOffPmos[30] = 369.4499e-3 ;
-				currentOffPmos[40] = 549.1886e-3 ;
-				currentOffPmos[50] = 800.1479e-3;
-				currentOffPmos[60] = 1.1443      ;
-				currentOffPmos[70] = 1.6083      ;
-				currentOffPmos[80] = 2.2242      ;
-				currentOffPmos[90] = 3.0295      ;
-				currentOffPmos[100]= 4.0674      ;
-				pnSizeRatio = (int)(currentOnNmos[0]/currentOnPmos[0]);
-			} else {
-				/* PTM model: 7nfet_LP.pm,7pfet_LP.pm, from http://ptm.asu.edu/ */
-				vdd = 0.7;
-				vth = 402.5252e-3;
-				heightFin = 5.2e-8;
-				widthFin = 6e-9;
-				PitchFin = 3.0e-8;			
-				phyGateLength = 1.8e-8;
-				capIdealGate = 8.49489e-10;
-				capFringe = 0;
-				effectiveResistanceMultiplier = 1.73;	/* from CACTI */
-				current_gmNmos=8.22E+02;
-				current_gmPmos=1.45E+02;			
-				currentOnNmos[0]  = 822;
-				currentOnNmos[10] = 786; 
-				currentOnNmos[20] = 750; 
-				currentOnNmos[30] = 716; 
-				currentOnNmos[40] = 684; 
-				currentOnNmos[50] = 653; 
-				currentOnNmos[60] = 624; 
-				currentOnNmos[70] = 595; 
-				currentOnNmos[80] = 569; 
-				currentOnNmos[90] = 545;
-				currentOnNmos[100]= 521; 
-				currentOnPmos[0]  = 737;
-				currentOnPmos[10] = 689;
-				currentOnPmos[20] = 645;
-				currentOnPmos[30] = 605;
-				currentOnPmos[40] = 567;
-				currentOnPmos[50] = 533;
-				currentOnPmos[60] = 501;
-				currentOnPmos[70] = 473;
-				currentOnPmos[80] = 446;
-				currentOnPmos[90] = 421;
-				currentOnPmos[100] =398;
-				currentOffNmos[0]  = 1.00E-04;
-				currentOffNmos[10] = 1.85E-04;
-				currentOffNmos[20] = 3.32E-04;
-				currentOffNmos[30] = 5.74E-04;
-				currentOffNmos[40] = 9.62E-04;
-				currentOffNmos[50] = 1.5695e-3;
-				currentOffNmos[60] = 2.4953e-3;
-				currentOffNmos[70] = 3.8744e-3 ;
-				currentOffNmos[80] = 5.8858e-3 ;
-				currentOffNmos[90] = 8.7624e-3;
-				currentOffNmos[100] =1.28025e-2;
-				currentOffPmos[0]  = 100.9536e-6;
-				currentOffPmos[10] = 201.3937e-6;
-				currentOffPmos[20] = 386.2086e-6;
-				currentOffPmos[30] = 714.4288e-6;
-				currentOffPmos[40] = 1.2788e-3;
-				currentOffPmos[50] = 2.2207e-3;
-				currentOffPmos[60] = 3.7509e-3;
-				currentOffPmos[70] = 6.1750e-3;
-				currentOffPmos[80] = 9.9278e-3;
-				currentOffPmos[90] = 1.56146e-2;
-				currentOffPmos[100] =2.40633e-2;
-				pnSizeRatio = (int)(currentOnNmos[0]/currentOnPmos[0]);
-			}
-		} else {
+	int index = FindDevice(transistorType, featureSizeInNano, deviceRoadmap);
+	if (index < 0) {
+		if (transistorType == conventional) {
 			cout<<"Error: CMOS Technology node "<< featureSizeInNano <<"nm is not supported"<<endl;
-	        exit(-1);
-		}
-	
-	} else if (transistorType == FET_2D) {
-		if (featureSizeInNano == 22) {
-			if (deviceRoadmap == HP) {
-				/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
-				// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
-				vdd = 0.8;
-				vth = 0.2614;
-				phyGateLength = 2.2e-8;
-				capIdealGate = 2.398e-9;
-				capFringe = 3e-11;
-				pnSizeRatio = 1;						/* from CACTI */
-				effectiveResistanceMultiplier = 1.54;	/* from CACTI */
-				current_gmNmos=9.887e+3; 
-				current_gmPmos=9.887e+3;
-				currentOnNmos[0]   = 5433; 
-				currentOnNmos[10]  = 5433; 
-				currentOnNmos[20]  = 5433; 
-				currentOnNmos[30]  = 5433; 
-				currentOnNmos[40]  = 5433; 
-				currentOnNmos[50]  = 5433; 
-				currentOnNmos[60]  = 5433; 
-				currentOnNmos[70]  = 5433; 
-				currentOnNmos[80]  = 5433; 
-				currentOnNmos[90]  = 5433; 
-				currentOnNmos[100] = 5433; 
-				currentOnPmos[0]   = 5433; 
-				currentOnPmos[10]  = 5433; 
-				currentOnPmos[20]  = 5433; 
-				currentOnPmos[30]  = 5433; 
-				currentOnPmos[40]  = 5433; 
-				currentOnPmos[50]  = 5433; 
-				currentOnPmos[60]  = 5433; 
-				currentOnPmos[70]  = 5433; 
-				currentOnPmos[80]  = 5433; 
-				currentOnPmos[90]  = 5433; 
-				currentOnPmos[100] = 5433; 
-				currentOffNmos[0]  = 0.1; 
-				currentOffNmos[10] = 0.1; 
-				currentOffNmos[20] = 0.1; 
-				currentOffNmos[30] = 0.1; 
-				currentOffNmos[40] = 0.1; 
-				currentOffNmos[50] = 0.1; 
-				currentOffNmos[60] = 0.1; 
-				currentOffNmos[70] = 0.1; 
-				currentOffNmos[80] = 0.1; 
-				currentOffNmos[90] = 0.1; 
-				currentOffNmos[100]= 0.1; 
-				currentOffPmos[0]  = 0.1; 
-				currentOffPmos[10] = 0.1; 
-				currentOffPmos[20] = 0.1; 
-				currentOffPmos[30] = 0.1; 
-				currentOffPmos[40] = 0.1; 
-				currentOffPmos[50] = 0.1; 
-				currentOffPmos[60] = 0.1; 
-				currentOffPmos[70] = 0.1; 
-				currentOffPmos[80] = 0.1; 
-				currentOffPmos[90] = 0.1; 
-				currentOffPmos[100]= 0.1;
-			} else {
-				/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
-				// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
-				vdd = 0.8;
-				vth = 0.4015;
-				phyGateLength = 2.2e-8;
-				capIdealGate = 2.398e-9;
-				capFringe = 3e-11;
-				pnSizeRatio = 1;						/* from CACTI */
-				effectiveResistanceMultiplier = 1.77;	/* from CACTI */
-				current_gmNmos=9.374e+3; 
-				current_gmPmos=9.374e+3;
-				currentOnNmos[0]   = 4026; 
-				currentOnNmos[10]  = 4026; 
-				currentOnNmos[20]  = 4026; 
-				currentOnNmos[30]  = 4026; 
-				currentOnNmos[40]  = 4026; 
-				currentOnNmos[50]  = 4026; 
-				currentOnNmos[60]  = 4026; 
-				currentOnNmos[70]  = 4026; 
-				currentOnNmos[80]  = 4026; 
-				currentOnNmos[90]  = 4026; 
-				currentOnNmos[100] = 4026; 
-				currentOnPmos[0]   = 4026; 
-				currentOnPmos[10]  = 4026; 
-				currentOnPmos[20]  = 4026; 
-				currentOnPmos[30]  = 4026; 
-				currentOnPmos[40]  = 4026; 
-				currentOnPmos[50]  = 4026; 
-				currentOnPmos[60]  = 4026; 
-				currentOnPmos[70]  = 4026; 
-				currentOnPmos[80]  = 4026; 
-				currentOnPmos[90]  = 4026; 
-				currentOnPmos[100] = 4026; 
-				currentOffNmos[0]  = 1e-4; 
-				currentOffNmos[10] = 1e-4; 
-				currentOffNmos[20] = 1e-4; 
-				currentOffNmos[30] = 1e-4; 
-				currentOffNmos[40] = 1e-4; 
-				currentOffNmos[50] = 1e-4; 
-				currentOffNmos[60] = 1e-4; 
-				currentOffNmos[70] = 1e-4; 
-				currentOffNmos[80] = 1e-4; 
-				currentOffNmos[90] = 1e-4; 
-				currentOffNmos[100]= 1e-4; 
-				currentOffPmos[0]  = 1e-4; 
-				currentOffPmos[10] = 1e-4; 
-				currentOffPmos[20] = 1e-4; 
-				currentOffPmos[30] = 1e-4; 
-				currentOffPmos[40] = 1e-4; 
-				currentOffPmos[50] = 1e-4; 
-				currentOffPmos[60] = 1e-4; 
-				currentOffPmos[70] = 1e-4; 
-				currentOffPmos[80] = 1e-4; 
-				currentOffPmos[90] = 1e-4; 
-				currentOffPmos[100]= 1e-4;
-			}
-		} else if (featureSizeInNano == 14) {
-			if (deviceRoadmap == HP) {
-				/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
-				// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
-				vdd = 0.8;
-				vth = 0.2614;
-				phyGateLength = 1.4e-8;
-				capIdealGate = 1.526e-9;
-				capFringe = 3e-11;
-				pnSizeRatio = 1;						/* from CACTI */
-				effectiveResistanceMultiplier = 1.51;	/* from CACTI */
-				current_gmNmos=1.005e+4; 
-				current_gmPmos=1.005e+4;
-				currentOnNmos[0]   = 5514; 
-				currentOnNmos[10]  = 5514; 
-				currentOnNmos[20]  = 5514; 
-				currentOnNmos[30]  = 5514; 
-				currentOnNmos[40]  = 5514; 
-				currentOnNmos[50]  = 5514; 
-				currentOnNmos[60]  = 5514; 
-				currentOnNmos[70]  = 5514; 
-				currentOnNmos[80]  = 5514; 
-				currentOnNmos[90]  = 5514; 
-				currentOnNmos[100] = 5514; 
-				currentOnPmos[0]   = 5514; 
-				currentOnPmos[10]  = 5514; 
-				currentOnPmos[20]  = 5514; 
-				currentOnPmos[30]  = 5514; 
-				currentOnPmos[40]  = 5514; 
-				currentOnPmos[50]  = 5514; 
-				currentOnPmos[60]  = 5514; 
-				currentOnPmos[70]  = 5514; 
-				currentOnPmos[80]  = 5514; 
-				currentOnPmos[90]  = 5514; 
-				currentOnPmos[100] = 5514; 
-				currentOffNmos[0]  = 0.1; 
-				currentOffNmos[10] = 0.1; 
-				currentOffNmos[20] = 0.1; 
-				currentOffNmos[30] = 0.1; 
-				currentOffNmos[40] = 0.1; 
-				currentOffNmos[50] = 0.1; 
-				currentOffNmos[60] = 0.1; 
-				currentOffNmos[70] = 0.1; 
-				currentOffNmos[80] = 0.1; 
-				currentOffNmos[90] = 0.1; 
-				currentOffNmos[100]= 0.1; 
-				currentOffPmos[0]  = 0.1; 
-				currentOffPmos[10] = 0.1; 
-				currentOffPmos[20] = 0.1; 
-				currentOffPmos[30] = 0.1; 
-				currentOffPmos[40] = 0.1; 
-				currentOffPmos[50] = 0.1; 
-				currentOffPmos[60] = 0.1; 
-				currentOffPmos[70] = 0.1; 
-				currentOffPmos[80] = 0.1; 
-				currentOffPmos[90] = 0.1; 
-				currentOffPmos[100]= 0.1;
-			} else {	//(deviceRoadmap == LSTP)
-				/* Monolayer MoS2 Transistor Beyond the Technology Roadmap, 10.1109/TED.2012.2218283 */
-				// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
-				vdd = 0.8;
-				vth = 0.4015;
-				phyGateLength = 1.4e-8;
-				capIdealGate = 1.526e-9;
-				capFringe = 3e-11;
-				pnSizeRatio = 1;						/* from CACTI */
-				effectiveResistanceMultiplier = 1.76;	/* from CACTI */
-				current_gmNmos=9.531e+3; 
-				current_gmPmos=9.531e+3;
-				currentOnNmos[0]   = 4085; 
-				currentOnNmos[10]  = 4085; 
-				currentOnNmos[20]  = 4085; 
-				currentOnNmos[30]  = 4085; 
-				currentOnNmos[40]  = 4085; 
-				currentOnNmos[50]  = 4085; 
-				currentOnNmos[60]  = 4085; 
-				currentOnNmos[70]  = 4085; 
-				currentOnNmos[80]  = 4085; 
-				currentOnNmos[90]  = 4085; 
-				currentOnNmos[100] = 4085; 
-				currentOnPmos[0]   = 4085; 
-				currentOnPmos[10]  = 4085; 
-				currentOnPmos[20]  = 4085; 
-				currentOnPmos[30]  = 4085; 
-				currentOnPmos[40]  = 4085; 
-				currentOnPmos[50]  = 4085; 
-				currentOnPmos[60]  = 4085; 
-				currentOnPmos[70]  = 4085; 
-				currentOnPmos[80]  = 4085; 
-				currentOnPmos[90]  = 4085; 
-				currentOnPmos[100] = 4085; 
-				currentOffNmos[0]  = 1e-4; 
-				currentOffNmos[10] = 1e-4; 
-				currentOffNmos[20] = 1e-4; 
-				currentOffNmos[30] = 1e-4; 
-				currentOffNmos[40] = 1e-4; 
-				currentOffNmos[50] = 1e-4; 
-				currentOffNmos[60] = 1e-4; 
-				currentOffNmos[70] = 1e-4; 
-				currentOffNmos[80] = 1e-4; 
-				currentOffNmos[90] = 1e-4; 
-				currentOffNmos[100]= 1e-4; 
-				currentOffPmos[0]  = 1e-4; 
-				currentOffPmos[10] = 1e-4; 
-				currentOffPmos[20] = 1e-4; 
-				currentOffPmos[30] = 1e-4; 
-				currentOffPmos[40] = 1e-4; 
-				currentOffPmos[50] = 1e-4; 
-				currentOffPmos[60] = 1e-4; 
-				currentOffPmos[70] = 1e-4; 
-				currentOffPmos[80] = 1e-4; 
-				currentOffPmos[90] = 1e-4; 
-				currentOffPmos[100]= 1e-4;
-			}
-		} else {
+		} else if (transistorType == FET_2D) {
 			cout<<"Error: 2D FET Technology node "<< featureSizeInNano <<"nm is not supported"<<endl;
-			exit(-1);
-		}
-
-	} else if (transistorType == TFET) {	// TODO
-		if (featureSizeInNano == 22) {
-			if (deviceRoadmap == HP) {
-				// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
-				cout << "[TFET] Warning: No HP profile. Will use LSTP profile." << endl;
-				// Same as LSTP
-				vdd = 0.5;
-				vth = 0.17;
-				phyGateLength = 2e-8;
-				capIdealGate = 6.9e-10;
-				capFringe = 2e-10;
-				pnSizeRatio = 1;                        /* from CACTI */
-				effectiveResistanceMultiplier = 1.54;   /* from CACTI */
-				current_gmNmos=4.37e+2;
-				current_gmPmos=4.37e+2;
-				currentOnNmos[0]   = 90.51;
-				currentOnNmos[10]  = 90.51;
-				currentOnNmos[20]  = 90.51;
-				currentOnNmos[30]  = 90.51;
-				currentOnNmos[40]  = 90.51;
-				currentOnNmos[50]  = 90.51;
-				currentOnNmos[60]  = 90.51;
-				currentOnNmos[70]  = 90.51;
-				currentOnNmos[80]  = 90.51;
-				currentOnNmos[90]  = 90.51;
-				currentOnNmos[100] = 90.51;
-				currentOnPmos[0]   = 90.51;
-				currentOnPmos[10]  = 90.51;
-				currentOnPmos[20]  = 90.51;
-				currentOnPmos[30]  = 90.51;
-				currentOnPmos[40]  = 90.51;
-				currentOnPmos[50]  = 90.51;
-				currentOnPmos[60]  = 90.51;
-				currentOnPmos[70]  = 90.51;
-				currentOnPmos[80]  = 90.51;
-				currentOnPmos[90]  = 90.51;
-				currentOnPmos[100] = 90.51;
-				currentOffNmos[0]  = 0.0023;
-				currentOffNmos[10] = 0.0023;
-				currentOffNmos[20] = 0.0023;
-				currentOffNmos[30] = 0.0023;
-				currentOffNmos[40] = 0.0023;
-				currentOffNmos[50] = 0.0023;
-				currentOffNmos[60] = 0.0023;
-				currentOffNmos[70] = 0.0023;
-				currentOffNmos[80] = 0.0023;
-				currentOffNmos[90] = 0.0023;
-				currentOffNmos[100]= 0.0023;
-				currentOffPmos[0]  = 0.0023;
-				currentOffPmos[10] = 0.0023;
-				currentOffPmos[20] = 0.0023;
-				currentOffPmos[30] = 0.0023;
-				currentOffPmos[40] = 0.0023;
-				currentOffPmos[50] = 0.0023;
-				currentOffPmos[60] = 0.0023;
-				currentOffPmos[70] = 0.0023;
-				currentOffPmos[80] = 0.0023;
-				currentOffPmos[90] = 0.0023;
-				currentOffPmos[100]= 0.0023;
-			} else {	//(deviceRoadmap == LSTP)
-				// FIXME: currentOnNmos/currentOnPmos/currentOffNmos/currentOffPmos at temperatures other than 300K
-				vdd = 0.5;
-				vth = 0.17;
-				phyGateLength = 2e-8;
-				capIdealGate = 6.9e-10;
-				capFringe = 2e-10;
-				pnSizeRatio = 1;                        /* from CACTI */
-				effectiveResistanceMultiplier = 1.54;   /* from CACTI */
-				current_gmNmos=4.37e+2;
-				current_gmPmos=4.37e+2;
-				currentOnNmos[0]   = 90.51;
-				currentOnNmos[10]  = 90.51;
-				currentOnNmos[20]  = 90.51;
-				currentOnNmos[30]  = 90.51;
-				currentOnNmos[40]  = 90.51;
-				currentOnNmos[50]  = 90.51;
-				currentOnNmos[60]  = 90.51;
-				currentOnNmos[70]  = 90.51;
-				currentOnNmos[80]  = 90.51;
-				currentOnNmos[90]  = 90.51;
-				currentOnNmos[100] = 90.51;
-				currentOnPmos[0]   = 90.51;
-				currentOnPmos[10]  = 90.51;
-				currentOnPmos[20]  = 90.51;
-				currentOnPmos[30]  = 90.51;
-				currentOnPmos[40]  = 90.51;
-				currentOnPmos[50]  = 90.51;
-				currentOnPmos[60]  = 90.51;
-				currentOnPmos[70]  = 90.51;
-				currentOnPmos[80]  = 90.51;
-				currentOnPmos[90]  = 90.51;
-				currentOnPmos[100] = 90.51;
-				currentOffNmos[0]  = 0.0023;
-				currentOffNmos[10] = 0.0023;
-				currentOffNmos[20] = 0.0023;
-				currentOffNmos[30] = 0.0023;
-				currentOffNmos[40] = 0.0023;
-				currentOffNmos[50] = 0.0023;
-				currentOffNmos[60] = 0.0023;
-				currentOffNmos[70] = 0.0023;
-				currentOffNmos[80] = 0.0023;
-				currentOffNmos[90] = 0.0023;
-				currentOffNmos[100]= 0.0023;
-				currentOffPmos[0]  = 0.0023;
-				currentOffPmos[10] = 0.0023;
-				currentOffPmos[20] = 0.0023;
-				currentOffPmos[30] = 0.0023;
-				currentOffPmos[40] = 0.0023;
-				currentOffPmos[50] = 0.0023;
-				currentOffPmos[60] = 0.0023;
-				currentOffPmos[70] = 0.0023;
-				currentOffPmos[80] = 0.0023;
-				currentOffPmos[90] = 0.0023;
-				currentOffPmos[100]= 0.0023;
-			}
 		} else {
 			cout<<"Error: TFET Technology node "<< featureSizeInNano <<"nm is not supported"<<endl;
-			exit(-1);
 		}
+		return false;
+	}
+	const DeviceRecord *device = &deviceTable[index];
+	if (transistorType == TFET && deviceRoadmap == HP) {
+		cout << "[TFET] Warning: No HP profile. Will use LSTP profile." << endl;
 	}
+	vdd = device->vdd;
+	vth = device->vth;
+	heightFin = device->heightFin;
+	widthFin = device->widthFin;
+	PitchFin = device->PitchFin;
+	phyGateLength = device->phyGateLength;
+	capIdealGate = device->capIdealGate;
+	capFringe = device->capFringe;
+	effectiveResistanceMultiplier = device->effectiveResistanceMultiplier;
+	current_gmNmos = device->current_gmNmos;
+	current_gmPmos = device->current_gmPmos;
+	currentOnNmos = device->currentOnNmos;
+	currentOnPmos = device->currentOnPmos;
+	currentOffNmos = device->currentOffNmos;
+	currentOffPmos = device->currentOffPmos;
+	pnSizeRatio = device->pnSizeRatio;
+	
 	if (featureSizeInNano >= 22) {
 		capOverlap = capIdealGate * 0.2;
 	} else {
@@ -1464,41 +315,39 @@ void Technology::Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap
 	/* Properties not used so far */
 	capPolywire = 0.0;	/* TO-DO: we need to find the values */
 
-	/* Interpolate */
-	for (int i = 1; i < 100; i++) {
-		if (i % 10) {
-			double a = currentOnNmos[i / 10 * 10];
-			double b = currentOnNmos[i / 10 * 10 + 10];
-			currentOnNmos[i] = a + (b-a) * (i % 10) / 10;
-		}
-	}
+	initialized = true;
+	return true;
+}
 
-	for (int i = 1; i < 100; i++) {
-		if (i % 10) {
-			double a = currentOnPmos[i / 10 * 10];
-			double b = currentOnPmos[i / 10 * 10 + 10];
-			currentOnPmos[i] = a + (b-a) * (i % 10) / 10;
-		}
+/* Linear interpolation on the 10K grid, with the temperature clamped to 300K~400K */
+static double DeviceCurrent(const double *current, double temperature) {
+	double t = min(max(temperature - 300, 0.0), 100.0);
+	int i = (int)(t / 10);
+	double fraction = t - i*10;
+	if (fraction == 0) {
+		return current[i];
 	}
+	double a = current[i];
+	double b = current[i + 1];
+	return a + (b-a) * fraction / 10;
+}
 
-	for (int i = 1; i < 100; i++) {
-		if (i % 10) {
-			double a = currentOffNmos[i / 10 * 10];
-			double b = currentOffNmos[i / 10 * 10 + 10];
-			currentOffNmos[i] = a + (b-a) * (i % 10) / 10;
-		}
-	}
+double Technology::CurrentOnNmos(double temperature) const {
+	return DeviceCurrent(currentOnNmos, temperature);
+}
 
-	for (int i = 1; i < 100; i++) {
-		if (i % 10) {
-			double a = currentOffPmos[i / 10 * 10];
-			double b = currentOffPmos[i / 10 * 10 + 10];
-			currentOffPmos[i] = a + (b-a) * (i % 10) / 10;
-		}
-	}
+double Technology::CurrentOnPmos(double temperature) const {
+	return DeviceCurrent(currentOnPmos, temperature);
+}
 
-	initialized = true;
+double Technology::CurrentOffNmos(double temperature) const {
+	return DeviceCurrent(currentOffNmos, temperature);
 }
+
+double Technology::CurrentOffPmos(double temperature) const {
+	return DeviceCurrent(currentOffPmos, temperature);
+}
+
 void Technology::PrintProperty() {
 	// TODO
 }
@@ -48,7 +48,11 @@ public:
 
 	/* Functions */
 	void PrintProperty();
-	void Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap, TransistorType _transistorType);
+	bool Initialize(int _featureSizeInNano, DeviceRoadmap _deviceRoadmap, TransistorType _transistorType);
+	double CurrentOnNmos(double temperature) const;		/* Unit: A/m, temperature in K, clamped to 300K~400K */
+	double CurrentOnPmos(double temperature) const;
+	double CurrentOffNmos(double temperature) const;
+	double CurrentOffPmos(double temperature) const;
 	
 	/* Properties */
 	bool initialized;	/* Initialization flag */
@@ -72,10 +76,10 @@ public:
 	double buildInPotential;	/* Bottom junction built-in potential(PB in BSIM4 model), Unit: V */	
 	double pnSizeRatio;		/* PMOS to NMOS size ratio */
 	double effectiveResistanceMultiplier;	/* Extra resistance due to vdsat */
-	double currentOnNmos[101];		/* NMOS saturation current, Unit: A/m */
-	double currentOnPmos[101];		/* PMOS saturation current, Unit: A/m */
-	double currentOffNmos[101];	/* NMOS off current (from 300K to 400K), Unit: A/m */
-	double currentOffPmos[101]; /* PMOS off current (from 300K to 400K), Unit: A/m */
+	const double *currentOnNmos;	/* NMOS saturation current (300K to 400K every 10K, 11 points in the device table), Unit: A/m */
+	const double *currentOnPmos;	/* PMOS saturation current (300K to 400K every 10K), Unit: A/m */
+	const double *currentOffNmos;	/* NMOS off current (300K to 400K every 10K), Unit: A/m */
+	const double *currentOffPmos;	/* PMOS off current (300K to 400K every 10K), Unit: A/m */
     double current_gmNmos;		/* NMOS current at 0.7*vdd for gm calculation, Unit: A/m/V*/ 
     double current_gmPmos;		/* PMOS current at 0.7*vdd for gm calculation, Unit: A/m/V*/ 
   
@@ -54,48 +54,13 @@
 #include "formula.h"
 #include "Param.h"
 #include "Tile.h"
+#include "SimContext.h"
 
 using namespace std;
 
 extern Param *param;
-int numInBufferCore = 0;
-int numOutBufferCore = 0;										 
 
-SubArray *subArrayInPE;
-Buffer *inputBufferCM;
-Buffer *outputBufferCM;
-HTree *hTreeCM;
-AdderTree *accumulationCM;
-Sigmoid *sigmoidCM;
-BitShifter *reLuCM;
-Buffer *inputBufferNM;
-Buffer *outputBufferNM;
-HTree *hTreeNM;
-AdderTree *accumulationNM;
-Sigmoid *sigmoidNM;
-BitShifter *reLuNM;
-
-void TileInitialize(InputParameter& inputParameter, Technology& tech, MemCell& cell, double _numPENM, double _peSizeNM, double _numPECM, double _peSizeCM){
-	
-	subArrayInPE = new SubArray(inputParameter, tech, cell);
-	inputBufferNM = new Buffer(inputParameter, tech, cell);
-	outputBufferNM = new Buffer(inputParameter, tech, cell);
-	hTreeNM = new HTree(inputParameter, tech, cell);
-	accumulationNM = new AdderTree(inputParameter, tech, cell);
-	inputBufferCM = new Buffer(inputParameter, tech, cell);
-	outputBufferCM = new Buffer(inputParameter, tech, cell);
-	hTreeCM = new HTree(inputParameter, tech, cell);
-	accumulationCM = new AdderTree(inputParameter, tech, cell);
-	
-	if (!param->chipActivation) {
-		if (param->reLu) {
-			reLuNM = new BitShifter(inputParameter, tech, cell);
-			reLuCM = new BitShifter(inputParameter, tech, cell);
-		} else {
-			sigmoidNM = new Sigmoid(inputParameter, tech, cell);
-			sigmoidCM = new Sigmoid(inputParameter, tech, cell);
-		}
-	}
+void TileInitialize(SimContext &ctx, double _numPENM, double _peSizeNM, double _numPECM, double _peSizeCM){
 	
 	/*** Parameters ***/
 	double numPENM, peSizeNM, numPECM, peSizeCM, numSubArrayNM, numSubArrayCM;
@@ -112,137 +77,137 @@ void TileInitialize(InputParameter& inputParameter, Technology& tech, MemCell& c
 	numSubArrayNM = ceil((double)peSizeNM/(double)param->numRowSubArray)*ceil((double)peSizeNM/(double)param->numColSubArray);
 	numSubArrayCM = ceil((double)peSizeCM/(double)param->numRowSubArray)*ceil((double)peSizeCM/(double)param->numColSubArray);
 
-	ProcessingUnitInitialize(subArrayInPE, inputParameter, tech, cell, ceil(sqrt(numSubArrayNM)), ceil(sqrt(numSubArrayNM)), ceil(sqrt(numSubArrayCM)), ceil(sqrt(numSubArrayCM)));
+	ProcessingUnitInitialize(ctx, ceil(sqrt(numSubArrayNM)), ceil(sqrt(numSubArrayNM)), ceil(sqrt(numSubArrayCM)), ceil(sqrt(numSubArrayCM)));
 
 	if (param->novelMapping) {
 		if (param->parallelRead) {
-			accumulationNM->Initialize(numPENM, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)), 
+			ctx.accumulationNM->Initialize(numPENM, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)), 
 									ceil((double)numPENM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 			if (!param->chipActivation) {
 				if (param->reLu) {
-					reLuNM->Initialize(ceil((double)peSizeNM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
+					ctx.reLuNM->Initialize(ceil((double)peSizeNM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
 				} else {
-					sigmoidNM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray))+ceil((double)log2((double)numPENM)), 
+					ctx.sigmoidNM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray))+ceil((double)log2((double)numPENM)), 
 									ceil((double)numPENM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 				}
-				numOutBufferCore = ceil((param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+				ctx.numOutBufferCore = ceil((param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 				
 				if ((param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-					outputBufferNM->Initialize(param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPENM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+					ctx.outputBufferNM->Initialize(param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPENM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				} else {
-					outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+					ctx.outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				}									
 			} else {
-				numOutBufferCore = ceil(((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+				ctx.numOutBufferCore = ceil(((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 				if (((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-					outputBufferNM->Initialize((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed, 
+					ctx.outputBufferNM->Initialize((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed, 
 									(ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM, 
 									1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				} else {
-					outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+					ctx.outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				}
 			}
 		} else {
-			accumulationNM->Initialize(numPENM, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)), 
+			ctx.accumulationNM->Initialize(numPENM, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)), 
 									ceil(numPENM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 			if (!param->chipActivation) {
 				if (param->reLu) {
-					reLuNM->Initialize(ceil((double)peSizeNM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
+					ctx.reLuNM->Initialize(ceil((double)peSizeNM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
 				} else {
-					sigmoidNM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray))+ceil((double)log2((double)numPENM)), 
+					ctx.sigmoidNM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray))+ceil((double)log2((double)numPENM)), 
 									ceil(numPENM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 				}
-				numOutBufferCore = ceil((param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+				ctx.numOutBufferCore = ceil((param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 				if ((param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-					outputBufferNM->Initialize(param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPENM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+					ctx.outputBufferNM->Initialize(param->numBitInput*numPENM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPENM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				} else {
-					outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+					ctx.outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				}
 			} else {
-				numOutBufferCore = ceil(((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+				ctx.numOutBufferCore = ceil(((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 				if (((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-					outputBufferNM->Initialize((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed, 
+					ctx.outputBufferNM->Initialize((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM*param->numColSubArray/param->numColMuxed, 
 									(ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeNM/(double)param->numRowSubArray)))*numPENM, 
 									1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				} else {
-					outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+					ctx.outputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 				}
 			}
 		}
-		numInBufferCore = ceil((numPENM*param->numBitInput*param->numRowSubArray)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+		ctx.numInBufferCore = ceil((numPENM*param->numBitInput*param->numRowSubArray)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 		
 		if ((numPENM*param->numBitInput*param->numRowSubArray) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-			inputBufferNM->Initialize(numPENM*param->numBitInput*param->numRowSubArray, numPENM*param->numRowSubArray, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+			ctx.inputBufferNM->Initialize(numPENM*param->numBitInput*param->numRowSubArray, numPENM*param->numRowSubArray, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 		} else {
-			inputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+			ctx.inputBufferNM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 		}
-		hTreeNM->Initialize(numPENM, numPENM, param->localBusDelayTolerance, numPENM*param->numRowSubArray, param->clkFreq);
+		ctx.hTreeNM->Initialize(numPENM, numPENM, param->localBusDelayTolerance, numPENM*param->numRowSubArray, param->clkFreq);
 	} 
 	if (param->parallelRead) {
-		accumulationCM->Initialize(numPECM, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)), 
+		ctx.accumulationCM->Initialize(numPECM, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)), 
 								ceil((double)numPECM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 		if (!param->chipActivation) {
 			if (param->reLu) {
-				reLuCM->Initialize(ceil((double)peSizeCM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
+				ctx.reLuCM->Initialize(ceil((double)peSizeCM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
 			} else {
-				sigmoidCM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray))+ceil((double)log2((double)numPECM)), 
+				ctx.sigmoidCM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray))+ceil((double)log2((double)numPECM)), 
 								ceil((double)numPECM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 			}
-			numOutBufferCore = ceil((param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+			ctx.numOutBufferCore = ceil((param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 			
 			if ((param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-				outputBufferCM->Initialize(param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPECM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+				ctx.outputBufferCM->Initialize(param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPECM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			} else {
-				outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+				ctx.outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			}									
 		} else {
-			numOutBufferCore = ceil(((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+			ctx.numOutBufferCore = ceil(((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 			if (((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-				outputBufferCM->Initialize((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed, 
+				ctx.outputBufferCM->Initialize((ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed, 
 								(ceil((double)log2((double)param->levelOutput))+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM, 
 								1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			} else {
-				outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+				ctx.outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			}
 		}
 	} else {
-		accumulationCM->Initialize(numPECM, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)), 
+		ctx.accumulationCM->Initialize(numPECM, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)), 
 								ceil(numPECM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 		if (!param->chipActivation) {
 			if (param->reLu) {
-				reLuCM->Initialize(ceil((double)peSizeCM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
+				ctx.reLuCM->Initialize(ceil((double)peSizeCM*(double)param->numColSubArray/(double)param->numColMuxed), param->numBitInput, param->clkFreq);
 			} else {
-				sigmoidCM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray))+ceil((double)log2((double)numPECM)), 
+				ctx.sigmoidCM->Initialize(false, param->numBitInput, ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray))+ceil((double)log2((double)numPECM)), 
 								ceil(numPECM*(double)param->numColSubArray/(double)param->numColMuxed), param->clkFreq);
 			}
-			numOutBufferCore = ceil((param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+			ctx.numOutBufferCore = ceil((param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 			if ((param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-				outputBufferCM->Initialize(param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPECM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+				ctx.outputBufferCM->Initialize(param->numBitInput*numPECM*param->numColSubArray/param->numColMuxed, param->numBitInput*numPECM, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			} else {
-				outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+				ctx.outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			}
 		} else {
-			numOutBufferCore = ceil(((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+			ctx.numOutBufferCore = ceil(((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 			if (((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-				outputBufferCM->Initialize((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed, 
+				ctx.outputBufferCM->Initialize((ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM*param->numColSubArray/param->numColMuxed, 
 								(ceil((double)log2((double)param->numRowSubArray)+(double)param->cellBit-1)+param->numBitInput+1+ceil((double)log2((double)peSizeCM/(double)param->numRowSubArray)))*numPECM, 
 								1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			} else {
-				outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+				ctx.outputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 			}
 		}
 	}
-	numInBufferCore = ceil((numPECM*param->numBitInput*param->numRowSubArray)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
+	ctx.numInBufferCore = ceil((numPECM*param->numBitInput*param->numRowSubArray)/(param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol));
 	
 	if ((numPECM*param->numBitInput*param->numRowSubArray) < (param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol)) {
-		inputBufferCM->Initialize(numPECM*param->numBitInput*param->numRowSubArray, numPECM*param->numRowSubArray, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+		ctx.inputBufferCM->Initialize(numPECM*param->numBitInput*param->numRowSubArray, numPECM*param->numRowSubArray, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 	} else {
-		inputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
+		ctx.inputBufferCM->Initialize((param->tileBufferCoreSizeRow*param->tileBufferCoreSizeCol), param->tileBufferCoreSizeCol, 1, param->unitLengthWireResistance, param->clkFreq, param->peBufferType);
 	}
-	hTreeCM->Initialize(numPECM, numPECM, param->localBusDelayTolerance, numPECM*param->numRowSubArray, param->clkFreq);
+	ctx.hTreeCM->Initialize(numPECM, numPECM, param->localBusDelayTolerance, numPECM*param->numRowSubArray, param->clkFreq);
 }
 
-vector<double> TileCalculateArea(double numPE, double peSize, bool NMTile, double *height, double *width) {
+vector<double> TileCalculateArea(SimContext &ctx, double numPE, double peSize, bool NMTile, double *height, double *width) {
 	double area = 0;
 	double PEheight, PEwidth, PEbufferArea;
 	*height = 0;
@@ -254,79 +219,79 @@ vector<double> TileCalculateArea(double numPE, double peSize, bool NMTile, doubl
 	
 	if (NMTile) {
 		int numSubArray = ceil((double) peSize/(double) param->numRowSubArray)*ceil((double) peSize/(double) param->numColSubArray);
-		peAreaResults = ProcessingUnitCalculateArea(subArrayInPE, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), true, &PEheight, &PEwidth, &PEbufferArea);
+		peAreaResults = ProcessingUnitCalculateArea(ctx, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), true, &PEheight, &PEwidth, &PEbufferArea);
 		double PEarea = peAreaResults[0];
 		double PEareaADC = peAreaResults[1];
 		double PEareaAccum = peAreaResults[2];
 		double PEareaOther = peAreaResults[3];
 		double PEareaArray = peAreaResults[4];
-		accumulationNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+		ctx.accumulationNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
 		if (!param->chipActivation) {
 			if (param->reLu) {
-				reLuNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
-				area += reLuNM->area;
-				areareLu += reLuNM->area;
+				ctx.reLuNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+				area += ctx.reLuNM->area;
+				areareLu += ctx.reLuNM->area;
 			} else {
-				sigmoidNM->CalculateUnitArea(NONE);
-				sigmoidNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
-				area += sigmoidNM->area;
-				areasigmoid += sigmoidNM->area;
+				ctx.sigmoidNM->CalculateUnitArea(NONE);
+				ctx.sigmoidNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+				area += ctx.sigmoidNM->area;
+				areasigmoid += ctx.sigmoidNM->area;
 			}
 		}
-		inputBufferNM->CalculateArea(ceil(sqrt((double)numPE))*PEheight, NULL, NONE);
-		outputBufferNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
-		inputBufferNM->area *= numInBufferCore;
-		outputBufferNM->area *= numOutBufferCore;												  
-		hTreeNM->CalculateArea(PEheight, PEwidth, 16);
+		ctx.inputBufferNM->CalculateArea(ceil(sqrt((double)numPE))*PEheight, NULL, NONE);
+		ctx.outputBufferNM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+		ctx.inputBufferNM->area *= ctx.numInBufferCore;
+		ctx.outputBufferNM->area *= ctx.numOutBufferCore;												  
+		ctx.hTreeNM->CalculateArea(PEheight, PEwidth, 16);
 
-		area += PEarea*numPE + accumulationNM->area + inputBufferNM->area + outputBufferNM->area + hTreeNM->area;
+		area += PEarea*numPE + ctx.accumulationNM->area + ctx.inputBufferNM->area + ctx.outputBufferNM->area + ctx.hTreeNM->area;
 		
 		*height = sqrt(area);
 		*width = area/(*height);
 		
 		areaResults.push_back(area);
-		areaResults.push_back(hTreeNM->area);
+		areaResults.push_back(ctx.hTreeNM->area);
 		areaResults.push_back(PEareaADC*numPE);
-		areaResults.push_back(PEareaAccum*numPE + accumulationNM->area);
-		areaResults.push_back(PEareaOther*numPE + inputBufferNM->area + outputBufferNM->area + areareLu + areasigmoid);
+		areaResults.push_back(PEareaAccum*numPE + ctx.accumulationNM->area);
+		areaResults.push_back(PEareaOther*numPE + ctx.inputBufferNM->area + ctx.outputBufferNM->area + areareLu + areasigmoid);
 		areaResults.push_back(PEareaArray*numPE);
 	} else {
 		int numSubArray = ceil((double) peSize/(double) param->numRowSubArray)*ceil((double) peSize/(double) param->numColSubArray);
-		peAreaResults = ProcessingUnitCalculateArea(subArrayInPE, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), false, &PEheight, &PEwidth, &PEbufferArea);
+		peAreaResults = ProcessingUnitCalculateArea(ctx, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), false, &PEheight, &PEwidth, &PEbufferArea);
 		double PEarea = peAreaResults[0];
 		double PEareaADC = peAreaResults[1];
 		double PEareaAccum = peAreaResults[2];
 		double PEareaOther = peAreaResults[3];
 		double PEareaArray = peAreaResults[4];
-		accumulationCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+		ctx.accumulationCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
 		if (!param->chipActivation) {
 			if (param->reLu) {
-				reLuCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
-				area += reLuCM->area;
-				areareLu += reLuCM->area;
+				ctx.reLuCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+				area += ctx.reLuCM->area;
+				areareLu += ctx.reLuCM->area;
 			} else {
-				sigmoidCM->CalculateUnitArea(NONE);
-				sigmoidCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
-				area += sigmoidCM->area;
-				areasigmoid += sigmoidCM->area;
+				ctx.sigmoidCM->CalculateUnitArea(NONE);
+				ctx.sigmoidCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+				area += ctx.sigmoidCM->area;
+				areasigmoid += ctx.sigmoidCM->area;
 			}
 		}
-		inputBufferCM->CalculateArea(ceil(sqrt((double)numPE))*PEheight, NULL, NONE);
-		outputBufferCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
-		inputBufferCM->area *= numInBufferCore;
-		outputBufferCM->area *= numOutBufferCore;												  
-		hTreeCM->CalculateArea(PEheight, PEwidth, 16);
+		ctx.inputBufferCM->CalculateArea(ceil(sqrt((double)numPE))*PEheight, NULL, NONE);
+		ctx.outputBufferCM->CalculateArea(NULL, ceil(sqrt((double)numPE))*PEwidth, NONE);
+		ctx.inputBufferCM->area *= ctx.numInBufferCore;
+		ctx.outputBufferCM->area *= ctx.numOutBufferCore;												  
+		ctx.hTreeCM->CalculateArea(PEheight, PEwidth, 16);
 	
-		area += PEarea*numPE + accumulationCM->area + inputBufferCM->area + outputBufferCM->area + hTreeCM->area;
+		area += PEarea*numPE + ctx.accumulationCM->area + ctx.inputBufferCM->area + ctx.outputBufferCM->area + ctx.hTreeCM->area;
 		
 		*height = sqrt(area);
 		*width = area/(*height);
 		
 		areaResults.push_back(area);
-		areaResults.push_back(hTreeCM->area);
+		areaResults.push_back(ctx.hTreeCM->area);
 		areaResults.push_back(PEareaADC*numPE);
-		areaResults.push_back(PEareaAccum*numPE + accumulationCM->area);
-		areaResults.push_back(PEareaOther*numPE + inputBufferCM->area + outputBufferCM->area + areareLu + areasigmoid);
+		areaResults.push_back(PEareaAccum*numPE + ctx.accumulationCM->area);
+		areaResults.push_back(PEareaOther*numPE + ctx.inputBufferCM->area + ctx.outputBufferCM->area + areareLu + areasigmoid);
 		areaResults.push_back(PEareaArray*numPE);
 	}
 	
@@ -334,10 +299,10 @@ vector<double> TileCalculateArea(double numPE, double peSize, bool NMTile, doubl
 }
 
 
-void TileCalculatePerformance(const vector<vector<double> > &newMemory, const vector<vector<double> > &oldMemory, const vector<vector<double> > &inputVector, int novelMap, double numPE, 
-							double peSize, int speedUpRow, int speedUpCol, int weightMatrixRow, int weightMatrixCol, int numInVector, MemCell& cell, double *readLatency, double *readDynamicEnergy, double *leakage,
+void TileCalculatePerformance(SimContext &ctx, const MatrixView &newMemory, const MatrixView &oldMemory, const InputStream &inputStream, const MatrixView &inputRow, int novelMap, double numPE, 
+							double peSize, int speedUpRow, int speedUpCol, int weightMatrixRow, int weightMatrixCol, int numInVector, double *readLatency, double *readDynamicEnergy, double *leakage,
 							double *bufferLatency, double *bufferDynamicEnergy, double *icLatency, double *icDynamicEnergy,
-							double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, bool CalculateclkFreq, double*clkPeriod) {
+							double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, double*clkPeriod) {
 
 	/*** sweep PE ***/
 	int numRowPerSynapse, numColPerSynapse;
@@ -363,20 +328,19 @@ void TileCalculatePerformance(const vector<vector<double> > &newMemory, const ve
 	*coreLatencyOther = 0;
 	
 	if (!novelMap) {   // conventional Mapping
+		ctx.accumulationCM->CalculatePower(0, numPE);		// leakage of the accumulation unit, also counted when the PE outputs do not go through it
 		if (speedUpRow*speedUpCol > 1) {
 			if ((speedUpRow >= numPE) && (speedUpCol >= numPE)) {
 				// duplication in PE or subArray --> tell each PE to take the whole assigned weight  --> "fully" duplication
 				// assign weight and input to specific tile
-				vector<vector<double> > pEMemory;
-				pEMemory = CopyPEArray(newMemory, 0, 0, weightMatrixRow, weightMatrixCol);
-				vector<vector<double> > pEInput;
-				pEInput = CopyPEInput(inputVector, 0, numInVector, weightMatrixRow);
+				MatrixView pEMemory = newMemory.Sub(0, 0, weightMatrixRow, weightMatrixCol);
+				MatrixView pEInput = inputRow.Sub(0, 0, weightMatrixRow, 0);
 				
-				ProcessingUnitCalculatePerformance(subArrayInPE, pEMemory, pEMemory, pEInput, ceil((double)speedUpRow/(double)numPE), ceil((double)speedUpCol/(double)numPE), 
-											numSubArrayRow, numSubArrayCol, weightMatrixRow, weightMatrixCol, numInVector, cell, false,
+				ProcessingUnitCalculatePerformance(ctx, pEMemory, pEMemory, inputStream, pEInput, ceil((double)speedUpRow/(double)numPE), ceil((double)speedUpCol/(double)numPE), 
+											numSubArrayRow, numSubArrayCol, weightMatrixRow, weightMatrixCol, numInVector, false,
 											&PEreadLatency, &PEreadDynamicEnergy, &PEleakage,
 											&PEbufferLatency, &PEbufferDynamicEnergy, &PEicLatency, &PEicDynamicEnergy,
-											&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, CalculateclkFreq, clkPeriod);
+											&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, clkPeriod);
 				
 				*readLatency = PEreadLatency/(numPE*numPE);  // further speed up in PE level
 				*readDynamicEnergy = PEreadDynamicEnergy;   // since subArray.cpp takes all input vectors, no need to *numPE here
@@ -403,16 +367,14 @@ void TileCalculatePerformance(const vector<vector<double> > &newMemory, const ve
 							int numColMatrix = min(peSize, (double) weightMatrixCol-j*peSize);
 					
 							// assign weight and input to specific tile
-							vector<vector<double> > pEMemory;
-							pEMemory = CopyPEArray(newMemory, i*peSize, j*peSize, numRowMatrix, numColMatrix);
-							vector<vector<double> > pEInput;
-							pEInput = CopyPEInput(inputVector, i*peSize, numInVector, numRowMatrix);
+							MatrixView pEMemory = newMemory.Sub(i*peSize, j*peSize, numRowMatrix, numColMatrix);
+							MatrixView pEInput = inputRow.Sub(i*peSize, 0, numRowMatrix, 0);
 							
-							ProcessingUnitCalculatePerformance(subArrayInPE, pEMemory, pEMemory, pEInput, 1, 1, 
-												numSubArrayRow, numSubArrayCol, numRowMatrix, numColMatrix, numInVector, cell, false,
+							ProcessingUnitCalculatePerformance(ctx, pEMemory, pEMemory, inputStream, pEInput, 1, 1, 
+												numSubArrayRow, numSubArrayCol, numRowMatrix, numColMatrix, numInVector, false,
 												&PEreadLatency, &PEreadDynamicEnergy, &PEleakage,
 												&PEbufferLatency, &PEbufferDynamicEnergy, &PEicLatency, &PEicDynamicEnergy,
-												&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, CalculateclkFreq, clkPeriod);
+												&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, clkPeriod);
 					
 							*readLatency = MAX(PEreadLatency, (*readLatency));
 							*readDynamicEnergy += PEreadDynamicEnergy;
@@ -440,12 +402,12 @@ void TileCalculatePerformance(const vector<vector<double> > &newMemory, const ve
 				
 				// whether go through accumulation?
 				if (ceil((double)weightMatrixRow/(double)peSize) > 1) {
-					accumulationCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double)weightMatrixRow/(double)peSize), 0);
-					accumulationCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double)weightMatrixRow/(double)peSize));
-					*readLatency += accumulationCM->readLatency; 
-					*readDynamicEnergy += accumulationCM->readDynamicEnergy;
-					*coreLatencyAccum += accumulationCM->readLatency; 
-					*coreEnergyAccum += accumulationCM->readDynamicEnergy;
+					ctx.accumulationCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double)weightMatrixRow/(double)peSize), 0);
+					ctx.accumulationCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, ceil((double)weightMatrixRow/(double)peSize));
+					*readLatency += ctx.accumulationCM->readLatency; 
+					*readDynamicEnergy += ctx.accumulationCM->readDynamicEnergy;
+					*coreLatencyAccum += ctx.accumulationCM->readLatency; 
+					*coreEnergyAccum += ctx.accumulationCM->readDynamicEnergy;
 				}
 			}
 			
@@ -459,15 +421,13 @@ void TileCalculatePerformance(const vector<vector<double> > &newMemory, const ve
 						int numRowMatrix = min(peSize, (double) weightMatrixRow-i*peSize);
 						int numColMatrix = min(peSize, (double) weightMatrixCol-j*peSize);
 						
-						vector<vector<double> > pEMemory;
-						pEMemory = CopyPEArray(newMemory, i*peSize, j*peSize, numRowMatrix, numColMatrix);
-						vector<vector<double> > pEInput;
-						pEInput = CopyPEInput(inputVector, i*peSize, numInVector, numRowMatrix);
+						MatrixView pEMemory = newMemory.Sub(i*peSize, j*peSize, numRowMatrix, numColMatrix);
+						MatrixView pEInput = inputRow.Sub(i*peSize, 0, numRowMatrix, 0);
 							
-						ProcessingUnitCalculatePerformance(subArrayInPE, pEMemory, pEMemory, pEInput, 1, 1, numSubArrayRow, numSubArrayCol, numRowMatrix,
-												numColMatrix, numInVector, cell, false, &PEreadLatency, &PEreadDynamicEnergy, &PEleakage,
+						ProcessingUnitCalculatePerformance(ctx, pEMemory, pEMemory, inputStream, pEInput, 1, 1, numSubArrayRow, numSubArrayCol, numRowMatrix,
+												numColMatrix, numInVector, false, &PEreadLatency, &PEreadDynamicEnergy, &PEleakage,
 												&PEbufferLatency, &PEbufferDynamicEnergy, &PEicLatency, &PEicDynamicEnergy,
-												&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, CalculateclkFreq, clkPeriod);
+												&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, clkPeriod);
 					}
 					*readLatency = max(PEreadLatency, (*readLatency));
 					*readDynamicEnergy += PEreadDynamicEnergy;
@@ -486,88 +446,84 @@ void TileCalculatePerformance(const vector<vector<double> > &newMemory, const ve
 					*coreEnergyOther += peEnergyOther;
 				}
 			}
-			accumulationCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE, 0);
-			accumulationCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE);
-			*readLatency += accumulationCM->readLatency;
-			*readDynamicEnergy += accumulationCM->readDynamicEnergy;
-			*coreLatencyAccum += accumulationCM->readLatency;
-			*coreEnergyAccum += accumulationCM->readDynamicEnergy;
+			ctx.accumulationCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE, 0);
+			ctx.accumulationCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE);
+			*readLatency += ctx.accumulationCM->readLatency;
+			*readDynamicEnergy += ctx.accumulationCM->readDynamicEnergy;
+			*coreLatencyAccum += ctx.accumulationCM->readLatency;
+			*coreEnergyAccum += ctx.accumulationCM->readDynamicEnergy;
 		}
-		if(!CalculateclkFreq){
-			double numBitToLoadOut, numBitToLoadIn;											  
-			if (!param->chipActivation) {
-				if (param->reLu) {
-					reLuCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/reLuCM->numUnit);
-					reLuCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/reLuCM->numUnit);
-					*readLatency += reLuCM->readLatency;
-					*readDynamicEnergy += reLuCM->readDynamicEnergy;
-					*coreLatencyOther += reLuCM->readLatency;
-					*coreEnergyOther += reLuCM->readDynamicEnergy;
-					numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+reLuCM->numBit)*numInVector/param->numBitInput, 0);
-					outputBufferCM->CalculateLatency(outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width, outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width);
-					outputBufferCM->CalculatePower(outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width, outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width);
-				} else {
-					sigmoidCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/sigmoidCM->numEntry);
-					sigmoidCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/sigmoidCM->numEntry);
-					*readLatency += sigmoidCM->readLatency;
-					*readDynamicEnergy += sigmoidCM->readDynamicEnergy;
-					*coreLatencyOther += sigmoidCM->readLatency;
-					*coreEnergyOther += sigmoidCM->readDynamicEnergy;
-					numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+sigmoidCM->numYbit)*numInVector/param->numBitInput, 0);
-					outputBufferCM->CalculateLatency(outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width, outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width);
-					outputBufferCM->CalculatePower(outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width, outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width);
-				}
+		double numBitToLoadOut, numBitToLoadIn;											  
+		if (!param->chipActivation) {
+			if (param->reLu) {
+				ctx.reLuCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.reLuCM->numUnit);
+				ctx.reLuCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.reLuCM->numUnit);
+				*readLatency += ctx.reLuCM->readLatency;
+				*readDynamicEnergy += ctx.reLuCM->readDynamicEnergy;
+				*coreLatencyOther += ctx.reLuCM->readLatency;
+				*coreEnergyOther += ctx.reLuCM->readDynamicEnergy;
+				numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+ctx.reLuCM->numBit)*numInVector/param->numBitInput, 0);
+				ctx.outputBufferCM->CalculateLatency(ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width, ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width);
+				ctx.outputBufferCM->CalculatePower(ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width, ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width);
 			} else {
-				numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+accumulationCM->numAdderBit)*numInVector/param->numBitInput, 0);
-				outputBufferCM->CalculateLatency(outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width, outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width);
-				outputBufferCM->CalculatePower(outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width, outputBufferCM->interface_width, numBitToLoadIn/outputBufferCM->interface_width);
+				ctx.sigmoidCM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.sigmoidCM->numEntry);
+				ctx.sigmoidCM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.sigmoidCM->numEntry);
+				*readLatency += ctx.sigmoidCM->readLatency;
+				*readDynamicEnergy += ctx.sigmoidCM->readDynamicEnergy;
+				*coreLatencyOther += ctx.sigmoidCM->readLatency;
+				*coreEnergyOther += ctx.sigmoidCM->readDynamicEnergy;
+				numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+ctx.sigmoidCM->numYbit)*numInVector/param->numBitInput, 0);
+				ctx.outputBufferCM->CalculateLatency(ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width, ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width);
+				ctx.outputBufferCM->CalculatePower(ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width, ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width);
 			}
-			
-			//considering buffer activation: no matter speedup or not, the total number of data transferred is fixed
-			numBitToLoadOut = MAX(weightMatrixRow*numInVector, 0);
-			inputBufferCM->CalculateLatency(inputBufferCM->interface_width, numBitToLoadOut/inputBufferCM->interface_width, inputBufferCM->interface_width, numBitToLoadOut/inputBufferCM->interface_width);
-			inputBufferCM->CalculatePower(inputBufferCM->interface_width, numBitToLoadOut/inputBufferCM->interface_width, inputBufferCM->interface_width, numBitToLoadOut/inputBufferCM->interface_width);
-			// since multi-core buffer has improve the parallelism
-			inputBufferCM->readLatency /= MIN(numInBufferCore, ceil(hTreeCM->busWidth/inputBufferCM->interface_width));
-			inputBufferCM->writeLatency /= MIN(numInBufferCore, ceil(hTreeCM->busWidth/inputBufferCM->interface_width));
-			outputBufferCM->readLatency /= MIN(numOutBufferCore, ceil(hTreeCM->busWidth/outputBufferCM->interface_width));
-			outputBufferCM->writeLatency /= MIN(numOutBufferCore, ceil(hTreeCM->busWidth/outputBufferCM->interface_width));																							   
-			
-			*readLatency += (inputBufferCM->readLatency + inputBufferCM->writeLatency);
-			*readDynamicEnergy += inputBufferCM->readDynamicEnergy + inputBufferCM->writeDynamicEnergy;
-			*readLatency += (outputBufferCM->readLatency + outputBufferCM->writeLatency);
-			*readDynamicEnergy += outputBufferCM->readDynamicEnergy + outputBufferCM->writeDynamicEnergy;
-			// used to define travel distance
-			double PEheight, PEwidth, PEbufferArea;
-			int numSubArray = ceil((double) peSize/(double) param->numRowSubArray)*ceil((double) peSize/(double) param->numColSubArray);
-			vector<double> PEarea;
-			PEarea = ProcessingUnitCalculateArea(subArrayInPE, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), false, &PEheight, &PEwidth, &PEbufferArea);
-			hTreeCM->CalculateLatency(NULL, NULL, NULL, NULL, PEheight, PEwidth, (numBitToLoadOut+numBitToLoadIn)/hTreeCM->busWidth);
-			hTreeCM->CalculatePower(NULL, NULL, NULL, NULL, PEheight, PEwidth, hTreeCM->busWidth, (numBitToLoadOut+numBitToLoadIn)/hTreeCM->busWidth);	 
-			*readLatency += hTreeCM->readLatency;
-			*readDynamicEnergy += hTreeCM->readDynamicEnergy;
-			
-			*bufferLatency += (inputBufferCM->readLatency + outputBufferCM->readLatency + inputBufferCM->writeLatency + outputBufferCM->writeLatency);
-			*icLatency += hTreeCM->readLatency;
-			*bufferDynamicEnergy += inputBufferCM->readDynamicEnergy + outputBufferCM->readDynamicEnergy + inputBufferCM->writeDynamicEnergy + outputBufferCM->writeDynamicEnergy;
-			*icDynamicEnergy += hTreeCM->readDynamicEnergy;
-			
-			*coreLatencyOther += (inputBufferCM->readLatency + inputBufferCM->writeLatency + outputBufferCM->readLatency + outputBufferCM->writeLatency + hTreeCM->readLatency);
-			*coreEnergyOther += inputBufferCM->readDynamicEnergy + inputBufferCM->writeDynamicEnergy + outputBufferCM->readDynamicEnergy + outputBufferCM->writeDynamicEnergy + hTreeCM->readDynamicEnergy;
-			*leakage = PEleakage*numPE*numPE + accumulationCM->leakage + inputBufferCM->leakage + outputBufferCM->leakage;
+		} else {
+			numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+ctx.accumulationCM->numAdderBit)*numInVector/param->numBitInput, 0);
+			ctx.outputBufferCM->CalculateLatency(ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width, ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width);
+			ctx.outputBufferCM->CalculatePower(ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width, ctx.outputBufferCM->interface_width, numBitToLoadIn/ctx.outputBufferCM->interface_width);
 		}
+		
+		//considering buffer activation: no matter speedup or not, the total number of data transferred is fixed
+		numBitToLoadOut = MAX(weightMatrixRow*numInVector, 0);
+		ctx.inputBufferCM->CalculateLatency(ctx.inputBufferCM->interface_width, numBitToLoadOut/ctx.inputBufferCM->interface_width, ctx.inputBufferCM->interface_width, numBitToLoadOut/ctx.inputBufferCM->interface_width);
+		ctx.inputBufferCM->CalculatePower(ctx.inputBufferCM->interface_width, numBitToLoadOut/ctx.inputBufferCM->interface_width, ctx.inputBufferCM->interface_width, numBitToLoadOut/ctx.inputBufferCM->interface_width);
+		// since multi-core buffer has improve the parallelism
+		ctx.inputBufferCM->readLatency /= MIN(ctx.numInBufferCore, ceil(ctx.hTreeCM->busWidth/ctx.inputBufferCM->interface_width));
+		ctx.inputBufferCM->writeLatency /= MIN(ctx.numInBufferCore, ceil(ctx.hTreeCM->busWidth/ctx.inputBufferCM->interface_width));
+		ctx.outputBufferCM->readLatency /= MIN(ctx.numOutBufferCore, ceil(ctx.hTreeCM->busWidth/ctx.outputBufferCM->interface_width));
+		ctx.outputBufferCM->writeLatency /= MIN(ctx.numOutBufferCore, ceil(ctx.hTreeCM->busWidth/ctx.outputBufferCM->interface_width));																							   
+		
+		*readLatency += (ctx.inputBufferCM->readLatency + ctx.inputBufferCM->writeLatency);
+		*readDynamicEnergy += ctx.inputBufferCM->readDynamicEnergy + ctx.inputBufferCM->writeDynamicEnergy;
+		*readLatency += (ctx.outputBufferCM->readLatency + ctx.outputBufferCM->writeLatency);
+		*readDynamicEnergy += ctx.outputBufferCM->readDynamicEnergy + ctx.outputBufferCM->writeDynamicEnergy;
+		// used to define travel distance
+		double PEheight, PEwidth, PEbufferArea;
+		int numSubArray = ceil((double) peSize/(double) param->numRowSubArray)*ceil((double) peSize/(double) param->numColSubArray);
+		vector<double> PEarea;
+		PEarea = ProcessingUnitCalculateArea(ctx, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), false, &PEheight, &PEwidth, &PEbufferArea);
+		ctx.hTreeCM->CalculateLatency(NULL, NULL, NULL, NULL, PEheight, PEwidth, (numBitToLoadOut+numBitToLoadIn)/ctx.hTreeCM->busWidth);
+		ctx.hTreeCM->CalculatePower(NULL, NULL, NULL, NULL, PEheight, PEwidth, ctx.hTreeCM->busWidth, (numBitToLoadOut+numBitToLoadIn)/ctx.hTreeCM->busWidth);	 
+		*readLatency += ctx.hTreeCM->readLatency;
+		*readDynamicEnergy += ctx.hTreeCM->readDynamicEnergy;
+		
+		*bufferLatency += (ctx.inputBufferCM->readLatency + ctx.outputBufferCM->readLatency + ctx.inputBufferCM->writeLatency + ctx.outputBufferCM->writeLatency);
+		*icLatency += ctx.hTreeCM->readLatency;
+		*bufferDynamicEnergy += ctx.inputBufferCM->readDynamicEnergy + ctx.outputBufferCM->readDynamicEnergy + ctx.inputBufferCM->writeDynamicEnergy + ctx.outputBufferCM->writeDynamicEnergy;
+		*icDynamicEnergy += ctx.hTreeCM->readDynamicEnergy;
+		
+		*coreLatencyOther += (ctx.inputBufferCM->readLatency + ctx.inputBufferCM->writeLatency + ctx.outputBufferCM->readLatency + ctx.outputBufferCM->writeLatency + ctx.hTreeCM->readLatency);
+		*coreEnergyOther += ctx.inputBufferCM->readDynamicEnergy + ctx.inputBufferCM->writeDynamicEnergy + ctx.outputBufferCM->readDynamicEnergy + ctx.outputBufferCM->writeDynamicEnergy + ctx.hTreeCM->readDynamicEnergy;
+		*leakage = PEleakage*numPE*numPE + ctx.accumulationCM->leakage + ctx.inputBufferCM->leakage + ctx.outputBufferCM->leakage;
 	} else {  // novel Mapping
 		for (int i=0; i<numPE; i++) {
 			int location = i*MIN(peSize, (int) weightMatrixRow/numPE);
-			vector<vector<double> > pEMemory;
-			pEMemory = CopyPEArray(newMemory, location, 0, weightMatrixRow/numPE, weightMatrixCol);
-			vector<vector<double> > pEInput;
-			pEInput = CopyPEInput(inputVector, location, numInVector, weightMatrixRow/numPE);
+			MatrixView pEMemory = newMemory.Sub(location, 0, weightMatrixRow/numPE, weightMatrixCol);
+			MatrixView pEInput = inputRow.Sub(location, 0, weightMatrixRow/numPE, 0);
 					
-			ProcessingUnitCalculatePerformance(subArrayInPE, pEMemory, pEMemory, pEInput, 1, 1, numSubArrayRow, numSubArrayCol, weightMatrixRow/numPE,
-									weightMatrixCol, numInVector, cell, true, &PEreadLatency, &PEreadDynamicEnergy, &PEleakage,
+			ProcessingUnitCalculatePerformance(ctx, pEMemory, pEMemory, inputStream, pEInput, 1, 1, numSubArrayRow, numSubArrayCol, weightMatrixRow/numPE,
+									weightMatrixCol, numInVector, true, &PEreadLatency, &PEreadDynamicEnergy, &PEleakage,
 									&PEbufferLatency, &PEbufferDynamicEnergy, &PEicLatency, &PEicDynamicEnergy, 
-									&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, CalculateclkFreq, clkPeriod);
+									&peLatencyADC, &peLatencyAccum, &peLatencyOther, &peEnergyADC, &peEnergyAccum, &peEnergyOther, clkPeriod);
 			*readLatency = max(PEreadLatency, (*readLatency));
 			*readDynamicEnergy += PEreadDynamicEnergy;
 			*bufferLatency = max(PEbufferLatency, (*bufferLatency));
@@ -583,118 +539,86 @@ void TileCalculatePerformance(const vector<vector<double> > &newMemory, const ve
 			*coreEnergyAccum += peEnergyAccum;
 			*coreEnergyOther += peEnergyOther;
 		}
-		if(!CalculateclkFreq){
-			*readLatency /= (speedUpRow*speedUpCol);
-			*coreLatencyADC /= (speedUpRow*speedUpCol);
-			*coreLatencyAccum /= (speedUpRow*speedUpCol);
-			*coreLatencyOther /= (speedUpRow*speedUpCol);
-			*bufferLatency /= (speedUpRow*speedUpCol);
-			*icLatency /= (speedUpRow*speedUpCol);
-			
-			accumulationNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE, 0);
-			accumulationNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE);
-			*readLatency += accumulationNM->readLatency;
-			*readDynamicEnergy += accumulationNM->readDynamicEnergy;
-			
-			*coreLatencyAccum += accumulationNM->readLatency;
-			*coreEnergyAccum += accumulationNM->readDynamicEnergy;
-			
-			//considering buffer activation: no matter speedup or not, the total number of data transferred is fixed
-			double numBitToLoadOut, numBitToLoadIn;
-			numBitToLoadOut= MAX(weightMatrixRow*numInVector/sqrt(numPE), 0);
-			inputBufferNM->CalculateLatency(inputBufferNM->interface_width, numBitToLoadOut/inputBufferNM->interface_width, inputBufferNM->interface_width, numBitToLoadOut/inputBufferNM->interface_width);
-			inputBufferNM->CalculatePower(inputBufferNM->interface_width, numBitToLoadOut/inputBufferNM->interface_width, inputBufferNM->interface_width, numBitToLoadOut/inputBufferNM->interface_width);
+		*readLatency /= (speedUpRow*speedUpCol);
+		*coreLatencyADC /= (speedUpRow*speedUpCol);
+		*coreLatencyAccum /= (speedUpRow*speedUpCol);
+		*coreLatencyOther /= (speedUpRow*speedUpCol);
+		*bufferLatency /= (speedUpRow*speedUpCol);
+		*icLatency /= (speedUpRow*speedUpCol);
 		
-			if (!param->chipActivation) {
-				if (param->reLu) {
-					reLuNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/reLuNM->numUnit);
-					reLuNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/reLuNM->numUnit);
-					*readLatency += reLuNM->readLatency;
-					*readDynamicEnergy += reLuNM->readDynamicEnergy;
-					*coreLatencyOther += reLuNM->readLatency;
-					*coreEnergyOther += reLuNM->readDynamicEnergy;
-					
-					numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+reLuNM->numBit)*numInVector/param->numBitInput/numPE, 0);
-					outputBufferNM->CalculateLatency(outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width, outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width);
-					outputBufferNM->CalculatePower(outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width, outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width);
-				} else {
-					sigmoidNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/sigmoidNM->numEntry);
-					sigmoidNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/sigmoidNM->numEntry);
-					*readLatency += sigmoidNM->readLatency;
-					*readDynamicEnergy += sigmoidNM->readDynamicEnergy;
-					*coreLatencyOther += sigmoidNM->readLatency;
-					*coreEnergyOther += sigmoidNM->readDynamicEnergy;
-					
-					numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+sigmoidNM->numYbit)*numInVector/param->numBitInput/numPE, 0);
-					outputBufferNM->CalculateLatency(outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width, outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width);
-					outputBufferNM->CalculatePower(outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width, outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width);
-				}
+		ctx.accumulationNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE, 0);
+		ctx.accumulationNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed, numPE);
+		*readLatency += ctx.accumulationNM->readLatency;
+		*readDynamicEnergy += ctx.accumulationNM->readDynamicEnergy;
+		
+		*coreLatencyAccum += ctx.accumulationNM->readLatency;
+		*coreEnergyAccum += ctx.accumulationNM->readDynamicEnergy;
+		
+		//considering buffer activation: no matter speedup or not, the total number of data transferred is fixed
+		double numBitToLoadOut, numBitToLoadIn;
+		numBitToLoadOut= MAX(weightMatrixRow*numInVector/sqrt(numPE), 0);
+		ctx.inputBufferNM->CalculateLatency(ctx.inputBufferNM->interface_width, numBitToLoadOut/ctx.inputBufferNM->interface_width, ctx.inputBufferNM->interface_width, numBitToLoadOut/ctx.inputBufferNM->interface_width);
+		ctx.inputBufferNM->CalculatePower(ctx.inputBufferNM->interface_width, numBitToLoadOut/ctx.inputBufferNM->interface_width, ctx.inputBufferNM->interface_width, numBitToLoadOut/ctx.inputBufferNM->interface_width);
+		
+		if (!param->chipActivation) {
+			if (param->reLu) {
+				ctx.reLuNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.reLuNM->numUnit);
+				ctx.reLuNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.reLuNM->numUnit);
+				*readLatency += ctx.reLuNM->readLatency;
+				*readDynamicEnergy += ctx.reLuNM->readDynamicEnergy;
+				*coreLatencyOther += ctx.reLuNM->readLatency;
+				*coreEnergyOther += ctx.reLuNM->readDynamicEnergy;
+				
+				numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+ctx.reLuNM->numBit)*numInVector/param->numBitInput/numPE, 0);
+				ctx.outputBufferNM->CalculateLatency(ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width, ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width);
+				ctx.outputBufferNM->CalculatePower(ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width, ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width);
 			} else {
-				numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+accumulationNM->numAdderBit)*numInVector/param->numBitInput/numPE, 0);
-				outputBufferNM->CalculateLatency(outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width, outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width);
-				outputBufferNM->CalculatePower(outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width, outputBufferNM->interface_width, numBitToLoadIn/outputBufferNM->interface_width);
-			}
-			// since multi-core buffer has improve the parallelism
-			inputBufferNM->readLatency /= MIN(numInBufferCore, ceil(hTreeNM->busWidth/inputBufferNM->interface_width));
-			inputBufferNM->writeLatency /= MIN(numInBufferCore, ceil(hTreeNM->busWidth/inputBufferNM->interface_width));
-			outputBufferNM->readLatency /= MIN(numOutBufferCore, ceil(hTreeNM->busWidth/inputBufferNM->interface_width));
-			outputBufferNM->writeLatency /= MIN(numOutBufferCore, ceil(hTreeNM->busWidth/inputBufferNM->interface_width));
-			
-			*readLatency += inputBufferNM->readLatency + inputBufferNM->writeLatency;
-			*readDynamicEnergy += inputBufferNM->readDynamicEnergy + inputBufferNM->writeDynamicEnergy;
-			*readLatency += (outputBufferNM->readLatency + outputBufferNM->writeLatency);
-			*readDynamicEnergy += outputBufferNM->readDynamicEnergy + outputBufferNM->writeDynamicEnergy;
-			
-			// used to define travel distance
-			double PEheight, PEwidth, PEbufferArea;
-			int numSubArray = ceil((double) peSize/(double) param->numRowSubArray)*ceil((double) peSize/(double) param->numColSubArray);
-			vector<double> PEarea;
-			PEarea = ProcessingUnitCalculateArea(subArrayInPE, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), true, &PEheight, &PEwidth, &PEbufferArea);
-			hTreeNM->CalculateLatency(0, 0, 1, 1, PEheight, PEwidth, (numBitToLoadOut+numBitToLoadIn)/hTreeNM->busWidth);
-			hTreeNM->CalculatePower(0, 0, 1, 1, PEheight, PEwidth, hTreeNM->busWidth, (numBitToLoadOut+numBitToLoadIn)/hTreeNM->busWidth);
-			
-			*readLatency += hTreeNM->readLatency;
-			*readDynamicEnergy += hTreeNM->readDynamicEnergy;
+				ctx.sigmoidNM->CalculateLatency((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.sigmoidNM->numEntry);
+				ctx.sigmoidNM->CalculatePower((int)(numInVector/param->numBitInput)*param->numColMuxed/ctx.sigmoidNM->numEntry);
+				*readLatency += ctx.sigmoidNM->readLatency;
+				*readDynamicEnergy += ctx.sigmoidNM->readDynamicEnergy;
+				*coreLatencyOther += ctx.sigmoidNM->readLatency;
+				*coreEnergyOther += ctx.sigmoidNM->readDynamicEnergy;
 				
-			*bufferLatency += (inputBufferNM->readLatency + outputBufferNM->readLatency + inputBufferNM->writeLatency + outputBufferNM->writeLatency);
-			*icLatency += hTreeNM->readLatency;
-			*bufferDynamicEnergy += inputBufferNM->readDynamicEnergy + outputBufferNM->readDynamicEnergy + inputBufferNM->writeDynamicEnergy + outputBufferNM->writeDynamicEnergy;
-			*icDynamicEnergy += hTreeNM->readDynamicEnergy;
-			
-			*coreLatencyOther += (inputBufferNM->readLatency + inputBufferNM->writeLatency + outputBufferNM->readLatency + outputBufferNM->writeLatency + hTreeNM->readLatency);
-			*coreEnergyOther += inputBufferNM->readDynamicEnergy + inputBufferNM->writeDynamicEnergy + outputBufferNM->readDynamicEnergy + outputBufferNM->writeDynamicEnergy + hTreeNM->readDynamicEnergy;
-			*leakage = PEleakage*numPE + accumulationNM->leakage + inputBufferNM->leakage + outputBufferNM->leakage;
-		}
-	}
-}
-
-
-vector<vector<double> > CopyPEArray(const vector<vector<double> > &orginal, int positionRow, int positionCol, int numRow, int numCol) {
-	vector<vector<double> > copy;
-	for (int i=0; i<numRow; i++) {
-		vector<double> copyRow;
-		for (int j=0; j<numCol; j++) {
-			copyRow.push_back(orginal[positionRow+i][positionCol+j]);
-		}
-		copy.push_back(copyRow);
-		copyRow.clear();
-	}
-	return copy;
-	copy.clear();
-} 
-
-
-vector<vector<double> > CopyPEInput(const vector<vector<double> > &orginal, int positionRow, int numInputVector, int numRow) {
-	vector<vector<double> > copy;
-	for (int i=0; i<numRow; i++) {
-		vector<double> copyRow;
-		for (int j=0; j<numInputVector; j++) {
-			copyRow.push_back(orginal[positionRow+i][j]);
+				numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+ctx.sigmoidNM->numYbit)*numInVector/param->numBitInput/numPE, 0);
+				ctx.outputBufferNM->CalculateLatency(ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width, ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width);
+				ctx.outputBufferNM->CalculatePower(ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width, ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width);
+			}
+		} else {
+			numBitToLoadIn = MAX(ceil(weightMatrixCol/param->numColPerSynapse)*(1+ctx.accumulationNM->numAdderBit)*numInVector/param->numBitInput/numPE, 0);
+			ctx.outputBufferNM->CalculateLatency(ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width, ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width);
+			ctx.outputBufferNM->CalculatePower(ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width, ctx.outputBufferNM->interface_width, numBitToLoadIn/ctx.outputBufferNM->interface_width);
 		}
-		copy.push_back(copyRow);
-		copyRow.clear();
+		// since multi-core buffer has improve the parallelism
+		ctx.inputBufferNM->readLatency /= MIN(ctx.numInBufferCore, ceil(ctx.hTreeNM->busWidth/ctx.inputBufferNM->interface_width));
+		ctx.inputBufferNM->writeLatency /= MIN(ctx.numInBufferCore, ceil(ctx.hTreeNM->busWidth/ctx.inputBufferNM->interface_width));
+		ctx.outputBufferNM->readLatency /= MIN(ctx.numOutBufferCore, ceil(ctx.hTreeNM->busWidth/ctx.inputBufferNM->interface_width));
+		ctx.outputBufferNM->writeLatency /= MIN(ctx.numOutBufferCore, ceil(ctx.hTreeNM->busWidth/ctx.inputBufferNM->interface_width));
+		
+		*readLatency += ctx.inputBufferNM->readLatency + ctx.inputBufferNM->writeLatency;
+		*readDynamicEnergy += ctx.inputBufferNM->readDynamicEnergy + ctx.inputBufferNM->writeDynamicEnergy;
+		*readLatency += (ctx.outputBufferNM->readLatency + ctx.outputBufferNM->writeLatency);
+		*readDynamicEnergy += ctx.outputBufferNM->readDynamicEnergy + ctx.outputBufferNM->writeDynamicEnergy;
+		
+		// used to define travel distance
+		double PEheight, PEwidth, PEbufferArea;
+		int numSubArray = ceil((double) peSize/(double) param->numRowSubArray)*ceil((double) peSize/(double) param->numColSubArray);
+		vector<double> PEarea;
+		PEarea = ProcessingUnitCalculateArea(ctx, ceil((double)sqrt((double)numSubArray)), ceil((double)sqrt((double)numSubArray)), true, &PEheight, &PEwidth, &PEbufferArea);
+		ctx.hTreeNM->CalculateLatency(0, 0, 1, 1, PEheight, PEwidth, (numBitToLoadOut+numBitToLoadIn)/ctx.hTreeNM->busWidth);
+		ctx.hTreeNM->CalculatePower(0, 0, 1, 1, PEheight, PEwidth, ctx.hTreeNM->busWidth, (numBitToLoadOut+numBitToLoadIn)/ctx.hTreeNM->busWidth);
+		
+		*readLatency += ctx.hTreeNM->readLatency;
+		*readDynamicEnergy += ctx.hTreeNM->readDynamicEnergy;
+			
+		*bufferLatency += (ctx.inputBufferNM->readLatency + ctx.outputBufferNM->readLatency + ctx.inputBufferNM->writeLatency + ctx.outputBufferNM->writeLatency);
+		*icLatency += ctx.hTreeNM->readLatency;
+		*bufferDynamicEnergy += ctx.inputBufferNM->readDynamicEnergy + ctx.outputBufferNM->readDynamicEnergy + ctx.inputBufferNM->writeDynamicEnergy + ctx.outputBufferNM->writeDynamicEnergy;
+		*icDynamicEnergy += ctx.hTreeNM->readDynamicEnergy;
+		
+		*coreLatencyOther += (ctx.inputBufferNM->readLatency + ctx.inputBufferNM->writeLatency + ctx.outputBufferNM->readLatency + ctx.outputBufferNM->writeLatency + ctx.hTreeNM->readLatency);
+		*coreEnergyOther += ctx.inputBufferNM->readDynamicEnergy + ctx.inputBufferNM->writeDynamicEnergy + ctx.outputBufferNM->readDynamicEnergy + ctx.outputBufferNM->writeDynamicEnergy + ctx.hTreeNM->readDynamicEnergy;
+		*leakage = PEleakage*numPE + ctx.accumulationNM->leakage + ctx.inputBufferNM->leakage + ctx.outputBufferNM->leakage;
 	}
-	return copy;
-	copy.clear();
 }
 
@@ -48,20 +48,20 @@
 #include "InputParameter.h"
 #include "Technology.h"
 #include "MemCell.h"
+#include "InputStream.h"
+#include "SimContext.h"
  
 using namespace std;
 
 /*** Functions ***/
-void TileInitialize(InputParameter& inputParameter, Technology& tech, MemCell& cell, double _numPENM, double _peSizeNM, double _numPECM, double _peSizeCM);
-vector<double> TileCalculateArea(double numPE, double peSize, bool NMTile, double *height, double *width);
-void TileCalculatePerformance(const vector<vector<double> > &newMemory, const vector<vector<double> > &oldMemory, const vector<vector<double> > &inputVector, 
+void TileInitialize(SimContext &ctx, double _numPENM, double _peSizeNM, double _numPECM, double _peSizeCM);
+vector<double> TileCalculateArea(SimContext &ctx, double numPE, double peSize, bool NMTile, double *height, double *width);
+void TileCalculatePerformance(SimContext &ctx, const MatrixView &newMemory, const MatrixView &oldMemory, const InputStream &inputStream, const MatrixView &inputRow, 
 			int novelMap, double numPE, double peSize, 
-			int speedUpRow, int speedUpCol, int weightMatrixRow, int weightMatrixCol, int numInVector, MemCell& cell, double *readLatency, double *readDynamicEnergy, double *leakage,
+			int speedUpRow, int speedUpCol, int weightMatrixRow, int weightMatrixCol, int numInVector, double *readLatency, double *readDynamicEnergy, double *leakage,
 			double *bufferLatency, double *bufferDynamicEnergy, double *icLatency, double *icDynamicEnergy,
-			double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, bool CalculateclkFreq, double*clkPeriod);
+			double *coreLatencyADC, double *coreLatencyAccum, double *coreLatencyOther, double *coreEnergyADC, double *coreEnergyAccum, double *coreEnergyOther, double*clkPeriod);
 		
-vector<vector<double> > CopyPEArray(const vector<vector<double> > &orginal, int positionRow, int positionCol, int numRow, int numCol);
-vector<vector<double> > CopyPEInput(const vector<vector<double> > &orginal, int positionRow, int numInputVector, int numRow);
 	
 
 #endif /* TILE_H_ */
\ No newline at end of file
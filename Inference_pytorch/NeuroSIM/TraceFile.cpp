@@ -0,0 +1,201 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "TraceFile.h"
+
+using namespace std;
+
+TraceFile::TraceFile() {
+	mapped = NULL;
+	mappedSize = 0;
+	payload = NULL;
+	rows = cols = bits = kind = wordsPerRow = 0;
+	memset(&header, 0, sizeof(header));
+}
+
+TraceFile::~TraceFile() {
+	Close();
+}
+
+/* Fill in the fields a version 1 header does not have */
+static void UpgradeHeader(TraceHeader *header) {
+	if (header->version == 1) {
+		header->layer = TRACE_LAYER_ANY;
+		header->checksum = 0;
+		header->reserved[0] = header->reserved[1] = 0;
+	}
+}
+
+bool TraceFile::ReadHeader(const string &filename, TraceHeader *header) {
+	ifstream file(filename.c_str(), ios::binary);
+	memset(header, 0, sizeof(TraceHeader));
+	file.read((char *)header, sizeof(TraceHeader));
+	if (file.gcount() < TRACE_V1_HEADER || header->magic != TRACE_MAGIC) {
+		return false;
+	}
+	if (header->version != 1 && file.gcount() < (streamsize) sizeof(TraceHeader)) {
+		return false;
+	}
+	UpgradeHeader(header);
+	return true;
+}
+
+int TraceFile::TraceKind(const string &filename) {
+	TraceHeader header;
+	if (!ReadHeader(filename, &header)) {
+		return -1;
+	}
+	return header.kind;
+}
+
+/* CRC-32 slice-by-8 lookup tables (reflected polynomial 0xedb88320, as zlib), filled before main() */
+/* crcTable[k][i] is the CRC of byte i followed by k zero bytes */
+static uint32_t crcTable[8][256];
+static bool InitCrcTable() {
+	for (uint32_t i=0; i<256; i++) {
+		uint32_t c = i;
+		for (int k=0; k<8; k++) {
+			c = (c & 1)? 0xedb88320 ^ (c >> 1) : c >> 1;
+		}
+		crcTable[0][i] = c;
+	}
+	for (uint32_t i=0; i<256; i++) {
+		for (int k=1; k<8; k++) {
+			crcTable[k][i] = (crcTable[k-1][i] >> 8) ^ crcTable[0][crcTable[k-1][i] & 0xff];
+		}
+	}
+	return true;
+}
+static bool crcTableReady = InitCrcTable();
+
+uint32_t TraceFile::Checksum(const void *data, size_t size, uint32_t crc) {
+	const unsigned char *p = (const unsigned char *)data;
+	crc = ~crc;
+	// 8 bytes per step, the words are little-endian like the rest of the trace
+	for (; size >= 8; p += 8, size -= 8) {
+		uint32_t lo, hi;
+		memcpy(&lo, p, 4);
+		memcpy(&hi, p+4, 4);
+		lo ^= crc;
+		crc = crcTable[7][lo & 0xff] ^ crcTable[6][(lo >> 8) & 0xff] ^ crcTable[5][(lo >> 16) & 0xff] ^ crcTable[4][lo >> 24]
+			^ crcTable[3][hi & 0xff] ^ crcTable[2][(hi >> 8) & 0xff] ^ crcTable[1][(hi >> 16) & 0xff] ^ crcTable[0][hi >> 24];
+	}
+	for (; size > 0; p++, size--) {
+		crc = crcTable[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+bool TraceFile::Open(const string &filename, bool verify) {
+	Close();
+	int fd = open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		cerr << "Error: the trace file " << filename << " cannot be opened!" << endl;
+		exit(1);
+	}
+	struct stat st;
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t) TRACE_V1_HEADER) {
+		close(fd);
+		return false;
+	}
+	mappedSize = st.st_size;
+	mapped = mmap(NULL, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (mapped == MAP_FAILED) {
+		mapped = NULL;
+		cerr << "Error: the trace file " << filename << " cannot be mapped!" << endl;
+		exit(1);
+	}
+	memset(&header, 0, sizeof(header));
+	memcpy(&header, mapped, min(mappedSize, sizeof(header)));
+	if (header.magic != TRACE_MAGIC) {
+		Close();
+		return false;
+	}
+	if (header.version != 1 && header.version != TRACE_VERSION) {
+		cerr << "Error: trace file " << filename << " has unsupported version " << header.version << " (expected " << TRACE_VERSION << "), regenerate it!" << endl;
+		exit(1);
+	}
+	size_t headerSize = (header.version == 1)? TRACE_V1_HEADER : sizeof(TraceHeader);
+	UpgradeHeader(&header);
+	
+	rows = header.rows;
+	cols = header.cols;
+	bits = header.bits;
+	kind = header.kind;
+	wordsPerRow = (cols+63)/64;
+	
+	size_t payloadSize;
+	if (kind == TRACE_KIND_INPUT || kind == TRACE_KIND_IFM) {
+		payloadSize = (size_t)rows*wordsPerRow*sizeof(uint64_t);
+	} else if (kind == TRACE_KIND_WEIGHT) {
+		payloadSize = (size_t)rows*cols*sizeof(int32_t);
+	} else {
+		cerr << "Error: trace file " << filename << " has unknown kind " << kind << "!" << endl;
+		exit(1);
+	}
+	if (mappedSize != headerSize + payloadSize) {
+		cerr << "Error: trace file " << filename << " is truncated or corrupted (" << rows << "x" << cols << ")!" << endl;
+		exit(1);
+	}
+	payload = (const char *)mapped + headerSize;
+	if (verify && header.version != 1 && Checksum(payload, payloadSize) != header.checksum) {
+		cerr << "Error: trace file " << filename << " fails its checksum, the file is corrupted!" << endl;
+		exit(1);
+	}
+	return true;
+}
+
+void TraceFile::Close() {
+	if (mapped) {
+		munmap(mapped, mappedSize);
+	}
+	mapped = NULL;
+	mappedSize = 0;
+	payload = NULL;
+}
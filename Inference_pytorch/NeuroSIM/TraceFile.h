@@ -0,0 +1,103 @@
+/*******************************************************************************
+* Copyright (c) 2015-2017
+* School of Electrical, Computer and Energy Engineering, Arizona State University
+* PI: Prof. Shimeng Yu
+* All rights reserved.
+* 
+* This source code is part of NeuroSim - a device-circuit-algorithm framework to benchmark 
+* neuro-inspired architectures with synaptic devices(e.g., SRAM and emerging non-volatile memory). 
+* Copyright of the model is maintained by the developers, and the model is distributed under 
+* the terms of the Creative Commons Attribution-NonCommercial 4.0 International Public License 
+* http://creativecommons.org/licenses/by-nc/4.0/legalcode.
+* The source code is free and you can redistribute and/or modify it
+* by providing that the following conditions are met:
+* 
+*  1) Redistributions of source code must retain the above copyright notice,
+*     this list of conditions and the following disclaimer.
+* 
+*  2) Redistributions in binary form must reproduce the above copyright notice,
+*     this list of conditions and the following disclaimer in the documentation
+*     and/or other materials provided with the distribution.
+* 
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+* 
+* Developer list: 
+*   Pai-Yu Chen	    Email: pchen72 at asu dot edu 
+*                    
+*   Xiaochen Peng   Email: xpeng15 at asu dot edu
+********************************************************************************/
+
+#ifndef TRACEFILE_H_
+#define TRACEFILE_H_
+
+#include <stdint.h>
+#include <string>
+
+using namespace std;
+
+/*** Binary trace format (little-endian) ***/
+// header (48 bytes): magic "NSTR", version, kind, rows, cols, bits, height, width, layer, checksum, 2 reserved
+// The checksum is the CRC-32 (zlib.crc32) of the payload, verified when the trace is opened (param->traceChecksum).
+// Version 1 traces have a 32-byte header that ends after width; they are read as layer-agnostic and unchecked.
+// input payload : rows x ceil(cols/64) uint64 words, bit j of word w is column w*64+j
+// IFM payload   : same packing, one row per channel, column (y*width+x)*bits+b is bit b of pixel (y, x)
+// weight payload: rows x cols int32 integer codes, i.e. the weight already normalized to [0, 2^bits]
+#define TRACE_MAGIC        0x5254534e		// "NSTR"
+#define TRACE_VERSION      2
+#define TRACE_V1_HEADER    32		// header size of version 1 traces
+#define TRACE_KIND_WEIGHT  0
+#define TRACE_KIND_INPUT   1
+#define TRACE_KIND_IFM     2		// raw feature map, conv input vectors are generated from it on the fly
+#define TRACE_LAYER_ANY    0xffffffff		// trace not tied to a layer (e.g. transcoded from CSV)
+
+struct TraceHeader {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t kind;
+	uint32_t rows;
+	uint32_t cols;
+	uint32_t bits;			// synapseBit for weight traces, numBitInput for input traces
+	uint32_t height;		// IFM traces only, 0 otherwise
+	uint32_t width;
+	uint32_t layer;			// index of the layer in netStructure, or TRACE_LAYER_ANY
+	uint32_t checksum;
+	uint32_t reserved[2];
+};
+
+class TraceFile {
+public:
+	TraceFile();
+	virtual ~TraceFile();
+
+	bool Open(const string &filename, bool verify=true);		// false if the file is not a binary trace (e.g. CSV)
+	void Close();
+
+	/* Views into the mapped file, valid until Close() */
+	const uint64_t *InputRow(int row) const { return (const uint64_t *)payload + (size_t)row*wordsPerRow; }
+	const int32_t *WeightRow(int row) const { return (const int32_t *)payload + (size_t)row*header.cols; }
+	bool InputBit(int row, int col) const { return (InputRow(row)[col >> 6] >> (col & 63)) & 1; }
+
+	static bool ReadHeader(const string &filename, TraceHeader *header);		// false if the file is not a binary trace, v1 headers are upgraded
+	static int TraceKind(const string &filename);		// -1 if the file is not a binary trace
+	static uint32_t Checksum(const void *data, size_t size, uint32_t crc = 0);		// CRC-32, chained like zlib.crc32
+
+	TraceHeader header;
+	int rows, cols, bits, kind;
+	int wordsPerRow;
+
+private:
+	void *mapped;
+	size_t mappedSize;
+	const char *payload;
+};
+
+#endif /* TRACEFILE_H_ */
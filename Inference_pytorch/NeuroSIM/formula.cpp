@@ -40,14 +40,16 @@
 
 #include <cmath>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
+#include <unordered_map>
 #include "constant.h"
 #include "formula.h"
 
 using namespace std;
 
 /* Beyond 22 nm technology, the value capIdealGate is the sum of capIdealGate and capOverlap and capFringe */
-double CalculateGateCap(double width, Technology tech) {
+double CalculateGateCap(double width, const Technology& tech) {
 	double widthEff = 0;
 	if (tech.featureSize >= 22 * 1e-9 || tech.transistorType != conventional) {
 		widthEff = width;
@@ -59,10 +61,10 @@ double CalculateGateCap(double width, Technology tech) {
            + tech.phyGateLength * tech.capPolywire;
 }
 
-double CalculateGateArea(	// Calculate layout area and width of logic gate given fixed layout height
+static double GateArea(	// Calculate layout area and width of logic gate given fixed layout height
     int gateType, int numInput,
     double widthNMOS, double widthPMOS,
-    double heightTransistorRegion, Technology tech,
+    double heightTransistorRegion, const Technology& tech,
     double *height, double *width) {
 
 	if (tech.featureSize <= 14 * 1e-9) {  // finfet
@@ -213,11 +215,11 @@ double CalculateGateArea(	// Calculate layout area and width of logic gate given
 
     return (*width)*(*height);
 }
- 
-void CalculateGateCapacitance(
+
+static void GateCapacitance(
     int gateType, int numInput,
     double widthNMOS, double widthPMOS,
-    double heightTransistorRegion, Technology tech,
+    double heightTransistorRegion, const Technology& tech,
     double *capInput, double *capOutput) {
 	if (capInput){
 		*(capInput) = CalculateGateCap(widthNMOS, tech) + CalculateGateCap(widthPMOS, tech);
@@ -414,9 +416,93 @@ void CalculateGateCapacitance(
 }
 
 
+/* Memo of the gate area/capacitance: every module's Initialize re-evaluates the same few gate shapes */
+// A Technology is fully set by (node, roadmap, transistor type), so those stand for it in the key.
+// One table per thread, flushed when it grows past gateMemoSize (widths that scale with the array size).
+namespace {
+struct GateKey {
+	int gateType, numInput;
+	double widthNMOS, widthPMOS, heightTransistorRegion;
+	int featureSizeInNano;
+	DeviceRoadmap deviceRoadmap;
+	TransistorType transistorType;
+	bool operator==(const GateKey &other) const {
+		return gateType == other.gateType && numInput == other.numInput && widthNMOS == other.widthNMOS && widthPMOS == other.widthPMOS
+			&& heightTransistorRegion == other.heightTransistorRegion && featureSizeInNano == other.featureSizeInNano
+			&& deviceRoadmap == other.deviceRoadmap && transistorType == other.transistorType;
+	}
+};
+
+struct GateKeyHash {
+	size_t operator()(const GateKey &key) const {
+		hash<double> h;
+		size_t seed = (size_t)key.gateType*131 + key.numInput + ((size_t)key.featureSizeInNano << 8) + ((size_t)key.deviceRoadmap << 20) + ((size_t)key.transistorType << 22);
+		seed ^= h(key.widthNMOS) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+		seed ^= h(key.widthPMOS) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+		seed ^= h(key.heightTransistorRegion) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2);
+		return seed;
+	}
+};
+
+struct GateAreaValue {
+	double area, height, width;
+};
+
+struct GateCapValue {
+	double capInput, capOutput;
+};
+
+const size_t gateMemoSize = 4096;
+thread_local unordered_map<GateKey, GateAreaValue, GateKeyHash> gateAreaMemo;
+thread_local unordered_map<GateKey, GateCapValue, GateKeyHash> gateCapMemo;
+}
+
+double CalculateGateArea(
+    int gateType, int numInput,
+    double widthNMOS, double widthPMOS,
+    double heightTransistorRegion, const Technology& tech,
+    double *height, double *width) {
+	GateKey key = {gateType, numInput, widthNMOS, widthPMOS, heightTransistorRegion, tech.featureSizeInNano, tech.deviceRoadmap, tech.transistorType};
+	auto it = gateAreaMemo.find(key);
+	if (it == gateAreaMemo.end()) {
+		if (gateAreaMemo.size() >= gateMemoSize) {
+			gateAreaMemo.clear();
+		}
+		GateAreaValue value;
+		value.area = GateArea(gateType, numInput, widthNMOS, widthPMOS, heightTransistorRegion, tech, &value.height, &value.width);
+		it = gateAreaMemo.emplace(key, value).first;
+	}
+	*height = it->second.height;
+	*width = it->second.width;
+	return it->second.area;
+}
+
+void CalculateGateCapacitance(
+    int gateType, int numInput,
+    double widthNMOS, double widthPMOS,
+    double heightTransistorRegion, const Technology& tech,
+    double *capInput, double *capOutput) {
+	GateKey key = {gateType, numInput, widthNMOS, widthPMOS, heightTransistorRegion, tech.featureSizeInNano, tech.deviceRoadmap, tech.transistorType};
+	auto it = gateCapMemo.find(key);
+	if (it == gateCapMemo.end()) {
+		if (gateCapMemo.size() >= gateMemoSize) {
+			gateCapMemo.clear();
+		}
+		GateCapValue value;
+		GateCapacitance(gateType, numInput, widthNMOS, widthPMOS, heightTransistorRegion, tech, &value.capInput, &value.capOutput);
+		it = gateCapMemo.emplace(key, value).first;
+	}
+	if (capInput) {
+		*capInput = it->second.capInput;
+	}
+	if (capOutput) {
+		*capOutput = it->second.capOutput;
+	}
+}
+
 double CalculateDrainCap(
     double width, int type,
-    double heightTransistorRegion, Technology tech) {
+    double heightTransistorRegion, const Technology& tech) {
     double drainCap = 0;
     if (type == NMOS)
         CalculateGateCapacitance(INV, 1, width, 0, heightTransistorRegion, tech, NULL, &drainCap);
@@ -428,14 +514,9 @@ double CalculateDrainCap(
 double CalculateGateLeakage(
     int gateType, int numInput,
     double widthNMOS, double widthPMOS,
-    double temperature, Technology tech) {
-    int tempIndex = (int)temperature - 300;
-    if ((tempIndex > 100) || (tempIndex < 0)) {
-        cout<<"Error: Temperature is out of range"<<endl;
-        exit(-1);
-    }
-    double *leakN = tech.currentOffNmos;
-    double *leakP = tech.currentOffPmos;
+    double temperature, const Technology& tech) {
+    double leakN = tech.CurrentOffNmos(temperature);	// clamped to the 300K~400K of the device table
+    double leakP = tech.CurrentOffPmos(temperature);
     double leakageN, leakageP;
 	
 	double widthNMOSEff, widthPMOSEff;
@@ -451,11 +532,11 @@ double CalculateGateLeakage(
 	
     switch (gateType) {
     case INV:
-        leakageN = widthNMOSEff * leakN[tempIndex];
-        leakageP = widthPMOSEff * leakP[tempIndex];
+        leakageN = widthNMOSEff * leakN;
+        leakageP = widthPMOSEff * leakP;
         return (leakageN + leakageP)/2;
     case NOR:
-        leakageN = widthNMOSEff * leakN[tempIndex] * numInput;
+        leakageN = widthNMOSEff * leakN * numInput;
         if (numInput == 2) {
             return AVG_RATIO_LEAK_2INPUT_NOR * leakageN;
         }
@@ -463,7 +544,7 @@ double CalculateGateLeakage(
             return AVG_RATIO_LEAK_3INPUT_NOR * leakageN;
         }
     case NAND:
-        leakageP = widthPMOSEff * leakP[tempIndex] * numInput;
+        leakageP = widthPMOSEff * leakP * numInput;
         if (numInput == 2) {
             return AVG_RATIO_LEAK_2INPUT_NAND * leakageP;
         }
@@ -475,13 +556,8 @@ double CalculateGateLeakage(
     }
 }
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech) {
+double CalculateOnResistance(double width, int type, double temperature, const Technology& tech) {
     double r;
-    int tempIndex = (int)temperature - 300;
-    if ((tempIndex > 100) || (tempIndex < 0)) {
-        cout<<"Error: Temperature is out of range"<<endl;
-        exit(-1);
-    }
 	double widthEff = 0;
 	if (tech.featureSize >= 22 * 1e-9 || tech.transistorType != conventional) {
 		widthEff = width;
@@ -490,14 +566,14 @@ double CalculateOnResistance(double width, int type, double temperature, Technol
 		widthEff = ceil(width/tech.PitchFin)*(2*tech.heightFin + tech.widthFin);
 	}
     if (type == NMOS)
-        r = tech.effectiveResistanceMultiplier * tech.vdd / (tech.currentOnNmos[tempIndex] * widthEff);
+        r = tech.effectiveResistanceMultiplier * tech.vdd / (tech.CurrentOnNmos(temperature) * widthEff);
     else
-        r = tech.effectiveResistanceMultiplier * tech.vdd / (tech.currentOnPmos[tempIndex] * widthEff);
+        r = tech.effectiveResistanceMultiplier * tech.vdd / (tech.CurrentOnPmos(temperature) * widthEff);
 	
     return r;
 }
 
-double CalculateTransconductance(double width, int type, Technology tech) {
+double CalculateTransconductance(double width, int type, const Technology& tech) {
     double gm;
 	double widthEff = 0;
 	if (tech.featureSize >= 22 * 1e-9 || tech.transistorType != conventional) {
@@ -527,7 +603,7 @@ double horowitz(double tr, double beta, double rampInput, double *rampOutput) {
 
 double CalculatePassGateArea(	// Calculate layout area, height and width of pass gate given the number of folding on the pass gate width
     // This function is for pass gate where the cell height can change. For normal standard cells, use CalculateGateArea() where the cell height is fixed
-    double widthNMOS, double widthPMOS, Technology tech, int numFold, double *height, double *width) {
+    double widthNMOS, double widthPMOS, const Technology& tech, int numFold, double *height, double *width) {
 
     if (tech.featureSize >= 22 * 1e-9 || tech.transistorType != conventional) {	// Bulk
 		*width = (numFold + 1) * (POLY_WIDTH + MIN_GAP_BET_GATE_POLY) * tech.featureSize;	// No folding means numFold=1
@@ -555,7 +631,7 @@ double NonlinearResistance(double R, double NL, double Vw, double Vr, double V)
 }
 
 /* enlarge min size transister to max with same layout area */
-void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, Technology tech) {	
+void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, const Technology& tech) {	
     double	ratio = *widthPMOS / (*widthPMOS + *widthNMOS);
     double maxWidthPMOS, maxWidthNMOS;
     int maxNumPFin, maxNumNFin;	/* Max number of fins for the specified cell height */
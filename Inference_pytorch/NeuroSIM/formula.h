@@ -45,39 +45,40 @@
 #define MIN(a,b) (((a)< (b))?(a):(b))
 
 /* Calculate MOSFET gate capacitance */
-double CalculateGateCap(double width, Technology tech);
+double CalculateGateCap(double width, const Technology& tech);
 
+/* Calculate the layout area of a logic gate (this and CalculateGateCapacitance are memoized per thread) */
 double CalculateGateArea(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology& tech,
 		double *height, double *width);
 
 /* Calculate the capacitance of a logic gate */
 void CalculateGateCapacitance(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double heightTransistorRegion, Technology tech,
+		double heightTransistorRegion, const Technology& tech,
 		double *capInput, double *capOutput);
 
 double CalculateDrainCap(
 		double width, int type,
-		double heightTransistorRegion, Technology tech);
+		double heightTransistorRegion, const Technology& tech);
 
 double CalculateGateLeakage(
 		int gateType, int numInput,
 		double widthNMOS, double widthPMOS,
-		double temperature, Technology tech);
+		double temperature, const Technology& tech);
 
-double CalculateOnResistance(double width, int type, double temperature, Technology tech);
+double CalculateOnResistance(double width, int type, double temperature, const Technology& tech);
 
-double CalculateTransconductance(double width, int type, Technology tech);
+double CalculateTransconductance(double width, int type, const Technology& tech);
 
 double horowitz(double tr, double beta, double rampInput, double *rampOutput);
 
-double CalculatePassGateArea(double widthNMOS, double widthPMOS, Technology tech, int numFold, double *height, double *width);
+double CalculatePassGateArea(double widthNMOS, double widthPMOS, const Technology& tech, int numFold, double *height, double *width);
 
 double NonlinearResistance(double R, double NL, double Vw, double Vr, double V);
 
-void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, Technology tech);
+void EnlargeSize(double *widthNMOS, double *widthPMOS, double heightTransistorRegion, const Technology& tech);
 #endif /* FORMULA_H_ */
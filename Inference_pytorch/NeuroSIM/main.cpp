@@ -54,18 +54,26 @@
 #include "Chip.h"
 #include "ProcessingUnit.h"
 #include "SubArray.h"
+#include "CsvFile.h"
+#include "SubArrayCache.h"
+#include "SimContext.h"
 #include "Definition.h"
 
 using namespace std;
 
 vector<vector<double> > getNetStructure(const string &inputfile);
 
+/*** Performance of one layer, latencies in seconds ***/
+struct LayerResult {
+	double readLatency, readDynamicEnergy, leakage, bufferLatency, bufferDynamicEnergy, icLatency, icDynamicEnergy;
+	double latencyADC, latencyAccum, latencyOther, energyADC, energyAccum, energyOther;
+	double clkPeriod;
+};
+
 int main(int argc, char * argv[]) {   
 
 	auto start = chrono::high_resolution_clock::now();
 	
-	gen.seed(0);
-	
 	vector<vector<double> > netStructure;
 	netStructure = getNetStructure(argv[1]);
 	
@@ -111,8 +119,8 @@ int main(int argc, char * argv[]) {
 	double maxPESizeNM, maxTileSizeCM, numPENM;
 	vector<int> markNM;
 	vector<int> pipelineSpeedUp;
-	markNM = ChipDesignInitialize(inputParameter, tech, cell, false, netStructure, &maxPESizeNM, &maxTileSizeCM, &numPENM);
-	pipelineSpeedUp = ChipDesignInitialize(inputParameter, tech, cell, true, netStructure, &maxPESizeNM, &maxTileSizeCM, &numPENM);
+	markNM = ChipDesignInitialize(false, netStructure, &maxPESizeNM, &maxTileSizeCM, &numPENM);
+	pipelineSpeedUp = ChipDesignInitialize(true, netStructure, &maxPESizeNM, &maxTileSizeCM, &numPENM);
 	
 	double desiredNumTileNM, desiredPESizeNM, desiredNumTileCM, desiredTileSizeCM, desiredPESizeCM;
 	int numTileRow, numTileCol;
@@ -184,7 +192,8 @@ int main(int argc, char * argv[]) {
 		numComputation += 2*(netStructure[i][0] * netStructure[i][1] * netStructure[i][2] * netStructure[i][3] * netStructure[i][4] * netStructure[i][5]);
 	}
 
-	ChipInitialize(inputParameter, tech, cell, netStructure, markNM, numTileEachLayer,
+	SimContext ctx(inputParameter, tech, cell);
+	ChipInitialize(ctx, netStructure, markNM, numTileEachLayer,
 					numPENM, desiredNumTileNM, desiredPESizeNM, desiredNumTileCM, desiredTileSizeCM, desiredPESizeCM, numTileRow, numTileCol);
 			
 	double chipHeight, chipWidth, chipArea, chipAreaIC, chipAreaADC, chipAreaAccum, chipAreaOther, chipAreaArray;
@@ -194,7 +203,7 @@ int main(int argc, char * argv[]) {
 	double NMTilewidth = 0;
 	vector<double> chipAreaResults;
 		 			
-	chipAreaResults = ChipCalculateArea(inputParameter, tech, cell, desiredNumTileNM, numPENM, desiredPESizeNM, desiredNumTileCM, desiredTileSizeCM, desiredPESizeCM, numTileRow, 
+	chipAreaResults = ChipCalculateArea(ctx, desiredNumTileNM, numPENM, desiredPESizeNM, desiredNumTileCM, desiredTileSizeCM, desiredPESizeCM, numTileRow, 
 					&chipHeight, &chipWidth, &CMTileheight, &CMTilewidth, &NMTileheight, &NMTilewidth);		
 	chipArea = chipAreaResults[0];
 	chipAreaIC = chipAreaResults[1];
@@ -204,7 +213,6 @@ int main(int argc, char * argv[]) {
 	chipAreaArray = chipAreaResults[5];
 
 	double clkPeriod = 0;
-	double layerclkPeriod = 0;
 	
 	double chipReadLatency = 0;
 	double chipReadDynamicEnergy = 0;
@@ -222,38 +230,43 @@ int main(int argc, char * argv[]) {
 	double chipEnergyAccum = 0;
 	double chipEnergyOther = 0;
 	
-	double layerReadLatency = 0;
-	double layerReadDynamicEnergy = 0;
-	double tileLeakage = 0;
-	double layerbufferLatency = 0;
-	double layerbufferDynamicEnergy = 0;
-	double layericLatency = 0;
-	double layericDynamicEnergy = 0;
-	
-	double coreLatencyADC = 0;
-	double coreLatencyAccum = 0;
-	double coreLatencyOther = 0;
-	double coreEnergyADC = 0;
-	double coreEnergyAccum = 0;
-	double coreEnergyOther = 0;
+	// performance of each layer, in synchronous mode the latencies are in cycles and the layer also gives its longest sensing
+	// latency, so one pass over the layers is enough to set the clock period and then scale the latencies
+	vector<LayerResult> layerResult(netStructure.size());
+	// every layer is evaluated on its own copy of the initialized modules, so a layer never sees the state left by another
+	// and the layer-parallel mode gives the same results as the serial one
+	#pragma omp parallel for schedule(dynamic, 1) if (param->layerParallel)
+	for (int i=0; i<netStructure.size(); i++) {
+		SimContext layerCtx(ctx);
+		LayerResult &layer = layerResult[i];
+		ChipCalculatePerformance(layerCtx, i, argv[2*i+4], argv[2*i+4], argv[2*i+5], netStructure[i][6],
+					netStructure, markNM, numTileEachLayer, utilizationEachLayer, speedUpEachLayer, tileLocaEachLayer,
+					numPENM, desiredPESizeNM, desiredTileSizeCM, desiredPESizeCM, CMTileheight, CMTilewidth, NMTileheight, NMTilewidth,
+					&layer.readLatency, &layer.readDynamicEnergy, &layer.leakage, &layer.bufferLatency, &layer.bufferDynamicEnergy, &layer.icLatency, &layer.icDynamicEnergy,
+					&layer.latencyADC, &layer.latencyAccum, &layer.latencyOther, &layer.energyADC, &layer.energyAccum, &layer.energyOther, &layer.clkPeriod);
+	}
 	
 	if (param->synchronous){
 		// calculate clkFreq
-		for (int i=0; i<netStructure.size(); i++) {		
-			ChipCalculatePerformance(inputParameter, tech, cell, i, argv[2*i+4], argv[2*i+4], argv[2*i+5], netStructure[i][6],
-						netStructure, markNM, numTileEachLayer, utilizationEachLayer, speedUpEachLayer, tileLocaEachLayer,
-						numPENM, desiredPESizeNM, desiredTileSizeCM, desiredPESizeCM, CMTileheight, CMTilewidth, NMTileheight, NMTilewidth,
-						&layerReadLatency, &layerReadDynamicEnergy, &tileLeakage, &layerbufferLatency, &layerbufferDynamicEnergy, &layericLatency, &layericDynamicEnergy,
-						&coreLatencyADC, &coreLatencyAccum, &coreLatencyOther, &coreEnergyADC, &coreEnergyAccum, &coreEnergyOther, true, &layerclkPeriod);
-			if(clkPeriod < layerclkPeriod){
-				clkPeriod = layerclkPeriod;
-			}			
-		}		
+		for (int i=0; i<netStructure.size(); i++) {
+			if(clkPeriod < layerResult[i].clkPeriod){
+				clkPeriod = layerResult[i].clkPeriod;
+			}
+		}
 		if(param->clkFreq > 1/clkPeriod){
 			param->clkFreq = 1/clkPeriod;
 		}
+		for (int i=0; i<netStructure.size(); i++) {
+			LayerResult &layer = layerResult[i];
+			layer.readLatency *= clkPeriod;
+			layer.bufferLatency *= clkPeriod;
+			layer.icLatency *= clkPeriod;
+			layer.latencyADC *= clkPeriod;
+			layer.latencyAccum *= clkPeriod;
+			layer.latencyOther *= clkPeriod;
+		}
 	}
-
+	
 	cout << "-------------------------------------- Hardware Performance --------------------------------------" <<  endl;	
 	if (! param->pipeline) {
 		// layer-by-layer process
@@ -261,19 +274,7 @@ int main(int argc, char * argv[]) {
 		for (int i=0; i<netStructure.size(); i++) {
 			cout << "-------------------- Estimation of Layer " << i+1 << " ----------------------" << endl;
 
-			ChipCalculatePerformance(inputParameter, tech, cell, i, argv[2*i+4], argv[2*i+4], argv[2*i+5], netStructure[i][6],
-						netStructure, markNM, numTileEachLayer, utilizationEachLayer, speedUpEachLayer, tileLocaEachLayer,
-						numPENM, desiredPESizeNM, desiredTileSizeCM, desiredPESizeCM, CMTileheight, CMTilewidth, NMTileheight, NMTilewidth,
-						&layerReadLatency, &layerReadDynamicEnergy, &tileLeakage, &layerbufferLatency, &layerbufferDynamicEnergy, &layericLatency, &layericDynamicEnergy,
-						&coreLatencyADC, &coreLatencyAccum, &coreLatencyOther, &coreEnergyADC, &coreEnergyAccum, &coreEnergyOther, false, &layerclkPeriod);
-			if (param->synchronous) {
-				layerReadLatency *= clkPeriod;
-				layerbufferLatency *= clkPeriod;
-				layericLatency *= clkPeriod;
-				coreLatencyADC *= clkPeriod;
-				coreLatencyAccum *= clkPeriod;
-				coreLatencyOther *= clkPeriod;
-			}
+			const LayerResult &layer = layerResult[i];
 			
 			double numTileOtherLayer = 0;
 			double layerLeakageEnergy = 0;		
@@ -282,46 +283,46 @@ int main(int argc, char * argv[]) {
 					numTileOtherLayer += numTileEachLayer[0][j] * numTileEachLayer[1][j];
 				}
 			}
-			layerLeakageEnergy = numTileOtherLayer*layerReadLatency*tileLeakage;
+			layerLeakageEnergy = numTileOtherLayer*layer.readLatency*layer.leakage;
 			
-			cout << "layer" << i+1 << "'s readLatency is: " << layerReadLatency*1e9 << "ns" << endl;
-			cout << "layer" << i+1 << "'s readDynamicEnergy is: " << layerReadDynamicEnergy*1e12 << "pJ" << endl;
-			cout << "layer" << i+1 << "'s leakagePower is: " << numTileEachLayer[0][i] * numTileEachLayer[1][i] * tileLeakage*1e6 << "uW" << endl;
+			cout << "layer" << i+1 << "'s readLatency is: " << layer.readLatency*1e9 << "ns" << endl;
+			cout << "layer" << i+1 << "'s readDynamicEnergy is: " << layer.readDynamicEnergy*1e12 << "pJ" << endl;
+			cout << "layer" << i+1 << "'s leakagePower is: " << numTileEachLayer[0][i] * numTileEachLayer[1][i] * layer.leakage*1e6 << "uW" << endl;
 			cout << "layer" << i+1 << "'s leakageEnergy is: " << layerLeakageEnergy*1e12 << "pJ" << endl;
-			cout << "layer" << i+1 << "'s buffer latency is: " << layerbufferLatency*1e9 << "ns" << endl;
-			cout << "layer" << i+1 << "'s buffer readDynamicEnergy is: " << layerbufferDynamicEnergy*1e12 << "pJ" << endl;
-			cout << "layer" << i+1 << "'s ic latency is: " << layericLatency*1e9 << "ns" << endl;
-			cout << "layer" << i+1 << "'s ic readDynamicEnergy is: " << layericDynamicEnergy*1e12 << "pJ" << endl;
+			cout << "layer" << i+1 << "'s buffer latency is: " << layer.bufferLatency*1e9 << "ns" << endl;
+			cout << "layer" << i+1 << "'s buffer readDynamicEnergy is: " << layer.bufferDynamicEnergy*1e12 << "pJ" << endl;
+			cout << "layer" << i+1 << "'s ic latency is: " << layer.icLatency*1e9 << "ns" << endl;
+			cout << "layer" << i+1 << "'s ic readDynamicEnergy is: " << layer.icDynamicEnergy*1e12 << "pJ" << endl;
 			
 			
 			cout << endl;
 			cout << "************************ Breakdown of Latency and Dynamic Energy *************************" << endl;
 			cout << endl;
-			cout << "----------- ADC (or S/As and precharger for SRAM) readLatency is : " << coreLatencyADC*1e9 << "ns" << endl;
-			cout << "----------- Accumulation Circuits (subarray level: adders, shiftAdds; PE/Tile/Global level: accumulation units) readLatency is : " << coreLatencyAccum*1e9 << "ns" << endl;
-			cout << "----------- Other Peripheries (e.g. decoders, mux, switchmatrix, buffers, IC, pooling and activation units) readLatency is : " << coreLatencyOther*1e9 << "ns" << endl;
-			cout << "----------- ADC (or S/As and precharger for SRAM) readDynamicEnergy is : " << coreEnergyADC*1e12 << "pJ" << endl;
-			cout << "----------- Accumulation Circuits (subarray level: adders, shiftAdds; PE/Tile/Global level: accumulation units) readDynamicEnergy is : " << coreEnergyAccum*1e12 << "pJ" << endl;
-			cout << "----------- Other Peripheries (e.g. decoders, mux, switchmatrix, buffers, IC, pooling and activation units) readDynamicEnergy is : " << coreEnergyOther*1e12 << "pJ" << endl;
+			cout << "----------- ADC (or S/As and precharger for SRAM) readLatency is : " << layer.latencyADC*1e9 << "ns" << endl;
+			cout << "----------- Accumulation Circuits (subarray level: adders, shiftAdds; PE/Tile/Global level: accumulation units) readLatency is : " << layer.latencyAccum*1e9 << "ns" << endl;
+			cout << "----------- Other Peripheries (e.g. decoders, mux, switchmatrix, buffers, IC, pooling and activation units) readLatency is : " << layer.latencyOther*1e9 << "ns" << endl;
+			cout << "----------- ADC (or S/As and precharger for SRAM) readDynamicEnergy is : " << layer.energyADC*1e12 << "pJ" << endl;
+			cout << "----------- Accumulation Circuits (subarray level: adders, shiftAdds; PE/Tile/Global level: accumulation units) readDynamicEnergy is : " << layer.energyAccum*1e12 << "pJ" << endl;
+			cout << "----------- Other Peripheries (e.g. decoders, mux, switchmatrix, buffers, IC, pooling and activation units) readDynamicEnergy is : " << layer.energyOther*1e12 << "pJ" << endl;
 			cout << endl;
 			cout << "************************ Breakdown of Latency and Dynamic Energy *************************" << endl;
 			cout << endl;
 			
-			chipReadLatency += layerReadLatency;
-			chipReadDynamicEnergy += layerReadDynamicEnergy;
+			chipReadLatency += layer.readLatency;
+			chipReadDynamicEnergy += layer.readDynamicEnergy;
 			chipLeakageEnergy += layerLeakageEnergy;
-			chipLeakage += tileLeakage*numTileEachLayer[0][i] * numTileEachLayer[1][i];
-			chipbufferLatency += layerbufferLatency;
-			chipbufferReadDynamicEnergy += layerbufferDynamicEnergy;
-			chipicLatency += layericLatency;
-			chipicReadDynamicEnergy += layericDynamicEnergy;
+			chipLeakage += layer.leakage*numTileEachLayer[0][i] * numTileEachLayer[1][i];
+			chipbufferLatency += layer.bufferLatency;
+			chipbufferReadDynamicEnergy += layer.bufferDynamicEnergy;
+			chipicLatency += layer.icLatency;
+			chipicReadDynamicEnergy += layer.icDynamicEnergy;
 			
-			chipLatencyADC += coreLatencyADC;
-			chipLatencyAccum += coreLatencyAccum;
-			chipLatencyOther += coreLatencyOther;
-			chipEnergyADC += coreEnergyADC;
-			chipEnergyAccum += coreEnergyAccum;
-			chipEnergyOther += coreEnergyOther;
+			chipLatencyADC += layer.latencyADC;
+			chipLatencyAccum += layer.latencyAccum;
+			chipLatencyOther += layer.latencyOther;
+			chipEnergyADC += layer.energyADC;
+			chipEnergyAccum += layer.energyAccum;
+			chipEnergyOther += layer.energyOther;
 		}
 	} else {
 		// pipeline system
@@ -344,36 +345,24 @@ int main(int argc, char * argv[]) {
 		vector<double> coreEnergyOtherPerLayer;
 		
 		for (int i=0; i<netStructure.size(); i++) {
-			ChipCalculatePerformance(inputParameter, tech, cell, i, argv[2*i+4], argv[2*i+4], argv[2*i+5], netStructure[i][6],
-						netStructure, markNM, numTileEachLayer, utilizationEachLayer, speedUpEachLayer, tileLocaEachLayer,
-						numPENM, desiredPESizeNM, desiredTileSizeCM, desiredPESizeCM, CMTileheight, CMTilewidth, NMTileheight, NMTilewidth,
-						&layerReadLatency, &layerReadDynamicEnergy, &tileLeakage, &layerbufferLatency, &layerbufferDynamicEnergy, &layericLatency, &layericDynamicEnergy,
-						&coreLatencyADC, &coreLatencyAccum, &coreLatencyOther, &coreEnergyADC, &coreEnergyAccum, &coreEnergyOther, false, &layerclkPeriod);
-			if (param->synchronous) {
-				layerReadLatency *= clkPeriod;
-				layerbufferLatency *= clkPeriod;
-				layericLatency *= clkPeriod;
-				coreLatencyADC *= clkPeriod;
-				coreLatencyAccum *= clkPeriod;
-				coreLatencyOther *= clkPeriod;
-			}			
+			const LayerResult &layer = layerResult[i];
 			
-			systemClock = MAX(systemClock, layerReadLatency);
+			systemClock = MAX(systemClock, layer.readLatency);
 			
-			readLatencyPerLayer.push_back(layerReadLatency);
-			readDynamicEnergyPerLayer.push_back(layerReadDynamicEnergy);
-			leakagePowerPerLayer.push_back(numTileEachLayer[0][i] * numTileEachLayer[1][i] * tileLeakage);
-			bufferLatencyPerLayer.push_back(layerbufferLatency);
-			bufferEnergyPerLayer.push_back(layerbufferDynamicEnergy);
-			icLatencyPerLayer.push_back(layericLatency);
-			icEnergyPerLayer.push_back(layericDynamicEnergy);
+			readLatencyPerLayer.push_back(layer.readLatency);
+			readDynamicEnergyPerLayer.push_back(layer.readDynamicEnergy);
+			leakagePowerPerLayer.push_back(numTileEachLayer[0][i] * numTileEachLayer[1][i] * layer.leakage);
+			bufferLatencyPerLayer.push_back(layer.bufferLatency);
+			bufferEnergyPerLayer.push_back(layer.bufferDynamicEnergy);
+			icLatencyPerLayer.push_back(layer.icLatency);
+			icEnergyPerLayer.push_back(layer.icDynamicEnergy);
 			
-			coreLatencyADCPerLayer.push_back(coreLatencyADC);
-			coreEnergyADCPerLayer.push_back(coreEnergyADC);
-			coreLatencyAccumPerLayer.push_back(coreLatencyAccum);
-			coreEnergyAccumPerLayer.push_back(coreEnergyAccum);
-			coreLatencyOtherPerLayer.push_back(coreLatencyOther);
-			coreEnergyOtherPerLayer.push_back(coreEnergyOther);
+			coreLatencyADCPerLayer.push_back(layer.latencyADC);
+			coreEnergyADCPerLayer.push_back(layer.energyADC);
+			coreLatencyAccumPerLayer.push_back(layer.latencyAccum);
+			coreEnergyAccumPerLayer.push_back(layer.energyAccum);
+			coreLatencyOtherPerLayer.push_back(layer.latencyOther);
+			coreEnergyOtherPerLayer.push_back(layer.energyOther);
 		}
 		
 		for (int i=0; i<netStructure.size(); i++) {
@@ -492,54 +481,20 @@ int main(int argc, char * argv[]) {
 	auto duration = chrono::duration_cast<chrono::seconds>(stop-start);
     cout << "------------------------------ Simulation Performance --------------------------------" <<  endl;
 	cout << "Total Run-time of NeuroSim: " << duration.count() << " seconds" << endl;
+	cout << "SubArray result cache: " << SubArrayCache::hits << " hits of " << SubArrayCache::lookups << " input vectors (" << SubArrayCache::hits/MAX(SubArrayCache::lookups, 1)*100 << "%)" << endl;
+	cout << "CSV trace parsing: " << CsvFile::bytesParsed/1e6 << "MB in " << CsvFile::secondsParsed << "s (" << CsvFile::bytesParsed/1e6/MAX(CsvFile::secondsParsed, 1e-9) << "MB/s)" << endl;
 	cout << "------------------------------ Simulation Performance --------------------------------" <<  endl;
 	
 	return 0;
 }
 
 vector<vector<double> > getNetStructure(const string &inputfile) {
-	ifstream infile(inputfile.c_str());      
-	string inputline;
-	string inputval;
+	CsvFile csv(inputfile);
 	
-	int ROWin=0, COLin=0;      
-	if (!infile.good()) {        
-		cerr << "Error: the input file cannot be opened!" << endl;
-		exit(1);
-	}else{
-		while (getline(infile, inputline, '\n')) {       
-			ROWin++;                                
-		}
-		infile.clear();
-		infile.seekg(0, ios::beg);      
-		if (getline(infile, inputline, '\n')) {        
-			istringstream iss (inputline);      
-			while (getline(iss, inputval, ',')) {       
-				COLin++;
-			}
-		}	
-	}
-	infile.clear();
-	infile.seekg(0, ios::beg);          
-
 	vector<vector<double> > netStructure;               
-	for (int row=0; row<ROWin; row++) {	
-		vector<double> netStructurerow;
-		getline(infile, inputline, '\n');             
-		istringstream iss;
-		iss.str(inputline);
-		for (int col=0; col<COLin; col++) {       
-			while(getline(iss, inputval, ',')){	
-				istringstream fs;
-				fs.str(inputval);
-				double f=0;
-				fs >> f;				
-				netStructurerow.push_back(f);			
-			}			
-		}		
-		netStructure.push_back(netStructurerow);
+	for (int row=0; row<csv.rows; row++) {	
+		netStructure.push_back(vector<double>(csv.Row(row), csv.Row(row)+csv.cols));
 	}
-	infile.close();
 	
 	return netStructure;
 	netStructure.clear();
@@ -92,6 +92,14 @@ enum SpikingMode
 	SPIKING
 };
 
+enum ReadMode
+{
+	SEQUENTIAL_READ,		/* conventionalSequential */
+	PARALLEL_READ,			/* conventionalParallel */
+	BNN_SEQUENTIAL_READ,	/* BNNsequentialMode or XNORsequentialMode */
+	BNN_PARALLEL_READ		/* BNNparallelMode or XNORparallelMode */
+};
+
 enum BusMode
 {
 	HORIZONTAL,	/* horizontal bus */
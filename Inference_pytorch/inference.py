@@ -45,6 +45,7 @@ parser.add_argument('--t', default=0, help='retention time')
 parser.add_argument('--v', default=0, help='drift coefficient')
 parser.add_argument('--detect', default=0, help='if 1, fixed-direction drift, if 0, random drift')
 parser.add_argument('--target', default=0, help='drift target for fixed-direction drift')
+parser.add_argument('--trace_format', default='csv', help='csv|bin (bit-packed binary layer traces)|ifm (bin, with unexpanded conv feature maps)')
 current_time = datetime.now().strftime('%Y_%m_%d_%H_%M_%S')
 
 args = parser.parse_args()
@@ -114,7 +115,7 @@ criterion = torch.nn.CrossEntropyLoss()
 # for data, target in test_loader:
 for i, (data, target) in enumerate(test_loader):
     if i==0:
-        hook_handle_list = hook.hardware_evaluation(modelCF,args.wl_weight,args.wl_activate,args.model,args.mode)
+        hook_handle_list = hook.hardware_evaluation(modelCF,args.wl_weight,args.wl_activate,args.model,args.mode,args.trace_format)
     indx_target = target.clone()
     if args.cuda:
         data, target = data.cuda(), target.cuda()
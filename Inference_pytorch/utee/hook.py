@@ -1,5 +1,7 @@
 #from modules.quantize import quantize, quantize_grad, QConv2d, QLinear, RangeBN
 import os
+import struct
+import zlib
 import torch.nn as nn
 import shutil
 from modules.quantization_cpu_np_infer import QConv2d,QLinear
@@ -9,18 +11,39 @@ import torch
 from utee import wage_quantizer
 from utee import float_quantizer
 
+# binary trace header, see NeuroSIM/TraceFile.h
+TRACE_MAGIC = 0x5254534e
+TRACE_VERSION = 2
+TRACE_KIND_WEIGHT = 0
+TRACE_KIND_INPUT = 1
+TRACE_KIND_IFM = 2
+
 def Neural_Sim(self, input, output): 
-    global model_n, FP
+    global model_n, FP, trace_bin, trace_ifm, layer_n
 
     print("quantize layer ", self.name)
-    input_file_name =  './layer_record_' + str(model_n) + '/input' + str(self.name) + '.csv'
-    weight_file_name =  './layer_record_' + str(model_n) + '/weight' + str(self.name) + '.csv'
+    ext = '.bin' if trace_bin else '.csv'
+    input_file_name =  './layer_record_' + str(model_n) + '/input' + str(self.name) + ext
+    weight_file_name =  './layer_record_' + str(model_n) + '/weight' + str(self.name) + ext
     f = open('./layer_record_' + str(model_n) + '/trace_command.sh', "a")
     f.write(weight_file_name+' '+input_file_name+' ')
     if FP:
         weight_q = float_quantizer.float_range_quantize(self.weight,self.wl_weight)
     else:
         weight_q = wage_quantizer.Q(self.weight,self.wl_weight)
+    if trace_bin:
+        layer = layer_n
+        layer_n += 1
+        write_matrix_weight_bin( weight_q.cpu().data.numpy(),self.wl_weight,weight_file_name,layer)
+        if len(self.weight.shape) > 2:
+            k=self.weight.shape[-1]
+            if trace_ifm:
+                write_matrix_activation_ifm_bin(input[0].cpu().data.numpy(),self.wl_input,input_file_name,layer)
+            else:
+                write_matrix_activation_conv_bin(stretch_input(input[0].cpu().data.numpy(),k),self.wl_input,input_file_name,layer)
+        else:
+            write_matrix_activation_fc_bin(input[0].cpu().data.numpy(),self.wl_input, input_file_name,layer)
+        return
     write_matrix_weight( weight_q.cpu().data.numpy(),weight_file_name)
     if len(self.weight.shape) > 2:
         k=self.weight.shape[-1]
@@ -51,6 +74,58 @@ def write_matrix_activation_fc(input_matrix,fill_dimension,length,filename):
     np.savetxt(filename, filled_matrix_b, delimiter=",",fmt='%s')
 
 
+def write_trace(filename, kind, rows, cols, bits, layer, payload, height=0, width=0):
+    # header carries the shape, the layer index (order of the layers in the network csv) and the CRC-32 of the payload
+    with open(filename, 'wb') as f:
+        f.write(struct.pack('<12I', TRACE_MAGIC, TRACE_VERSION, kind, rows, cols, bits, height, width, layer, zlib.crc32(payload), 0, 0))
+        f.write(payload)
+
+
+def write_matrix_weight_bin(input_matrix,bits,filename,layer,weight_max=1,weight_min=-1):
+    # store the integer code NeuroSIM derives from each weight (weight_max/min must match algoWeightMax/Min in Param.cpp)
+    bits = int(bits)
+    cout = input_matrix.shape[0]
+    weight_matrix = input_matrix.reshape(cout,-1).transpose().astype(np.float64)
+    code = (2.0**bits)/(weight_max-weight_min)*(weight_matrix-weight_max)+2.0**bits
+    code = np.trunc(code + np.where(code >= 0, 0.5, -0.5)).astype('<i4')
+    write_trace(filename, TRACE_KIND_WEIGHT, code.shape[0], code.shape[1], bits, layer, np.ascontiguousarray(code).tobytes())
+
+
+def write_bit_matrix_bin(bit_matrix,bits,filename,layer,kind=TRACE_KIND_INPUT,height=0,width=0):
+    # pack each row 64 columns per little-endian uint64 word
+    rows, cols = bit_matrix.shape
+    words = (cols + 63) // 64
+    padded = np.zeros([rows, words*64], dtype=np.uint8)
+    padded[:, :cols] = bit_matrix
+    write_trace(filename, kind, rows, cols, int(bits), layer, np.packbits(padded, axis=1, bitorder='little').tobytes(), height, width)
+
+
+def write_matrix_activation_conv_bin(input_matrix,length,filename,layer):
+    filled_matrix_b = np.zeros([input_matrix.shape[2],input_matrix.shape[1]*length],dtype=np.uint8)
+    filled_matrix_bin,scale = dec2bin(input_matrix[0,:],length)
+    for i,b in enumerate(filled_matrix_bin):
+        filled_matrix_b[:,i::length] =  b.transpose()
+    write_bit_matrix_bin(filled_matrix_b, length, filename, layer)
+
+
+def write_matrix_activation_ifm_bin(input_matrix,length,filename,layer):
+    # unexpanded feature map, NeuroSIM builds the sliding-window vectors from the kernel/stride in netStructure
+    channels, height, width = input_matrix.shape[1:]
+    filled_matrix_b = np.zeros([channels,height*width*length],dtype=np.uint8)
+    filled_matrix_bin,scale = dec2bin(input_matrix[0,:],length)
+    for i,b in enumerate(filled_matrix_bin):
+        filled_matrix_b[:,i::length] =  b.reshape(channels,height*width)
+    write_bit_matrix_bin(filled_matrix_b, length, filename, layer, TRACE_KIND_IFM, height, width)
+
+
+def write_matrix_activation_fc_bin(input_matrix,length,filename,layer):
+    filled_matrix_b = np.zeros([input_matrix.shape[1],length],dtype=np.uint8)
+    filled_matrix_bin,scale = dec2bin(input_matrix[0,:],length)
+    for i,b in enumerate(filled_matrix_bin):
+        filled_matrix_b[:,i] =  b
+    write_bit_matrix_bin(filled_matrix_b, length, filename, layer)
+
+
 def stretch_input(input_matrix,window_size = 5):
     input_shape = input_matrix.shape
     item_num = (input_shape[2] - window_size + 1) * (input_shape[3]-window_size + 1)
@@ -105,10 +180,13 @@ def remove_hook_list(hook_handle_list):
     for handle in hook_handle_list:
         handle.remove()
 
-def hardware_evaluation(model,wl_weight,wl_activation,model_name,mode): 
-    global model_n, FP
+def hardware_evaluation(model,wl_weight,wl_activation,model_name,mode,trace_format='csv'): 
+    global model_n, FP, trace_bin, trace_ifm, layer_n
     model_n = model_name
+    layer_n = 0
     FP = 1 if mode=='FP' else 0
+    trace_bin = trace_format in ('bin', 'ifm')
+    trace_ifm = (trace_format == 'ifm')
     
     hook_handle_list = []
     if not os.path.exists('./layer_record_'+str(model_name)):